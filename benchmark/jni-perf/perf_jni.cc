@@ -34,6 +34,26 @@ extern "C" JNIEXPORT void JNICALL Java_JniPerfBenchmark_perfSOAUncheckedCall(JNI
   ScopedObjectAccessUnchecked soa(Thread::Current());
 }
 
+// Creates and deletes global references the way native code holding on to Java objects
+// across calls does: a few at a time, mostly deleted in the reverse order of creation.
+extern "C" JNIEXPORT void JNICALL Java_JniPerfBenchmark_perfGlobalRefChurn(JNIEnv* env,
+                                                                           jobject,
+                                                                           jobject obj,
+                                                                           jint n) {
+  static constexpr size_t kRefsPerIteration = 4u;
+  jobject refs[kRefsPerIteration];
+  for (jint i = 0; i < n; ++i) {
+    for (size_t j = 0; j != kRefsPerIteration; ++j) {
+      refs[j] = env->NewGlobalRef(obj);
+    }
+    // Delete one out of order to leave a free entry below the most recently added one.
+    env->DeleteGlobalRef(refs[0]);
+    for (size_t j = kRefsPerIteration; j != 1u; --j) {
+      env->DeleteGlobalRef(refs[j - 1u]);
+    }
+  }
+}
+
 }  // namespace
 
 }  // namespace art
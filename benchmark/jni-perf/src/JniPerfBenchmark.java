@@ -20,6 +20,9 @@ public class JniPerfBenchmark {
   native void perfJniEmptyCall();
   native void perfSOACall();
   native void perfSOAUncheckedCall();
+  native void perfGlobalRefChurn(Object obj, int n);
+
+  private static final int GLOBAL_REF_CHURN_THREADS = 4;
 
   public void timeFastJNI(int N) {
     // TODO: This might be an intrinsic.
@@ -46,6 +49,24 @@ public class JniPerfBenchmark {
     }
   }
 
+  public void timeGlobalRefChurn(int N) {
+    perfGlobalRefChurn(MSG, N);
+  }
+
+  // Same as above, with the N iterations split between threads that create and delete global
+  // references concurrently.
+  public void timeGlobalRefChurnMultiThreaded(int N) throws InterruptedException {
+    Thread[] threads = new Thread[GLOBAL_REF_CHURN_THREADS];
+    for (int t = 0; t < threads.length; t++) {
+      final int iterations = N / threads.length + (t < N % threads.length ? 1 : 0);
+      threads[t] = new Thread(() -> perfGlobalRefChurn(MSG, iterations));
+      threads[t].start();
+    }
+    for (Thread thread : threads) {
+      thread.join();
+    }
+  }
+
   {
     System.loadLibrary("artbenchmark");
   }
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class RegisterPressureBenchmark {
+    public static final int[] intData = makeIntData();
+    public static final long[] longData = makeLongData();
+    public static final double[] doubleData = makeDoubleData();
+
+    public static int intResult;
+    public static long longResult;
+    public static double doubleResult;
+
+    private static int[] makeIntData() {
+        int[] data = new int[1024];
+        for (int i = 0; i < data.length; ++i) {
+            data[i] = i * 0x9e3779b9;
+        }
+        return data;
+    }
+
+    private static long[] makeLongData() {
+        long[] data = new long[1024];
+        for (int i = 0; i < data.length; ++i) {
+            data[i] = i * 0x9e3779b97f4a7c15L;
+        }
+        return data;
+    }
+
+    private static double[] makeDoubleData() {
+        double[] data = new double[1024];
+        for (int i = 0; i < data.length; ++i) {
+            data[i] = i * 0.75;
+        }
+        return data;
+    }
+
+    // Sixteen integer accumulators live across the whole loop.
+    public void timeIntAccumulators16(int count) {
+        int[] data = intData;
+        int a0 = 0, a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, a6 = 6, a7 = 7;
+        int a8 = 8, a9 = 9, a10 = 10, a11 = 11, a12 = 12, a13 = 13, a14 = 14, a15 = 15;
+        for (int i = 0; i < count; ++i) {
+            int v = data[i & 1023];
+            a0 += v; a1 ^= v; a2 += a0; a3 ^= a1;
+            a4 += a2 >>> 1; a5 ^= a3 << 1; a6 += a4; a7 ^= a5;
+            a8 += a6 >>> 2; a9 ^= a7 << 2; a10 += a8; a11 ^= a9;
+            a12 += a10 >>> 3; a13 ^= a11 << 3; a14 += a12; a15 ^= a13;
+        }
+        intResult = a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7
+            + a8 + a9 + a10 + a11 + a12 + a13 + a14 + a15;
+    }
+
+    // Twelve long accumulators, which need register pairs on 32-bit targets.
+    public void timeLongAccumulators12(int count) {
+        long[] data = longData;
+        long a0 = 0, a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5;
+        long a6 = 6, a7 = 7, a8 = 8, a9 = 9, a10 = 10, a11 = 11;
+        for (int i = 0; i < count; ++i) {
+            long v = data[i & 1023];
+            a0 += v; a1 ^= v; a2 += a0; a3 ^= a1;
+            a4 += a2 >>> 1; a5 ^= a3 << 1; a6 += a4; a7 ^= a5;
+            a8 += a6 >>> 2; a9 ^= a7 << 2; a10 += a8; a11 ^= a9;
+        }
+        longResult = a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10 + a11;
+    }
+
+    // Twenty double accumulators, more than the SSE and VFP register files of 32-bit targets.
+    public void timeDoubleAccumulators20(int count) {
+        double[] data = doubleData;
+        double a0 = 0, a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, a6 = 6, a7 = 7, a8 = 8, a9 = 9;
+        double a10 = 10, a11 = 11, a12 = 12, a13 = 13, a14 = 14;
+        double a15 = 15, a16 = 16, a17 = 17, a18 = 18, a19 = 19;
+        for (int i = 0; i < count; ++i) {
+            double v = data[i & 1023];
+            a0 += v; a1 *= 0.5; a2 += a0; a3 -= a1; a4 += a2;
+            a5 -= a3; a6 += a4; a7 -= a5; a8 += a6; a9 -= a7;
+            a10 += a8; a11 -= a9; a12 += a10; a13 -= a11; a14 += a12;
+            a15 -= a13; a16 += a14; a17 -= a15; a18 += a16; a19 -= a17;
+        }
+        doubleResult = a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9
+            + a10 + a11 + a12 + a13 + a14 + a15 + a16 + a17 + a18 + a19;
+    }
+
+    // A loop with a call: values live across the call compete for callee-save registers.
+    public void timeLiveAcrossCall(int count) {
+        int[] data = intData;
+        int a0 = 0, a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, a6 = 6, a7 = 7;
+        for (int i = 0; i < count; ++i) {
+            int v = $noinline$mix(data[i & 1023], i);
+            a0 += v; a1 ^= a0; a2 += a1; a3 ^= a2;
+            a4 += a3; a5 ^= a4; a6 += a5; a7 ^= a6;
+        }
+        intResult = a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7;
+    }
+
+    private static int $noinline$mix(int value, int seed) {
+        return (value ^ seed) * 0x01000193;
+    }
+}
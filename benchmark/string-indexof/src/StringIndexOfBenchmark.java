@@ -17,6 +17,30 @@
 public class StringIndexOfBenchmark {
     public static final String string36 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";  // length = 36
 
+    // Needles of increasing lengths, found only at the end of the haystack. Apart from
+    // needle1, each needle starts with '0' which matches once per copy of string36.
+    public static final String needleTail = "0123456789abcdefghijklmnopqrstuv";  // length = 32
+    public static final String haystack = makeHaystack();  // length = 351
+    public static final String needle1 = "_";
+    public static final String needle2 = needleTail.substring(0, 1) + "_";
+    public static final String needle4 = needleTail.substring(0, 3) + "_";
+    public static final String needle8 = needleTail.substring(0, 7) + "_";
+    public static final String needle16 = needleTail.substring(0, 15) + "_";
+    public static final String needle32 = needleTail.substring(0, 31) + "_";
+
+    private static String makeHaystack() {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < 8; ++i) {
+            sb.append(string36);
+        }
+        // Append every needle, in the order of increasing lengths, each ending with '_'.
+        sb.append("_");
+        for (int length : new int[] { 2, 4, 8, 16, 32 }) {
+            sb.append(needleTail, 0, length - 1).append('_');
+        }
+        return sb.toString();
+    }
+
     public void timeIndexOf0(int count) {
         final char c = '0';
         String s = string36;
@@ -113,10 +137,63 @@ public class StringIndexOfBenchmark {
         }
     }
 
+    public void timeIndexOfString1(int count) {
+        final String needle = needle1;
+        String s = haystack;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, needle);
+        }
+    }
+
+    public void timeIndexOfString2(int count) {
+        final String needle = needle2;
+        String s = haystack;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, needle);
+        }
+    }
+
+    public void timeIndexOfString4(int count) {
+        final String needle = needle4;
+        String s = haystack;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, needle);
+        }
+    }
+
+    public void timeIndexOfString8(int count) {
+        final String needle = needle8;
+        String s = haystack;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, needle);
+        }
+    }
+
+    public void timeIndexOfString16(int count) {
+        final String needle = needle16;
+        String s = haystack;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, needle);
+        }
+    }
+
+    public void timeIndexOfString32(int count) {
+        final String needle = needle32;
+        String s = haystack;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, needle);
+        }
+    }
+
     static int $noinline$indexOf(String s, char c) {
         if (doThrow) { throw new Error(); }
         return s.indexOf(c);
     }
 
+    static int $noinline$indexOf(String s, String needle) {
+        if (doThrow) { throw new Error(); }
+        return s.indexOf(needle);
+    }
+
     public static boolean doThrow = false;
 }
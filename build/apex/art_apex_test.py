@@ -743,6 +743,7 @@ class TestingTargetChecker:
     self._checker.check_art_test_data('art-gtest-jars-MultiDexModifiedSecondary.jar')
     self._checker.check_art_test_data('art-gtest-jars-NonStaticLeafMethods.jar')
     self._checker.check_art_test_data('art-gtest-jars-DefaultMethods.jar')
+    self._checker.check_art_test_data('art-gtest-jars-DeepHierarchy.jar')
     self._checker.check_art_test_data('art-gtest-jars-MultiDexUncompressedAligned.jar')
     self._checker.check_art_test_data('art-gtest-jars-StaticsFromCode.jar')
     self._checker.check_art_test_data('art-gtest-jars-ProfileTestMultiDex.jar')
@@ -70,6 +70,7 @@ CompilerOptions::CompilerOptions()
       init_failure_output_(nullptr),
       dump_cfg_file_name_(""),
       dump_cfg_append_(false),
+      dump_compilation_report_file_name_(""),
       force_determinism_(false),
       check_linkage_conditions_(false),
       crash_on_linkage_violation_(false),
@@ -120,8 +121,11 @@ bool CompilerOptions::ParseRegisterAllocationStrategy(const std::string& option,
     register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorLinearScan;
   } else if (option == "graph-color") {
     register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorGraphColor;
+  } else if (option == "tiered") {
+    register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorTiered;
   } else {
-    *error_msg = "Unrecognized register allocation strategy. Try linear-scan, or graph-color.";
+    *error_msg = "Unrecognized register allocation strategy. Try linear-scan, graph-color, "
+                 "or tiered.";
     return false;
   }
   return true;
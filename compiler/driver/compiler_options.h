@@ -305,6 +305,10 @@ class CompilerOptions final {
     return dump_cfg_append_;
   }
 
+  const std::string& GetDumpCompilationReportFileName() const {
+    return dump_compilation_report_file_name_;
+  }
+
   bool IsForceDeterminism() const {
     return force_determinism_;
   }
@@ -439,6 +443,9 @@ class CompilerOptions final {
   std::string dump_cfg_file_name_;
   bool dump_cfg_append_;
 
+  // If not empty, write the time and arena memory used by each pass of each method to this file.
+  std::string dump_compilation_report_file_name_;
+
   // Whether the compiler should trade performance for determinism to guarantee exactly reproducible
   // outcomes.
   bool force_determinism_;
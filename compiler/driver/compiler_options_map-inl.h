@@ -81,8 +81,10 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
   if (map.Exists(Base::DumpCFGAppend)) {
     options->dump_cfg_append_ = true;
   }
+  map.AssignIfExists(Base::DumpCompilationReport, &options->dump_compilation_report_file_name_);
   if (map.Exists(Base::RegisterAllocationStrategy)) {
-    if (!options->ParseRegisterAllocationStrategy(*map.Get(Base::DumpInitFailures), error_msg)) {
+    if (!options->ParseRegisterAllocationStrategy(*map.Get(Base::RegisterAllocationStrategy),
+                                                  error_msg)) {
       return false;
     }
   }
@@ -220,9 +222,18 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                     "(instead of overwriting existing data with new data, which is the default\n"
                     "behavior). This option is only meaningful when used with --dump-cfg.")
           .IntoKey(Map::DumpCFGAppend)
+      .Define("--dump-compilation-report=_")
+          .template WithType<std::string>()
+          .WithHelp("Write the time and arena memory used by each optimizing compiler pass of\n"
+                    "each method to the specified file, in CSV format. See\n"
+                    "tools/compilation-report.py to summarize it.")
+          .IntoKey(Map::DumpCompilationReport)
 
       .Define("--register-allocation-strategy=_")
           .template WithType<std::string>()
+          .WithHelp("Select the register allocator: linear-scan (default), graph-color, or\n"
+                    "tiered (graph-color for optimized JIT code and methods that are hot in\n"
+                    "the profile, linear-scan otherwise).")
           .IntoKey(Map::RegisterAllocationStrategy)
 
       .Define("--resolve-startup-const-strings=_")
@@ -242,6 +242,13 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
   // Returns whether the target supports predicated SIMD instructions.
   virtual bool SupportsPredicatedSIMD() const { return false; }
 
+  // Returns whether calls to MethodHandle.invoke() and MethodHandle.invokeExact() with the
+  // call site `shorty` are specialized on the kind of the MethodHandle. The call site
+  // MethodType is then passed to the HInvokePolymorphic as an extra input.
+  virtual bool CanSpecializeMethodHandleInvoke(const char* shorty ATTRIBUTE_UNUSED) const {
+    return false;
+  }
+
   // Get FP register width in bytes for spilling/restoring in the slow paths.
   //
   // Note: In SIMD graphs this should return SIMD register width as all FP and SIMD registers
@@ -4771,12 +4771,28 @@ void CodeGeneratorARM64::MaybeGenerateInlineCacheCheck(HInstruction* instruction
         info, GetCompilerOptions(), instruction->AsInvoke());
     if (cache != nullptr) {
       uint64_t address = reinterpret_cast64<uint64_t>(cache);
-      vixl::aarch64::Label done;
+      vixl::aarch64::Label done, update;
       __ Mov(x8, address);
       __ Ldr(w9, MemOperand(x8, InlineCache::ClassesOffset().Int32Value()));
       // Fast path for a monomorphic cache.
       __ Cmp(klass.W(), w9);
-      __ B(eq, &done);
+      __ B(ne, &update);
+      // Sample the call in the first entry, saturating at 0xffff. The sample is taken
+      // when the low bits of the baseline hotness count, which this code decrements on
+      // every entry and back edge, are zero.
+      constexpr uint16_t kRate = InlineCache::kCountSamplingRate;
+      int64_t hotness_offset =
+          reinterpret_cast<intptr_t>(info) - reinterpret_cast<intptr_t>(cache) +
+          ProfilingInfo::BaselineHotnessCountOffset().Int32Value();
+      __ Ldrb(w9, MemOperand(x8, hotness_offset));
+      __ Tst(w9, kRate - 1);
+      __ B(ne, &done);
+      __ Ldrh(w9, MemOperand(x8, InlineCache::CountsOffset().Int32Value()));
+      __ Add(w9, w9, kRate);
+      __ Tbnz(w9, 16, &done);
+      __ Strh(w9, MemOperand(x8, InlineCache::CountsOffset().Int32Value()));
+      __ B(&done);
+      __ Bind(&update);
       InvokeRuntime(kQuickUpdateInlineCache, instruction, instruction->GetDexPc());
       __ Bind(&done);
     } else {
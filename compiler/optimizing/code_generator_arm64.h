@@ -125,8 +125,6 @@ const vixl::aarch64::CPURegList callee_saved_fp_registers(vixl::aarch64::CPURegi
 Location ARM64ReturnLocation(DataType::Type return_type);
 
 #define UNIMPLEMENTED_INTRINSIC_LIST_ARM64(V) \
-  V(StringStringIndexOf)                      \
-  V(StringStringIndexOfAfter)                 \
   V(StringBufferAppend)                       \
   V(StringBufferLength)                       \
   V(StringBufferToString)                     \
@@ -1132,6 +1132,7 @@ void CodeGeneratorX86_64::LoadMethod(MethodLoadKind load_kind, Location temp, HI
 void CodeGeneratorX86_64::GenerateStaticOrDirectCall(
     HInvokeStaticOrDirect* invoke, Location temp, SlowPathCode* slow_path) {
   // All registers are assumed to be correctly set up.
+  MaybeEmitVzeroupper();
 
   Location callee_method = temp;  // For all kinds except kRecursive, callee will be in temp.
   switch (invoke->GetMethodLoadKind()) {
@@ -1226,6 +1227,7 @@ void CodeGeneratorX86_64::GenerateStaticOrDirectCall(
 
 void CodeGeneratorX86_64::GenerateVirtualCall(
     HInvokeVirtual* invoke, Location temp_in, SlowPathCode* slow_path) {
+  MaybeEmitVzeroupper();
   CpuRegister temp = temp_in.AsRegister<CpuRegister>();
   size_t method_offset = mirror::Class::EmbeddedVTableEntryOffset(
       invoke->GetVTableIndex(), kX86_64PointerSize).SizeValue();
@@ -1471,7 +1473,9 @@ size_t CodeGeneratorX86_64::RestoreCoreRegister(size_t stack_index, uint32_t reg
 }
 
 size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (UsesYmmRegisters()) {
+    __ vmovups(Address(CpuRegister(RSP), stack_index), YmmRegister(reg_id));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   } else {
     __ movsd(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
@@ -1480,7 +1484,9 @@ size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32
 }
 
 size_t CodeGeneratorX86_64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (UsesYmmRegisters()) {
+    __ vmovups(YmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   } else {
     __ movsd(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
@@ -1507,9 +1513,16 @@ void CodeGeneratorX86_64::InvokeRuntimeWithoutRecordingPcInfo(int32_t entry_poin
 }
 
 void CodeGeneratorX86_64::GenerateInvokeRuntime(int32_t entry_point_offset) {
+  MaybeEmitVzeroupper();
   __ gs()->call(Address::Absolute(entry_point_offset, /* no_rip= */ true));
 }
 
+void CodeGeneratorX86_64::MaybeEmitVzeroupper() {
+  if (UsesYmmRegisters()) {
+    __ vzeroupper();
+  }
+}
+
 namespace detail {
 // Mark which intrinsics we don't have handcrafted code for.
 template <Intrinsics T>
@@ -1819,6 +1832,7 @@ bool CodeGeneratorX86_64::TryGenerateFrameEntry() {
 
 void CodeGeneratorX86_64::GenerateFrameExit() {
   __ cfi().RememberState();
+  MaybeEmitVzeroupper();
   if (!HasEmptyFrame()) {
     uint32_t xmm_spill_location = GetFpuSpillStart();
     size_t xmm_spill_slot_size = GetCalleePreservedFPWidth();
@@ -1880,6 +1894,8 @@ void CodeGeneratorX86_64::Move(Location destination, Location source) {
     XmmRegister dest = destination.AsFpuRegister<XmmRegister>();
     if (source.IsRegister()) {
       __ movd(dest, source.AsRegister<CpuRegister>());
+    } else if (source.IsFpuRegister() && UsesYmmRegisters()) {
+      __ vmovaps(YmmRegister(dest), YmmRegister(source.AsFpuRegister<XmmRegister>()));
     } else if (source.IsFpuRegister()) {
       __ movaps(dest, source.AsFpuRegister<XmmRegister>());
     } else if (source.IsConstant()) {
@@ -3068,11 +3084,26 @@ void CodeGeneratorX86_64::MaybeGenerateInlineCacheCheck(HInstruction* instructio
         info, GetCompilerOptions(), instruction->AsInvoke());
     if (cache != nullptr) {
       uint64_t address = reinterpret_cast64<uint64_t>(cache);
-      NearLabel done;
+      NearLabel done, update;
       __ movq(CpuRegister(TMP), Immediate(address));
       // Fast path for a monomorphic cache.
       __ cmpl(Address(CpuRegister(TMP), InlineCache::ClassesOffset().Int32Value()), klass);
-      __ j(kEqual, &done);
+      __ j(kNotEqual, &update);
+      // Sample the call in the first entry, saturating at 0xffff. The sample is taken
+      // when the low bits of the baseline hotness count, which this code decrements on
+      // every entry and back edge, are zero.
+      constexpr uint16_t kRate = InlineCache::kCountSamplingRate;
+      int32_t hotness_offset = dchecked_integral_cast<int32_t>(
+          reinterpret_cast<intptr_t>(info) - reinterpret_cast<intptr_t>(cache) +
+          ProfilingInfo::BaselineHotnessCountOffset().Int32Value());
+      __ testb(Address(CpuRegister(TMP), hotness_offset), Immediate(kRate - 1));
+      __ j(kNotZero, &done);
+      Address count(CpuRegister(TMP), InlineCache::CountsOffset().Int32Value());
+      __ cmpw(count, Immediate(0xffff - kRate));
+      __ j(kAbove, &done);
+      __ addw(count, Immediate(kRate));
+      __ jmp(&done);
+      __ Bind(&update);
       GenerateInvokeRuntime(
           GetThreadOffset<kX86_64PointerSize>(kQuickUpdateInlineCache).Int32Value());
       __ Bind(&done);
@@ -3087,6 +3118,7 @@ void CodeGeneratorX86_64::MaybeGenerateInlineCacheCheck(HInstruction* instructio
 
 void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invoke) {
   // TODO: b/18116999, our IMTs can miss an IncompatibleClassChangeError.
+  codegen_->MaybeEmitVzeroupper();
   LocationSummary* locations = invoke->GetLocations();
   CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
   Location receiver = locations->InAt(0);
@@ -3144,6 +3176,26 @@ void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invo
   codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
 }
 
+bool CodeGeneratorX86_64::CanSpecializeMethodHandleInvoke(const char* shorty) const {
+  // Only hot call sites are worth the extra runtime call loading the call site MethodType.
+  if (!GetCompilerOptions().IsJitCompiler()) {
+    return false;
+  }
+  // The direct call drops the MethodHandle by moving the core arguments down by one register,
+  // so all arguments must be passed in registers.
+  size_t number_of_core_arguments = 1u;  // The MethodHandle.
+  size_t number_of_fp_arguments = 0u;
+  for (const char* c = shorty + 1; *c != '\0'; ++c) {
+    if (*c == 'F' || *c == 'D') {
+      ++number_of_fp_arguments;
+    } else {
+      ++number_of_core_arguments;
+    }
+  }
+  return number_of_core_arguments <= kParameterCoreRegistersLength &&
+         number_of_fp_arguments <= kParameterFloatRegistersLength;
+}
+
 void LocationsBuilderX86_64::VisitInvokePolymorphic(HInvokePolymorphic* invoke) {
   IntrinsicLocationsBuilderX86_64 intrinsic(codegen_);
   if (intrinsic.TryDispatch(invoke)) {
@@ -6264,16 +6316,20 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
       __ movq(Address(CpuRegister(RSP), destination.GetStackIndex()), CpuRegister(TMP));
     }
   } else if (source.IsSIMDStackSlot()) {
-    if (destination.IsFpuRegister()) {
+    if (destination.IsFpuRegister() && codegen_->UsesYmmRegisters()) {
+      __ vmovups(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                 Address(CpuRegister(RSP), source.GetStackIndex()));
+    } else if (destination.IsFpuRegister()) {
       __ movups(destination.AsFpuRegister<XmmRegister>(),
                 Address(CpuRegister(RSP), source.GetStackIndex()));
     } else {
       DCHECK(destination.IsSIMDStackSlot());
-      size_t high = kX86_64WordSize;
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex()));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex()), CpuRegister(TMP));
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + high));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + high), CpuRegister(TMP));
+      size_t num_of_qwords = codegen_->GetSIMDRegisterWidth() / kX86_64WordSize;
+      for (size_t i = 0; i != num_of_qwords; ++i) {
+        size_t offset = i * kX86_64WordSize;
+        __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + offset));
+        __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + offset), CpuRegister(TMP));
+      }
     }
   } else if (source.IsConstant()) {
     HConstant* constant = source.GetConstant();
@@ -6320,7 +6376,10 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
       }
     }
   } else if (source.IsFpuRegister()) {
-    if (destination.IsFpuRegister()) {
+    if (destination.IsFpuRegister() && codegen_->UsesYmmRegisters()) {
+      __ vmovaps(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                 YmmRegister(source.AsFpuRegister<XmmRegister>()));
+    } else if (destination.IsFpuRegister()) {
       __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
     } else if (destination.IsStackSlot()) {
       __ movss(Address(CpuRegister(RSP), destination.GetStackIndex()),
@@ -6328,8 +6387,12 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     } else if (destination.IsDoubleStackSlot()) {
       __ movsd(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
+    } else if (codegen_->UsesYmmRegisters()) {
+      DCHECK(destination.IsSIMDStackSlot());
+      __ vmovups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                 YmmRegister(source.AsFpuRegister<XmmRegister>()));
     } else {
-       DCHECK(destination.IsSIMDStackSlot());
+      DCHECK(destination.IsSIMDStackSlot());
       __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
                 source.AsFpuRegister<XmmRegister>());
     }
@@ -6375,6 +6438,15 @@ void ParallelMoveResolverX86_64::Exchange128(XmmRegister reg, int mem) {
   __ addq(CpuRegister(RSP), Immediate(extra_slot));
 }
 
+void ParallelMoveResolverX86_64::Exchange256(XmmRegister reg, int mem) {
+  size_t extra_slot = 4 * kX86_64WordSize;
+  __ subq(CpuRegister(RSP), Immediate(extra_slot));
+  __ vmovups(Address(CpuRegister(RSP), 0), YmmRegister(reg));
+  ExchangeMemory64(0, mem + extra_slot, 4);
+  __ vmovups(YmmRegister(reg), Address(CpuRegister(RSP), 0));
+  __ addq(CpuRegister(RSP), Immediate(extra_slot));
+}
+
 void ParallelMoveResolverX86_64::ExchangeMemory32(int mem1, int mem2) {
   ScratchRegisterScope ensure_scratch(
       this, TMP, RAX, codegen_->GetNumberOfCoreRegisters());
@@ -6427,6 +6499,14 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
     Exchange64(destination.AsRegister<CpuRegister>(), source.GetStackIndex());
   } else if (source.IsDoubleStackSlot() && destination.IsDoubleStackSlot()) {
     ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 1);
+  } else if (source.IsFpuRegister() && destination.IsFpuRegister() &&
+             codegen_->UsesYmmRegisters()) {
+    // There is no scratch YMM register; swap the full registers in place.
+    YmmRegister src(source.AsFpuRegister<XmmRegister>());
+    YmmRegister dst(destination.AsFpuRegister<XmmRegister>());
+    __ vxorps(src, src, dst);
+    __ vxorps(dst, dst, src);
+    __ vxorps(src, src, dst);
   } else if (source.IsFpuRegister() && destination.IsFpuRegister()) {
     __ movd(CpuRegister(TMP), source.AsFpuRegister<XmmRegister>());
     __ movaps(source.AsFpuRegister<XmmRegister>(), destination.AsFpuRegister<XmmRegister>());
@@ -6440,11 +6520,17 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
   } else if (source.IsDoubleStackSlot() && destination.IsFpuRegister()) {
     Exchange64(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
   } else if (source.IsSIMDStackSlot() && destination.IsSIMDStackSlot()) {
-    ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 2);
+    ExchangeMemory64(destination.GetStackIndex(),
+                     source.GetStackIndex(),
+                     codegen_->GetSIMDRegisterWidth() / kX86_64WordSize);
   } else if (source.IsFpuRegister() && destination.IsSIMDStackSlot()) {
-    Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    codegen_->UsesYmmRegisters()
+        ? Exchange256(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex())
+        : Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
   } else if (destination.IsFpuRegister() && source.IsSIMDStackSlot()) {
-    Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    codegen_->UsesYmmRegisters()
+        ? Exchange256(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex())
+        : Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
   } else {
     LOG(FATAL) << "Unimplemented swap between " << source << " and " << destination;
   }
@@ -54,9 +54,6 @@ static constexpr size_t kRuntimeParameterFpuRegistersLength =
 static constexpr FloatRegister non_volatile_xmm_regs[] = { XMM12, XMM13, XMM14, XMM15 };
 
 #define UNIMPLEMENTED_INTRINSIC_LIST_X86_64(V) \
-  V(CRC32Update)                               \
-  V(CRC32UpdateBytes)                          \
-  V(CRC32UpdateByteBuffer)                     \
   V(FP16ToFloat)                               \
   V(FP16ToHalf)                                \
   V(FP16Floor)                                 \
@@ -69,8 +66,6 @@ static constexpr FloatRegister non_volatile_xmm_regs[] = { XMM12, XMM13, XMM14,
   V(FP16Compare)                               \
   V(FP16Min)                                   \
   V(FP16Max)                                   \
-  V(StringStringIndexOf)                       \
-  V(StringStringIndexOfAfter)                  \
   V(StringBufferAppend)                        \
   V(StringBufferLength)                        \
   V(StringBufferToString)                      \
@@ -92,8 +87,6 @@ static constexpr FloatRegister non_volatile_xmm_regs[] = { XMM12, XMM13, XMM14,
   V(UnsafeGetAndSetInt)                        \
   V(UnsafeGetAndSetLong)                       \
   V(UnsafeGetAndSetObject)                     \
-  V(MethodHandleInvokeExact)                   \
-  V(MethodHandleInvoke)                        \
   /* OpenJDK 11 */                             \
   V(JdkUnsafeGetAndAddInt)                     \
   V(JdkUnsafeGetAndAddLong)                    \
@@ -216,6 +209,7 @@ class ParallelMoveResolverX86_64 : public ParallelMoveResolverWithSwap {
   void Exchange64(CpuRegister reg, int mem);
   void Exchange64(XmmRegister reg, int mem);
   void Exchange128(XmmRegister reg, int mem);
+  void Exchange256(XmmRegister reg, int mem);
   void ExchangeMemory32(int mem1, int mem2);
   void ExchangeMemory64(int mem1, int mem2, int num_of_qwords);
 
@@ -438,9 +432,22 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   }
 
   size_t GetSIMDRegisterWidth() const override {
-    return 2 * kX86_64WordSize;
+    // With AVX2, vector code uses the full 256-bit YMM registers.
+    return GetInstructionSetFeatures().HasAVX2()
+        ? 4 * kX86_64WordSize
+        : 2 * kX86_64WordSize;
   }
 
+  // Whether the graph holds vector values in YMM registers, so that spills, moves and
+  // slow-path saves of FP registers need the full 256 bits.
+  bool UsesYmmRegisters() const {
+    return GetGraph()->HasSIMD() && GetSIMDRegisterWidth() == 4 * kX86_64WordSize;
+  }
+
+  // Clear the upper YMM halves before leaving vector code, to avoid the AVX-SSE
+  // transition penalty in SSE code that runs next.
+  void MaybeEmitVzeroupper();
+
   HGraphVisitor* GetLocationBuilder() override {
     return &location_builder_;
   }
@@ -506,6 +513,8 @@ class CodeGeneratorX86_64 : public CodeGenerator {
     return false;
   }
 
+  bool CanSpecializeMethodHandleInvoke(const char* shorty) const override;
+
   // Check if the desired_string_load_kind is supported. If it is, return it,
   // otherwise return a fall-back kind that should be used instead.
   HLoadString::LoadKind GetSupportedLoadStringKind(
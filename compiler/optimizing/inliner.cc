@@ -16,6 +16,10 @@
 
 #include "inliner.h"
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+
 #include "art_method-inl.h"
 #include "base/enums.h"
 #include "base/logging.h"
@@ -70,6 +74,18 @@ static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 // recursive calls at all.
 static constexpr size_t kMaximumNumberOfPolymorphicRecursiveCalls = 0;
 
+// Maximum number of receiver types of a megamorphic call that we speculatively inline
+// before falling back to the virtual or interface dispatch.
+static constexpr size_t kMaximumNumberOfMegamorphicInlinedTypes = 2;
+
+// Minimum share, in percent of all the calls profiled at a megamorphic call site, that a
+// receiver type needs to have to be inlined.
+static constexpr uint32_t kMinimumMegamorphicReceiverPercentage = 30;
+
+// Minimum number of calls profiled at a megamorphic call site for its receiver counts to be
+// trusted.
+static constexpr uint32_t kMinimumMegamorphicProfiledCalls = 64;
+
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
@@ -633,12 +649,14 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
   }
 
   StackHandleScope<InlineCache::kIndividualCacheSize> classes(Thread::Current());
+  // Receiver counts, only available with runtime inline caches.
+  uint16_t counts[InlineCache::kIndividualCacheSize] = {};
   // The Zygote JIT compiles based on a profile, so we shouldn't use runtime inline caches
   // for it.
   InlineCacheType inline_cache_type =
       (Runtime::Current()->IsAotCompiler() || Runtime::Current()->IsZygote())
           ? GetInlineCacheAOT(invoke_instruction, &classes)
-          : GetInlineCacheJIT(invoke_instruction, &classes);
+          : GetInlineCacheJIT(invoke_instruction, &classes, counts);
 
   switch (inline_cache_type) {
     case kInlineCacheNoData: {
@@ -659,7 +677,8 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
     case kInlineCacheMonomorphic: {
       MaybeRecordStat(stats_, MethodCompilationStat::kMonomorphicCall);
       if (UseOnlyPolymorphicInliningWithNoDeopt()) {
-        return TryInlinePolymorphicCall(invoke_instruction, classes);
+        return TryInlinePolymorphicCall(
+            invoke_instruction, classes, /* is_megamorphic= */ false);
       } else {
         return TryInlineMonomorphicCall(invoke_instruction, classes);
       }
@@ -667,15 +686,18 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
 
     case kInlineCachePolymorphic: {
       MaybeRecordStat(stats_, MethodCompilationStat::kPolymorphicCall);
-      return TryInlinePolymorphicCall(invoke_instruction, classes);
+      return TryInlinePolymorphicCall(invoke_instruction, classes, /* is_megamorphic= */ false);
     }
 
     case kInlineCacheMegamorphic: {
+      MaybeRecordStat(stats_, MethodCompilationStat::kMegamorphicCall);
+      if (TryInlineMegamorphicCall(invoke_instruction, classes, counts)) {
+        return true;
+      }
       LOG_FAIL_NO_STAT()
           << "Interface or virtual call to "
           << invoke_instruction->GetMethodReference().PrettyMethod()
           << " is megamorphic and not inlined";
-      MaybeRecordStat(stats_, MethodCompilationStat::kMegamorphicCall);
       return false;
     }
 
@@ -692,7 +714,8 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
 
 HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
     HInvoke* invoke_instruction,
-    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes) {
+    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+    /*out*/uint16_t* counts) {
   DCHECK(codegen_->GetCompilerOptions().IsJitCompiler());
 
   ArtMethod* caller = graph_->GetArtMethod();
@@ -730,7 +753,7 @@ HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
     // Bail for now.
     return kInlineCacheNoData;
   }
-  Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(*cache, classes);
+  Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(*cache, classes, counts);
   return GetInlineCacheType(*classes);
 }
 
@@ -1023,11 +1046,14 @@ static void MaybeReplaceAndRemove(HInstruction* new_instruction, HInstruction* o
 
 bool HInliner::TryInlinePolymorphicCall(
     HInvoke* invoke_instruction,
-    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes) {
+    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+    bool is_megamorphic) {
   DCHECK(invoke_instruction->IsInvokeVirtual() || invoke_instruction->IsInvokeInterface())
       << invoke_instruction->DebugName();
 
-  if (TryInlinePolymorphicCallToSameTarget(invoke_instruction, classes)) {
+  // For a megamorphic call, `classes` only contains the dominant receiver types, so the
+  // same target check below would not prove anything about the other receivers.
+  if (!is_megamorphic && TryInlinePolymorphicCallToSameTarget(invoke_instruction, classes)) {
     return true;
   }
 
@@ -1060,7 +1086,7 @@ bool HInliner::TryInlinePolymorphicCall(
 
     // In monomorphic cases when UseOnlyPolymorphicInliningWithNoDeopt() is true, we call
     // `TryInlinePolymorphicCall` even though we are monomorphic.
-    const bool actually_monomorphic = number_of_types == 1;
+    const bool actually_monomorphic = !is_megamorphic && number_of_types == 1;
     DCHECK_IMPLIES(actually_monomorphic, UseOnlyPolymorphicInliningWithNoDeopt());
 
     // We only want to limit recursive polymorphic cases, not monomorphic ones.
@@ -1091,8 +1117,10 @@ bool HInliner::TryInlinePolymorphicCall(
                     << " has inlined " << ArtMethod::PrettyMethod(method);
 
       // If we have inlined all targets before, and this receiver is the last seen,
-      // we deoptimize instead of keeping the original invoke instruction.
-      bool deoptimize = !UseOnlyPolymorphicInliningWithNoDeopt() &&
+      // we deoptimize instead of keeping the original invoke instruction. Megamorphic
+      // calls always keep it, as other receivers are expected.
+      bool deoptimize = !is_megamorphic &&
+          !UseOnlyPolymorphicInliningWithNoDeopt() &&
           all_targets_inlined &&
           (i + 1 == number_of_types);
 
@@ -1119,13 +1147,75 @@ bool HInliner::TryInlinePolymorphicCall(
     return false;
   }
 
-  MaybeRecordStat(stats_, MethodCompilationStat::kInlinedPolymorphicCall);
+  MaybeRecordStat(stats_,
+                  is_megamorphic ? MethodCompilationStat::kInlinedMegamorphicCall
+                                 : MethodCompilationStat::kInlinedPolymorphicCall);
 
   // Lazily run type propagation to get the guards typed.
   run_extra_type_propagation_ = true;
   return true;
 }
 
+bool HInliner::TryInlineMegamorphicCall(
+    HInvoke* invoke_instruction,
+    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+    const uint16_t* counts) {
+  DCHECK(invoke_instruction->IsInvokeVirtual() || invoke_instruction->IsInvokeInterface())
+      << invoke_instruction->DebugName();
+  // Receiver counts are only collected by the baseline code of the JIT.
+  if (!codegen_->GetCompilerOptions().IsJitCompiler()) {
+    return false;
+  }
+
+  // The last entry of a megamorphic cache is overwritten by every receiver that did not get
+  // an entry of its own: its count belongs to all of them and its class is just the last one
+  // seen. Only the other entries are candidates for inlining.
+  DCHECK_EQ(classes.Capacity(), InlineCache::kIndividualCacheSize);
+  size_t number_of_candidates = classes.Size();
+  if (number_of_candidates != InlineCache::kIndividualCacheSize) {
+    // An entry was cleared by the GC, we cannot tell which count belongs to the tail.
+    return false;
+  }
+  --number_of_candidates;
+
+  uint32_t total_count = 0;
+  for (size_t i = 0; i != classes.Size(); ++i) {
+    total_count += counts[i];
+  }
+  if (total_count < kMinimumMegamorphicProfiledCalls) {
+    LOG_FAIL_NO_STAT()
+        << "Megamorphic call to " << invoke_instruction->GetMethodReference().PrettyMethod()
+        << " does not have enough receiver counts";
+    return false;
+  }
+
+  // Sort the candidates by decreasing count, and keep the ones that are hot enough.
+  std::array<size_t, InlineCache::kIndividualCacheSize - 1> order;
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [counts](size_t lhs, size_t rhs) { return counts[lhs] > counts[rhs]; });
+  StackHandleScope<InlineCache::kIndividualCacheSize> hot_classes(Thread::Current());
+  for (size_t i = 0; i != kMaximumNumberOfMegamorphicInlinedTypes; ++i) {
+    size_t index = order[i];
+    if (counts[index] * 100u < total_count * kMinimumMegamorphicReceiverPercentage) {
+      break;
+    }
+    hot_classes.NewHandle(classes.GetReference(index)->AsClass());
+  }
+
+  if (hot_classes.Size() == 0u) {
+    LOG_FAIL_NO_STAT()
+        << "Megamorphic call to " << invoke_instruction->GetMethodReference().PrettyMethod()
+        << " has no dominant receiver type";
+    return false;
+  }
+
+  // Guard the dominant receiver types and keep the original invoke, which dispatches
+  // through the vtable or the IMT, for all other receivers.
+  return TryInlinePolymorphicCall(invoke_instruction, hot_classes, /* is_megamorphic= */ true);
+}
+
 void HInliner::CreateDiamondPatternForPolymorphicInline(HInstruction* compare,
                                                         HInstruction* return_replacement,
                                                         HInstruction* invoke_instruction) {
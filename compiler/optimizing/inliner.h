@@ -194,9 +194,11 @@ class HInliner : public HOptimization {
   // Try getting the inline cache from JIT code cache.
   // Return true if the inline cache was successfully allocated and the
   // invoke info was found in the profile info.
+  // If `counts` is not null, it receives the receiver count of each class in `classes`.
   InlineCacheType GetInlineCacheJIT(
       HInvoke* invoke_instruction,
-      /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes)
+      /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+      /*out*/uint16_t* counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Try getting the inline cache from AOT offline profile.
@@ -220,9 +222,22 @@ class HInliner : public HOptimization {
                                 const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Try to inline targets of a polymorphic call.
+  // Try to inline targets of a polymorphic call. If `is_megamorphic`, `classes` only
+  // holds some of the receiver types seen and the original invoke is always kept as
+  // the fallback for the others.
   bool TryInlinePolymorphicCall(HInvoke* invoke_instruction,
-                                const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
+                                const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+                                bool is_megamorphic)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Try to inline the dominant receiver types of a megamorphic call, as found with the
+  // receiver `counts` of its inline cache. If successful, the code in the graph will look like:
+  // if (receiver.getClass() == A) { ... // inlined A code }
+  // else if (receiver.getClass() == B) { ... // inlined B code }
+  // else { ... // original virtual or interface call }
+  bool TryInlineMegamorphicCall(HInvoke* invoke_instruction,
+                                const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+                                const uint16_t* counts)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   bool TryInlinePolymorphicCallToSameTarget(
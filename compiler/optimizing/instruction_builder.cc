@@ -1365,18 +1365,41 @@ bool HInstructionBuilder::BuildInvokePolymorphic(uint32_t dex_pc,
                                             &imt_or_vtable_index,
                                             &is_string_constructor);
 
+  // Calls to MethodHandle.invoke() and invokeExact() that the code generator specializes on
+  // the MethodHandle kind compare the MethodHandle type with the call site MethodType.
+  HLoadMethodType* call_site_type = nullptr;
+  if (resolved_method != nullptr && resolved_method->IsIntrinsic()) {
+    Intrinsics intrinsic = static_cast<Intrinsics>(resolved_method->GetIntrinsic());
+    if ((intrinsic == Intrinsics::kMethodHandleInvoke ||
+         intrinsic == Intrinsics::kMethodHandleInvokeExact) &&
+        code_generator_->CanSpecializeMethodHandleInvoke(shorty)) {
+      call_site_type = new (allocator_) HLoadMethodType(
+          graph_->GetCurrentMethod(), proto_idx, *dex_compilation_unit_->GetDexFile(), dex_pc);
+    }
+  }
+
   MethodReference method_reference(&graph_->GetDexFile(), method_idx);
-  HInvoke* invoke = new (allocator_) HInvokePolymorphic(allocator_,
-                                                        number_of_arguments,
-                                                        return_type,
-                                                        dex_pc,
-                                                        method_reference,
-                                                        resolved_method,
-                                                        resolved_method_reference,
-                                                        proto_idx);
+  HInvoke* invoke = new (allocator_) HInvokePolymorphic(
+      allocator_,
+      number_of_arguments,
+      /* number_of_other_inputs= */ (call_site_type != nullptr) ? 1u : 0u,
+      return_type,
+      dex_pc,
+      method_reference,
+      resolved_method,
+      resolved_method_reference,
+      proto_idx);
+  if (call_site_type != nullptr) {
+    invoke->SetRawInputAt(number_of_arguments, call_site_type);
+  }
   if (!HandleInvoke(invoke, operands, shorty, /* is_unresolved= */ false)) {
     return false;
   }
+  if (call_site_type != nullptr) {
+    // Load the MethodType after the null check of the MethodHandle.
+    current_block_->InsertInstructionBefore(call_site_type, invoke);
+    InitializeInstruction(call_site_type);
+  }
 
   if (invoke->GetIntrinsic() != Intrinsics::kNone &&
       invoke->GetIntrinsic() != Intrinsics::kMethodHandleInvoke &&
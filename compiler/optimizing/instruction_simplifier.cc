@@ -1255,6 +1255,10 @@ void InstructionSimplifierVisitor::VisitIf(HIf* instruction) {
     // Swap successors if input is negated.
     instruction->ReplaceInput(condition->InputAt(0), 0);
     instruction->GetBlock()->SwapSuccessors();
+    // Keep the branch profile attached to the right successors.
+    uint16_t true_count = instruction->GetTrueCount();
+    instruction->SetTrueCount(instruction->GetFalseCount());
+    instruction->SetFalseCount(true_count);
     RecordSimplification();
   }
 }
@@ -63,6 +63,7 @@ using helpers::SRegisterFrom;
 using helpers::WRegisterFrom;
 using helpers::XRegisterFrom;
 using helpers::HRegisterFrom;
+using helpers::VRegisterFrom;
 using helpers::InputRegisterAt;
 using helpers::OutputRegister;
 
@@ -2180,6 +2181,252 @@ void IntrinsicCodeGeneratorARM64::VisitStringIndexOfAfter(HInvoke* invoke) {
   GenerateVisitStringIndexOf(invoke, GetVIXLAssembler(), codegen_, /* start_at_zero= */ false);
 }
 
+static void CreateStringStringIndexOfLocations(HInvoke* invoke,
+                                               ArenaAllocator* allocator,
+                                               bool start_at_zero) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  if (!start_at_zero) {
+    locations->SetInAt(2, Location::RequiresRegister());          // The starting index.
+  }
+  // The output is used as the current search position.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  // The last possible match position, the target length, the match mask, the candidate
+  // position, the char counter, two temporaries and the data pointers of both strings.
+  for (size_t i = 0; i != 9u; ++i) {
+    locations->AddTemp(Location::RequiresRegister());
+  }
+  // The broadcast first and last chars of the target and two blocks of the string.
+  for (size_t i = 0; i != 4u; ++i) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+}
+
+static void LoadStringChar(MacroAssembler* masm,
+                           Register dst,
+                           Register data,
+                           Register index,
+                           size_t char_shift) {
+  if (char_shift == 0u) {
+    __ Ldrb(dst, MemOperand(data, index.X()));
+  } else {
+    DCHECK_EQ(char_shift, 1u);
+    __ Ldrh(dst, MemOperand(data, index.X(), LSL, 1));
+  }
+}
+
+// Generate the search of a target string in a string with the same char size, for positions
+// from `out` to `limit`, both included. Binds `out` to the position of the first match and
+// branches to `done`, or branches to `not_found`.
+//
+// The candidate positions are filtered 16 bytes at a time by comparing both the first and
+// the last char of the target, and only the positions matching both are fully compared.
+static void GenerateStringStringIndexOfSearch(MacroAssembler* masm,
+                                              LocationSummary* locations,
+                                              size_t char_shift,
+                                              vixl::aarch64::Label* not_found,
+                                              vixl::aarch64::Label* done) {
+  const int32_t char_size = 1 << char_shift;
+  const int32_t chars_per_block = kQRegSizeInBytes >> char_shift;
+
+  Register out = WRegisterFrom(locations->Out());
+  Register limit = WRegisterFrom(locations->GetTemp(0));
+  Register target_length = WRegisterFrom(locations->GetTemp(1));
+  Register mask = XRegisterFrom(locations->GetTemp(2));
+  Register candidate = WRegisterFrom(locations->GetTemp(3));
+  Register counter = WRegisterFrom(locations->GetTemp(4));
+  Register temp = WRegisterFrom(locations->GetTemp(5));
+  Register temp2 = WRegisterFrom(locations->GetTemp(6));
+  Register string_data = XRegisterFrom(locations->GetTemp(7));
+  Register target_data = XRegisterFrom(locations->GetTemp(8));
+  VRegister first_char = VRegisterFrom(locations->GetTemp(9));
+  VRegister last_char = VRegisterFrom(locations->GetTemp(10));
+  VRegister first_block = VRegisterFrom(locations->GetTemp(11));
+  VRegister last_block = VRegisterFrom(locations->GetTemp(12));
+
+  vixl::aarch64::Label block_loop, candidate_loop, next_block, char_loop, char_next, found;
+
+  // Compares the chars between the first and the last of the target with the chars of the
+  // string at the position `candidate`. Branches to `found` if they all match, falls through
+  // otherwise. The callers must have compared the first and the last char already.
+  auto compare_candidate = [&]() {
+    vixl::aarch64::Label compare_loop;
+    __ Sub(counter, target_length, 1);
+    __ Bind(&compare_loop);
+    __ Subs(counter, counter, 1);
+    __ B(le, &found);
+    __ Add(temp, candidate, counter);
+    LoadStringChar(masm, temp, string_data, temp, char_shift);
+    LoadStringChar(masm, temp2, target_data, counter, char_shift);
+    __ Cmp(temp, temp2);
+    __ B(eq, &compare_loop);
+  };
+
+  // Returns the view of `reg` with one lane per char.
+  auto chars = [char_shift](VRegister reg) {
+    return (char_shift == 0u) ? reg.V16B() : reg.V8H();
+  };
+
+  // Broadcast the first and the last char of the target.
+  __ Mov(temp2, 0);
+  LoadStringChar(masm, temp, target_data, temp2, char_shift);
+  __ Dup(chars(first_char), temp);
+  __ Sub(temp2, target_length, 1);
+  LoadStringChar(masm, temp, target_data, temp2, char_shift);
+  __ Dup(chars(last_char), temp);
+
+  // Filter whole blocks while the last char of the block's last candidate is in the string.
+  __ Bind(&block_loop);
+  __ Sub(temp, limit, out);
+  __ Cmp(temp, chars_per_block - 1);
+  __ B(lt, &char_loop);
+  __ Add(temp.X(), string_data, Operand(out.X(), LSL, char_shift));
+  __ Ldr(first_block.Q(), MemOperand(temp.X()));
+  __ Add(temp2.X(), temp.X(), Operand(target_length.X(), LSL, char_shift));
+  __ Ldr(last_block.Q(), MemOperand(temp2.X(), -char_size));
+  __ Cmeq(chars(first_block), chars(first_block), chars(first_char));
+  __ Cmeq(chars(last_block), chars(last_block), chars(last_char));
+  __ And(first_block.V16B(), first_block.V16B(), last_block.V16B());
+  // There is no byte mask move on NEON. Narrow the match bytes to nibbles instead, which
+  // leaves 4 bits per byte char and 8 bits per 16-bit char, and keep one bit per char.
+  __ Shrn(first_block.V8B(), first_block.V8H(), 4);
+  __ Fmov(mask, first_block.D());
+  __ And(mask, mask, (char_shift == 0u) ? UINT64_C(0x1111111111111111)
+                                        : UINT64_C(0x0101010101010101));
+  __ Bind(&candidate_loop);
+  __ Cbz(mask, &next_block);
+  __ Rbit(temp.X(), mask);
+  __ Clz(temp.X(), temp.X());
+  __ Add(candidate, out, Operand(temp, LSR, 2 + char_shift));
+  compare_candidate();
+  // Clear the lowest set bit of the mask and try the next candidate.
+  __ Sub(temp.X(), mask, 1);
+  __ And(mask, mask, temp.X());
+  __ B(&candidate_loop);
+  __ Bind(&next_block);
+  __ Add(out, out, chars_per_block);
+  __ B(&block_loop);
+
+  // Check the remaining candidates one by one.
+  __ Bind(&char_loop);
+  __ Cmp(out, limit);
+  __ B(gt, not_found);
+  LoadStringChar(masm, temp, string_data, out, char_shift);
+  __ Mov(temp2, 0);
+  LoadStringChar(masm, temp2, target_data, temp2, char_shift);
+  __ Cmp(temp, temp2);
+  __ B(ne, &char_next);
+  // Unlike in the blocks, the last char has not been compared yet.
+  __ Add(temp, out, target_length);
+  __ Sub(temp, temp, 1);
+  LoadStringChar(masm, temp, string_data, temp, char_shift);
+  __ Sub(temp2, target_length, 1);
+  LoadStringChar(masm, temp2, target_data, temp2, char_shift);
+  __ Cmp(temp, temp2);
+  __ B(ne, &char_next);
+  __ Mov(candidate, out);
+  compare_candidate();
+  __ Bind(&char_next);
+  __ Add(out, out, 1);
+  __ B(&char_loop);
+
+  __ Bind(&found);
+  __ Mov(out, candidate);
+  __ B(done);
+}
+
+static void GenerateStringStringIndexOf(HInvoke* invoke,
+                                        CodeGeneratorARM64* codegen,
+                                        bool start_at_zero) {
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  Register string_obj = InputRegisterAt(invoke, 0);
+  Register target = InputRegisterAt(invoke, 1);
+  Register out = OutputRegister(invoke);
+  Register limit = WRegisterFrom(locations->GetTemp(0));
+  Register target_length = WRegisterFrom(locations->GetTemp(1));
+  Register temp = WRegisterFrom(locations->GetTemp(5));
+  Register string_data = XRegisterFrom(locations->GetTemp(7));
+  Register target_data = XRegisterFrom(locations->GetTemp(8));
+
+  // The slow path handles a null target, an empty target, a start index out of the string
+  // and strings with different compression states.
+  SlowPathCodeARM64* slow_path =
+      new (codegen->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen->AddSlowPath(slow_path);
+  if (invoke->InputAt(1)->CanBeNull()) {
+    __ Cbz(target, slow_path->GetEntryLabel());
+  }
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+  __ Ldr(limit, HeapOperand(string_obj, count_offset));
+  __ Ldr(target_length, HeapOperand(target, count_offset));
+  if (mirror::kUseStringCompression) {
+    __ Eor(temp, limit, target_length);
+    __ Tbnz(temp, 0, slow_path->GetEntryLabel());
+    // Keep the flagged count of the string to select the char size below.
+    __ Mov(temp, limit);
+    __ Lsr(limit, limit, 1u);
+    __ Lsr(target_length, target_length, 1u);
+  }
+  __ Cbz(target_length, slow_path->GetEntryLabel());
+
+  if (start_at_zero) {
+    __ Mov(out, 0);
+  } else {
+    __ Mov(out, InputRegisterAt(invoke, 2));
+    // An unsigned comparison also sends negative start indexes to the slow path.
+    __ Cmp(out, limit);
+    __ B(hs, slow_path->GetEntryLabel());
+  }
+
+  // Compute the last position where the target fits in the string.
+  vixl::aarch64::Label not_found, done;
+  __ Sub(limit, limit, target_length);
+  __ Cmp(limit, out);
+  __ B(lt, &not_found);
+
+  __ Add(string_data, string_obj.X(), value_offset);
+  __ Add(target_data, target.X(), value_offset);
+  if (mirror::kUseStringCompression) {
+    vixl::aarch64::Label compressed;
+    __ Tbz(temp, 0, &compressed);
+    GenerateStringStringIndexOfSearch(masm, locations, /* char_shift= */ 1u, &not_found, &done);
+    __ Bind(&compressed);
+    GenerateStringStringIndexOfSearch(masm, locations, /* char_shift= */ 0u, &not_found, &done);
+  } else {
+    GenerateStringStringIndexOfSearch(masm, locations, /* char_shift= */ 1u, &not_found, &done);
+  }
+
+  __ Bind(&not_found);
+  __ Mov(out, -1);
+  __ Bind(&done);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringStringIndexOf(HInvoke* invoke) {
+  CreateStringStringIndexOfLocations(invoke, allocator_, /* start_at_zero= */ true);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringStringIndexOf(HInvoke* invoke) {
+  GenerateStringStringIndexOf(invoke, codegen_, /* start_at_zero= */ true);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringStringIndexOfAfter(HInvoke* invoke) {
+  CreateStringStringIndexOfLocations(invoke, allocator_, /* start_at_zero= */ false);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringStringIndexOfAfter(HInvoke* invoke) {
+  GenerateStringStringIndexOf(invoke, codegen_, /* start_at_zero= */ false);
+}
+
 void IntrinsicLocationsBuilderARM64::VisitStringNewStringFromBytes(HInvoke* invoke) {
   LocationSummary* locations = new (allocator_) LocationSummary(
       invoke, LocationSummary::kCallOnMainAndSlowPath, kIntrinsified);
@@ -4358,6 +4605,10 @@ class VarHandleSlowPathARM64 : public IntrinsicSlowPathARM64 {
     return &byte_array_view_check_label_;
   }
 
+  vixl::aarch64::Label* GetByteBufferViewCheckLabel() {
+    return &byte_buffer_view_check_label_;
+  }
+
   vixl::aarch64::Label* GetNativeByteOrderLabel() {
     return &native_byte_order_label_;
   }
@@ -4378,7 +4629,7 @@ class VarHandleSlowPathARM64 : public IntrinsicSlowPathARM64 {
   }
 
   void EmitNativeCode(CodeGenerator* codegen_in) override {
-    if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    if (GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked()) {
       EmitByteArrayViewCode(codegen_in);
     }
     IntrinsicSlowPathARM64::EmitNativeCode(codegen_in);
@@ -4394,8 +4645,11 @@ class VarHandleSlowPathARM64 : public IntrinsicSlowPathARM64 {
   }
 
   void EmitByteArrayViewCode(CodeGenerator* codegen_in);
+  void EmitByteBufferViewChecks(CodeGeneratorARM64* codegen,
+                                vixl::aarch64::Label* byte_order_check);
 
   vixl::aarch64::Label byte_array_view_check_label_;
+  vixl::aarch64::Label byte_buffer_view_check_label_;
   vixl::aarch64::Label native_byte_order_label_;
   // Shared parameter for all VarHandle intrinsics.
   std::memory_order order_;
@@ -4575,6 +4829,17 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
     __ Cbz(object, slow_path->GetEntryLabel());
   }
 
+  // With the exception of `kPrimNot`, `kPrimByte` and `kPrimBoolean`, we shall check
+  // for a byte array view or a ByteBuffer view in the slow path. The checks require
+  // the view VarHandle classes to be in the boot image, so we cannot emit them if
+  // we're JITting without boot image.
+  bool boot_image_available =
+      codegen->GetCompilerOptions().IsBootImage() ||
+      !Runtime::Current()->GetHeap()->GetBootImageSpaces().empty();
+  bool can_be_view = (primitive_type != Primitive::kPrimNot) &&
+                     (DataType::Size(value_type) != 1u) &&
+                     boot_image_available;
+
   UseScratchRegisterScope temps(masm);
   Register temp = temps.AcquireW();
   Register temp2 = temps.AcquireW();
@@ -4598,10 +4863,13 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
   // We do this check without read barrier, so there can be false negatives which we
   // defer to the slow path. There shall be no false negatives for array classes in the
   // boot image (including Object[] and primitive arrays) because they are non-movable.
+  //
+  // For a ByteBuffer view, coordinateType0 is ByteBuffer and the object is an instance
+  // of one of its subclasses, so the slow path checks for a heap ByteBuffer first.
   __ Ldr(temp2, HeapOperand(object, class_offset.Int32Value()));
   codegen->GetAssembler()->MaybeUnpoisonHeapReference(temp2);
   __ Cmp(temp, temp2);
-  __ B(slow_path->GetEntryLabel(), ne);
+  __ B(can_be_view ? slow_path->GetByteBufferViewCheckLabel() : slow_path->GetEntryLabel(), ne);
 
   // Check that the coordinateType0 is an array type. We do not need a read barrier
   // for loading constant reference fields (or chains of them) for comparison with null,
@@ -4616,14 +4884,6 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
     static_assert(Primitive::kPrimNot == 0);
     __ Cbnz(temp2, slow_path->GetEntryLabel());
   } else {
-    // With the exception of `kPrimNot` (handled above), `kPrimByte` and `kPrimBoolean`,
-    // we shall check for a byte array view in the slow path.
-    // The check requires the ByteArrayViewVarHandle.class to be in the boot image,
-    // so we cannot emit that if we're JITting without boot image.
-    bool boot_image_available =
-        codegen->GetCompilerOptions().IsBootImage() ||
-        !Runtime::Current()->GetHeap()->GetBootImageSpaces().empty();
-    bool can_be_view = (DataType::Size(value_type) != 1u) && boot_image_available;
     vixl::aarch64::Label* slow_path_label =
         can_be_view ? slow_path->GetByteArrayViewCheckLabel() : slow_path->GetEntryLabel();
     __ Cmp(temp2, static_cast<uint16_t>(primitive_type));
@@ -5697,8 +5957,120 @@ void IntrinsicCodeGeneratorARM64::VisitVarHandleGetAndBitwiseXorRelease(HInvoke*
   GenerateVarHandleGetAndUpdate(invoke, codegen_, GetAndUpdateOp::kXor, std::memory_order_release);
 }
 
+void VarHandleSlowPathARM64::EmitByteBufferViewChecks(CodeGeneratorARM64* codegen,
+                                                      vixl::aarch64::Label* byte_order_check) {
+  DCHECK(GetByteBufferViewCheckLabel()->IsLinked());
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
+  HInvoke* invoke = GetInvoke();
+  DataType::Type value_type =
+      GetVarHandleExpectedValueType(invoke, /*expected_coordinates_count=*/ 2u);
+  size_t size = DataType::Size(value_type);
+  Register varhandle = InputRegisterAt(invoke, 0);
+  Register object = InputRegisterAt(invoke, 1);
+  Register index = InputRegisterAt(invoke, 2);
+
+  MemberOffset class_offset = mirror::Object::ClassOffset();
+  MemberOffset super_class_offset = mirror::Class::SuperClassOffset();
+  MemberOffset coordinate_type0_offset = mirror::VarHandle::CoordinateType0Offset();
+  MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
+  MemberOffset address_offset = WellKnownClasses::java_nio_Buffer_address->GetOffset();
+  MemberOffset limit_offset = WellKnownClasses::java_nio_Buffer_limit->GetOffset();
+  MemberOffset hb_offset = WellKnownClasses::java_nio_ByteBuffer_hb->GetOffset();
+  MemberOffset buffer_offset_offset = WellKnownClasses::java_nio_ByteBuffer_offset->GetOffset();
+  MemberOffset is_read_only_offset = WellKnownClasses::java_nio_ByteBuffer_isReadOnly->GetOffset();
+
+  __ Bind(GetByteBufferViewCheckLabel());
+
+  VarHandleTarget target = GetVarHandleTarget(invoke);
+  {
+    UseScratchRegisterScope temps(masm);
+    Register temp = temps.AcquireW();
+    Register temp2 = temps.AcquireW();
+
+    // The main path found that the class of the actual coordinate argument is not
+    // the coordinateType0. Check if the `varhandle` references a ByteBufferViewVarHandle.
+    __ Ldr(temp, HeapOperand(varhandle, class_offset.Int32Value()));
+    codegen->GetAssembler()->MaybeUnpoisonHeapReference(temp);
+    codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteBufferViewVarHandle);
+    __ Cmp(temp, temp2);
+    __ B(GetEntryLabel(), ne);
+
+    // Check that the object is a direct subclass of the coordinateType0 (ByteBuffer), such
+    // as HeapByteBuffer. As in the main path, this is done without read barriers and there
+    // can be false negatives which we defer to the runtime.
+    __ Ldr(temp, HeapOperand(object, class_offset.Int32Value()));
+    codegen->GetAssembler()->MaybeUnpoisonHeapReference(temp);
+    __ Ldr(temp, HeapOperand(temp, super_class_offset.Int32Value()));
+    __ Ldr(temp2, HeapOperand(varhandle, coordinate_type0_offset.Int32Value()));
+    __ Cmp(temp, temp2);  // Both references are poisoned or neither is.
+    __ B(GetEntryLabel(), ne);
+
+    // Leave buffers backed by native memory to the runtime.
+    __ Ldr(temp.X(), HeapOperand(object, address_offset.Int32Value()));
+    __ Cbnz(temp.X(), GetEntryLabel());
+
+    // The runtime throws ReadOnlyBufferException for any access mode that writes.
+    if (GetAccessModeTemplate() != mirror::VarHandle::AccessModeTemplate::kGet) {
+      __ Ldrb(temp, HeapOperand(object, is_read_only_offset.Int32Value()));
+      __ Cbnz(temp, GetEntryLabel());
+    }
+
+    // Check for index out of bounds. The index is relative to the buffer offset and
+    // the access must fit below the buffer limit.
+    __ Ldr(temp, HeapOperand(object, limit_offset.Int32Value()));
+    __ Subs(temp, temp, index);
+    __ Ccmp(temp, size, NoFlag, hs);  // If SUBS yields LO (C=false), keep the C flag clear.
+    __ B(GetEntryLabel(), lo);
+  }
+
+  // Load the backing array. We are going to access its data, so we need the to-space
+  // reference. We cannot add a read barrier slow path while emitting slow paths, so
+  // call the marking entrypoint directly when the GC is marking. The entrypoint
+  // clobbers IP0, so do not keep any value in scratch registers across the call.
+  __ Ldr(target.offset, HeapOperand(object, hb_offset.Int32Value()));
+  codegen->GetAssembler()->MaybeUnpoisonHeapReference(target.offset);
+  if (gUseReadBarrier) {
+    DCHECK(kUseBakerReadBarrier);
+    vixl::aarch64::Label is_not_marking;
+    __ Cbz(mr, &is_not_marking);
+    int32_t entry_point_offset =
+        Thread::ReadBarrierMarkEntryPointsOffset<kArm64PointerSize>(target.offset.GetCode());
+    // This runtime call does not require a stack map.
+    codegen->InvokeRuntimeWithoutRecordingPcInfo(entry_point_offset, invoke, this);
+    __ Bind(&is_not_marking);
+  }
+  __ Cbz(target.offset, GetEntryLabel());
+
+  {
+    UseScratchRegisterScope temps(masm);
+    Register temp = temps.AcquireW();
+
+    // Compute the offset of the value in the backing array and check its alignment.
+    // The array data is at least 8-byte aligned in memory, less the `data_offset`.
+    __ Ldr(temp, HeapOperand(object, buffer_offset_offset.Int32Value()));
+    __ Add(temp, temp, index);
+    __ Add(temp, temp, data_offset.Int32Value());
+    DCHECK(IsPowerOfTwo(size));
+    if (size == 2u) {
+      __ Tbnz(temp, 0, GetEntryLabel());
+    } else {
+      __ Tst(temp, size - 1u);
+      __ B(GetEntryLabel(), ne);
+    }
+
+    // The target object register holds the ByteBuffer and it must be preserved for the
+    // runtime call, so express the address of the value relative to the ByteBuffer.
+    // The accessors use the full X register of the `target.offset`.
+    // No safepoint can move either object before the access.
+    __ Add(target.offset.X(), target.offset.X(), temp.X());
+    __ Sub(target.offset.X(), target.offset.X(), target.object.X());
+  }
+
+  __ B(byte_order_check);
+}
+
 void VarHandleSlowPathARM64::EmitByteArrayViewCode(CodeGenerator* codegen_in) {
-  DCHECK(GetByteArrayViewCheckLabel()->IsLinked());
+  DCHECK(GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked());
   CodeGeneratorARM64* codegen = down_cast<CodeGeneratorARM64*>(codegen_in);
   MacroAssembler* masm = codegen->GetVIXLAssembler();
   HInvoke* invoke = GetInvoke();
@@ -5717,10 +6089,18 @@ void VarHandleSlowPathARM64::EmitByteArrayViewCode(CodeGenerator* codegen_in) {
   MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
   MemberOffset native_byte_order_offset = mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
 
-  __ Bind(GetByteArrayViewCheckLabel());
+  // Both view VarHandle classes keep the byte order in the same field.
+  DCHECK_EQ(native_byte_order_offset.Uint32Value(),
+            mirror::ByteBufferViewVarHandle::NativeByteOrderOffset().Uint32Value());
+  vixl::aarch64::Label byte_order_check;
+  if (GetByteBufferViewCheckLabel()->IsLinked()) {
+    EmitByteBufferViewChecks(codegen, &byte_order_check);
+  }
 
   VarHandleTarget target = GetVarHandleTarget(invoke);
-  {
+  if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    __ Bind(GetByteArrayViewCheckLabel());
+
     UseScratchRegisterScope temps(masm);
     Register temp = temps.AcquireW();
     Register temp2 = temps.AcquireW();
@@ -5751,6 +6131,12 @@ void VarHandleSlowPathARM64::EmitByteArrayViewCode(CodeGenerator* codegen_in) {
       __ Tst(target.offset, size - 1u);
       __ B(GetEntryLabel(), ne);
     }
+  }
+
+  __ Bind(&byte_order_check);
+  {
+    UseScratchRegisterScope temps(masm);
+    Register temp = temps.AcquireW();
 
     // Byte order check. For native byte order return to the main path.
     if (access_mode_template == mirror::VarHandle::AccessModeTemplate::kSet &&
@@ -29,6 +29,7 @@
 #include "intrinsics_utils.h"
 #include "lock_word.h"
 #include "mirror/array-inl.h"
+#include "mirror/method_handle_impl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/reference.h"
 #include "mirror/string.h"
@@ -1557,6 +1558,265 @@ void IntrinsicCodeGeneratorX86_64::VisitStringIndexOfAfter(HInvoke* invoke) {
   GenerateStringIndexOf(invoke, GetAssembler(), codegen_, /* start_at_zero= */ false);
 }
 
+static void CreateStringStringIndexOfLocations(HInvoke* invoke,
+                                               ArenaAllocator* allocator,
+                                               bool start_at_zero) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  if (!start_at_zero) {
+    locations->SetInAt(2, Location::RequiresRegister());          // The starting index.
+  }
+  // The output is used as the current search position.
+  locations->SetOut(Location::RequiresRegister());
+  // The last possible match position, the target length, the match mask, the candidate
+  // position, the char counter and a temporary.
+  for (size_t i = 0; i != 6u; ++i) {
+    locations->AddTemp(Location::RequiresRegister());
+  }
+  // The broadcast first and last chars of the target and two blocks of the string.
+  for (size_t i = 0; i != 4u; ++i) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+}
+
+static void LoadStringChar(X86_64Assembler* assembler,
+                           CpuRegister dst,
+                           const Address& src,
+                           ScaleFactor char_scale) {
+  if (char_scale == TIMES_1) {
+    __ movzxb(dst, src);
+  } else {
+    DCHECK_EQ(char_scale, TIMES_2);
+    __ movzxw(dst, src);
+  }
+}
+
+// Generate the search of a target string in a string with the same char size, for positions
+// from `out` to `limit`, both included. Binds `out` to the position of the first match and
+// jumps to `done`, or jumps to `not_found`.
+//
+// The candidate positions are filtered 16 bytes at a time by comparing both the first and
+// the last char of the target, and only the positions matching both are fully compared.
+static void GenerateStringStringIndexOfSearch(X86_64Assembler* assembler,
+                                              LocationSummary* locations,
+                                              ScaleFactor char_scale,
+                                              Label* not_found,
+                                              Label* done) {
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+  const int32_t char_size = 1 << static_cast<int32_t>(char_scale);
+  const int32_t chars_per_block = 16 / char_size;
+
+  CpuRegister string_obj = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister target = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister limit = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister target_length = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister mask = locations->GetTemp(2).AsRegister<CpuRegister>();
+  CpuRegister candidate = locations->GetTemp(3).AsRegister<CpuRegister>();
+  CpuRegister counter = locations->GetTemp(4).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(5).AsRegister<CpuRegister>();
+  XmmRegister first_char = locations->GetTemp(6).AsFpuRegister<XmmRegister>();
+  XmmRegister last_char = locations->GetTemp(7).AsFpuRegister<XmmRegister>();
+  XmmRegister first_block = locations->GetTemp(8).AsFpuRegister<XmmRegister>();
+  XmmRegister last_block = locations->GetTemp(9).AsFpuRegister<XmmRegister>();
+
+  Label block_loop, candidate_loop, next_block, char_loop, char_next, found;
+
+  // Compares the chars between the first and the last of the target with the chars of the
+  // string at the position `candidate`. Jumps to `found` if they all match, falls through
+  // otherwise. The callers must have compared the first and the last char already.
+  auto compare_candidate = [&]() {
+    NearLabel compare_loop;
+    __ leal(counter, Address(target_length, -1));
+    __ Bind(&compare_loop);
+    __ subl(counter, Immediate(1));
+    __ j(kLessEqual, &found);
+    __ leal(temp, Address(candidate, counter, TIMES_1, 0));
+    Address string_char(string_obj, temp, char_scale, value_offset);
+    Address target_char(target, counter, char_scale, value_offset);
+    LoadStringChar(assembler, temp, string_char, char_scale);
+    LoadStringChar(assembler, CpuRegister(TMP), target_char, char_scale);
+    __ cmpl(temp, CpuRegister(TMP));
+    __ j(kEqual, &compare_loop);
+  };
+
+  // Broadcast the first and the last char of the target.
+  LoadStringChar(assembler, temp, Address(target, value_offset), char_scale);
+  __ movd(first_char, temp, /*is64bit=*/ false);
+  LoadStringChar(assembler,
+                 temp,
+                 Address(target, target_length, char_scale, value_offset - char_size),
+                 char_scale);
+  __ movd(last_char, temp, /*is64bit=*/ false);
+  for (XmmRegister reg : {first_char, last_char}) {
+    if (char_scale == TIMES_1) {
+      __ punpcklbw(reg, reg);
+    }
+    __ punpcklwd(reg, reg);
+    __ pshufd(reg, reg, Immediate(0));
+  }
+
+  // Filter whole blocks while the last char of the block's last candidate is in the string.
+  __ Bind(&block_loop);
+  __ movl(temp, limit);
+  __ subl(temp, out);
+  __ cmpl(temp, Immediate(chars_per_block - 1));
+  __ j(kLess, &char_loop);
+  __ movdqu(first_block, Address(string_obj, out, char_scale, value_offset));
+  __ leal(temp, Address(out, target_length, TIMES_1, -1));
+  __ movdqu(last_block, Address(string_obj, temp, char_scale, value_offset));
+  if (char_scale == TIMES_1) {
+    __ pcmpeqb(first_block, first_char);
+    __ pcmpeqb(last_block, last_char);
+  } else {
+    __ pcmpeqw(first_block, first_char);
+    __ pcmpeqw(last_block, last_char);
+  }
+  __ pand(first_block, last_block);
+  __ pmovmskb(mask, first_block);
+  if (char_scale == TIMES_2) {
+    // Keep one bit per char.
+    __ andl(mask, Immediate(0x5555));
+  }
+  __ Bind(&candidate_loop);
+  __ testl(mask, mask);
+  __ j(kEqual, &next_block);
+  __ bsfl(candidate, mask);
+  if (char_scale == TIMES_2) {
+    __ shrl(candidate, Immediate(1));
+  }
+  __ addl(candidate, out);
+  compare_candidate();
+  // Clear the lowest set bit of the mask and try the next candidate.
+  __ leal(temp, Address(mask, -1));
+  __ andl(mask, temp);
+  __ jmp(&candidate_loop);
+  __ Bind(&next_block);
+  __ addl(out, Immediate(chars_per_block));
+  __ jmp(&block_loop);
+
+  // Check the remaining candidates one by one.
+  __ Bind(&char_loop);
+  __ cmpl(out, limit);
+  __ j(kGreater, not_found);
+  LoadStringChar(assembler, temp, Address(string_obj, out, char_scale, value_offset), char_scale);
+  LoadStringChar(assembler, CpuRegister(TMP), Address(target, value_offset), char_scale);
+  __ cmpl(temp, CpuRegister(TMP));
+  __ j(kNotEqual, &char_next);
+  // Unlike in the blocks, the last char has not been compared yet.
+  __ leal(temp, Address(out, target_length, TIMES_1, 0));
+  LoadStringChar(assembler,
+                 temp,
+                 Address(string_obj, temp, char_scale, value_offset - char_size),
+                 char_scale);
+  LoadStringChar(assembler,
+                 CpuRegister(TMP),
+                 Address(target, target_length, char_scale, value_offset - char_size),
+                 char_scale);
+  __ cmpl(temp, CpuRegister(TMP));
+  __ j(kNotEqual, &char_next);
+  __ movl(candidate, out);
+  compare_candidate();
+  __ Bind(&char_next);
+  __ addl(out, Immediate(1));
+  __ jmp(&char_loop);
+
+  __ Bind(&found);
+  __ movl(out, candidate);
+  __ jmp(done);
+}
+
+static void GenerateStringStringIndexOf(HInvoke* invoke,
+                                        CodeGeneratorX86_64* codegen,
+                                        bool start_at_zero) {
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  CpuRegister string_obj = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister target = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister limit = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister target_length = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(5).AsRegister<CpuRegister>();
+
+  // The slow path handles a null target, an empty target, a start index out of the string
+  // and strings with different compression states.
+  SlowPathCode* slow_path = new (codegen->GetScopedAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen->AddSlowPath(slow_path);
+  if (invoke->InputAt(1)->CanBeNull()) {
+    __ testl(target, target);
+    __ j(kEqual, slow_path->GetEntryLabel());
+  }
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  __ movl(limit, Address(string_obj, count_offset));
+  __ movl(target_length, Address(target, count_offset));
+  if (mirror::kUseStringCompression) {
+    __ movl(temp, limit);
+    __ xorl(temp, target_length);
+    __ testl(temp, Immediate(1));
+    __ j(kNotZero, slow_path->GetEntryLabel());
+    // Keep the flagged count of the string to select the char size below.
+    __ movl(temp, limit);
+    __ shrl(limit, Immediate(1));
+    __ shrl(target_length, Immediate(1));
+  }
+  __ testl(target_length, target_length);
+  __ j(kEqual, slow_path->GetEntryLabel());
+
+  if (start_at_zero) {
+    __ xorl(out, out);
+  } else {
+    __ movl(out, locations->InAt(2).AsRegister<CpuRegister>());
+    // An unsigned comparison also sends negative start indexes to the slow path.
+    __ cmpl(out, limit);
+    __ j(kAboveEqual, slow_path->GetEntryLabel());
+  }
+
+  // Compute the last position where the target fits in the string.
+  Label not_found, done;
+  __ subl(limit, target_length);
+  __ cmpl(limit, out);
+  __ j(kLess, &not_found);
+
+  if (mirror::kUseStringCompression) {
+    Label compressed;
+    __ testl(temp, Immediate(1));
+    __ j(kZero, &compressed);
+    GenerateStringStringIndexOfSearch(assembler, locations, TIMES_2, &not_found, &done);
+    __ Bind(&compressed);
+    GenerateStringStringIndexOfSearch(assembler, locations, TIMES_1, &not_found, &done);
+  } else {
+    GenerateStringStringIndexOfSearch(assembler, locations, TIMES_2, &not_found, &done);
+  }
+
+  __ Bind(&not_found);
+  __ movl(out, Immediate(-1));
+  __ Bind(&done);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitStringStringIndexOf(HInvoke* invoke) {
+  CreateStringStringIndexOfLocations(invoke, allocator_, /* start_at_zero= */ true);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringStringIndexOf(HInvoke* invoke) {
+  GenerateStringStringIndexOf(invoke, codegen_, /* start_at_zero= */ true);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitStringStringIndexOfAfter(HInvoke* invoke) {
+  CreateStringStringIndexOfLocations(invoke, allocator_, /* start_at_zero= */ false);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringStringIndexOfAfter(HInvoke* invoke) {
+  GenerateStringStringIndexOf(invoke, codegen_, /* start_at_zero= */ false);
+}
+
 void IntrinsicLocationsBuilderX86_64::VisitStringNewStringFromBytes(HInvoke* invoke) {
   LocationSummary* locations = new (allocator_) LocationSummary(
       invoke, LocationSummary::kCallOnMainAndSlowPath, kIntrinsified);
@@ -3302,6 +3562,344 @@ void IntrinsicLocationsBuilderX86_64::VisitReachabilityFence(HInvoke* invoke) {
 
 void IntrinsicCodeGeneratorX86_64::VisitReachabilityFence(HInvoke* invoke ATTRIBUTE_UNUSED) { }
 
+// CRC-32 (IEEE 802.3, bit-reflected) constants for the carry-less multiplication folding and the
+// Barrett reduction, see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction" by Intel. `kCRC32FoldLow` and `kCRC32FoldHigh` fold the low and high quadwords
+// of a 128-bit remainder over the next 16 bytes, `kCRC32Fold64` folds a 64-bit remainder to 32
+// bits, and `kCRC32Poly` and `kCRC32Mu` are the polynomial P and floor(x^64 / P), bit-reflected.
+static constexpr int64_t kCRC32FoldLow = INT64_C(0x1751997d0);
+static constexpr int64_t kCRC32FoldHigh = INT64_C(0xccaa009e);
+static constexpr int64_t kCRC32Fold64 = INT64_C(0x163cd6124);
+static constexpr int64_t kCRC32Poly = INT64_C(0x1db710641);
+static constexpr int64_t kCRC32Mu = INT64_C(0x1f7011641);
+
+// The PCLMULQDQ instruction is not reflected in the instruction set features, but every CPU
+// supporting AVX2 supports it.
+static bool CanUseCRC32Intrinsics(CodeGeneratorX86_64* codegen) {
+  return codegen->GetInstructionSetFeatures().HasAVX2();
+}
+
+// Loads the Barrett reduction constants into `barrett` and the mask of the low 32 bits of
+// each quadword into `mask`.
+static void LoadCRC32BarrettConstants(CodeGeneratorX86_64* codegen,
+                                      XmmRegister barrett,
+                                      XmmRegister mask,
+                                      XmmRegister temp) {
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  codegen->Load64BitValue(barrett, kCRC32Poly);
+  codegen->Load64BitValue(temp, kCRC32Mu);
+  __ punpcklqdq(barrett, temp);
+  __ pcmpeqd(mask, mask);
+  __ psrlq(mask, Immediate(32));
+}
+
+// Computes the CRC-32 contribution of the 32-bit value held in the low bits of `value` (with
+// the upper bits clear) with a Barrett reduction, leaving the result in the low 32 bits.
+static void GenerateCRC32BarrettReduction(X86_64Assembler* assembler,
+                                          XmmRegister value,
+                                          XmmRegister barrett,
+                                          XmmRegister mask) {
+  __ pclmulqdq(value, barrett, Immediate(0x10));
+  __ pand(value, mask);
+  __ pclmulqdq(value, barrett, Immediate(0x00));
+  __ psrldq(value, Immediate(4));
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32Update(HInvoke* invoke) {
+  if (!CanUseCRC32Intrinsics(codegen_)) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Lower the invoke of CRC32.update(int crc, int b).
+void IntrinsicCodeGeneratorX86_64::VisitCRC32Update(HInvoke* invoke) {
+  DCHECK(CanUseCRC32Intrinsics(codegen_));
+
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister val = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
+  XmmRegister value = locations->GetTemp(1).AsFpuRegister<XmmRegister>();
+  XmmRegister barrett = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+  XmmRegister mask = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+
+  // The algorithm of the CRC32 of a byte is:
+  //   crc = ~crc
+  //   crc = (crc >> 8) ^ table[(crc ^ b) & 0xff]
+  //   crc = ~crc
+  // where the table lookup is replaced by a Barrett reduction of ((crc ^ b) << 24).
+  LoadCRC32BarrettConstants(codegen_, barrett, mask, value);
+  __ movl(out, crc);
+  __ notl(out);
+  __ movl(temp, out);
+  __ xorl(temp, val);
+  __ shll(temp, Immediate(24));
+  __ shrl(out, Immediate(8));
+  __ movd(value, temp, /*is64bit=*/ false);
+  GenerateCRC32BarrettReduction(assembler, value, barrett, mask);
+  __ movd(temp, value, /*is64bit=*/ false);
+  __ xorl(out, temp);
+  __ notl(out);
+}
+
+// Generate code calculating the CRC32 value of bytes using carry-less multiplication.
+//
+// Parameters:
+//   codegen - the code generator
+//   crc     - a register holding an initial CRC value
+//   ptr     - a register holding a memory address of bytes, clobbered
+//   length  - a register holding a number of bytes to process, clobbered
+//   out     - a register to put a result of calculation
+//   temp    - a general purpose temporary register
+//   xmm     - temporary XMM registers
+static void GenerateCodeForCalculationCRC32ValueOfBytes(CodeGeneratorX86_64* codegen,
+                                                        CpuRegister crc,
+                                                        CpuRegister ptr,
+                                                        CpuRegister length,
+                                                        CpuRegister out,
+                                                        CpuRegister temp,
+                                                        const XmmRegister (&xmm)[5]) {
+  // The algorithm of CRC32 of bytes is:
+  //   crc = ~crc
+  //   if array has 16 bytes:
+  //     remainder = 16_bytes(array) ^ crc
+  //     while array has 16 bytes do:
+  //       remainder = fold_16bytes(remainder) ^ 16_bytes(array)
+  //     crc = barrett_reduction(fold_to_64bits(remainder))
+  //   while array has 4 bytes do:
+  //     crc = crc32_of_4bytes(crc, 4_bytes(array))
+  //   while array has a byte do:
+  //     crc = crc32_of_byte(crc, 1_byte(array))
+  //   crc = ~crc
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  XmmRegister acc = xmm[0];
+  XmmRegister xmm_temp = xmm[1];
+  XmmRegister fold = xmm[2];
+  XmmRegister barrett = xmm[3];
+  XmmRegister mask = xmm[4];
+
+  NearLabel fold_loop, fold_done, process_4bytes, loop_4bytes, process_1byte, loop_1byte, done;
+
+  __ movl(out, crc);
+  __ notl(out);
+  LoadCRC32BarrettConstants(codegen, barrett, mask, xmm_temp);
+
+  __ cmpl(length, Immediate(16));
+  __ j(kLess, &process_4bytes);
+  __ movdqu(acc, Address(ptr, 0));
+  __ movd(xmm_temp, out, /*is64bit=*/ false);
+  __ pxor(acc, xmm_temp);
+  __ addq(ptr, Immediate(16));
+  __ subl(length, Immediate(16));
+  codegen->Load64BitValue(fold, kCRC32FoldLow);
+  codegen->Load64BitValue(xmm_temp, kCRC32FoldHigh);
+  __ punpcklqdq(fold, xmm_temp);
+  __ cmpl(length, Immediate(16));
+  __ j(kLess, &fold_done);
+
+  // The main loop folding the 128-bit remainder over the next 16 bytes.
+  __ Bind(&fold_loop);
+  __ movdqa(xmm_temp, acc);
+  __ pclmulqdq(acc, fold, Immediate(0x00));
+  __ pclmulqdq(xmm_temp, fold, Immediate(0x11));
+  __ pxor(acc, xmm_temp);
+  __ movdqu(xmm_temp, Address(ptr, 0));
+  __ pxor(acc, xmm_temp);
+  __ addq(ptr, Immediate(16));
+  __ subl(length, Immediate(16));
+  __ cmpl(length, Immediate(16));
+  __ j(kGreaterEqual, &fold_loop);
+
+  __ Bind(&fold_done);
+  // Fold the 128-bit remainder to 64 bits, appending 32 zero bits.
+  __ movdqa(xmm_temp, acc);
+  __ pclmulqdq(xmm_temp, fold, Immediate(0x10));
+  __ psrldq(acc, Immediate(8));
+  __ pxor(acc, xmm_temp);
+  // Fold the 64-bit remainder to 32 bits.
+  codegen->Load64BitValue(fold, kCRC32Fold64);
+  __ movdqa(xmm_temp, acc);
+  __ pand(xmm_temp, mask);
+  __ psrldq(acc, Immediate(4));
+  __ pclmulqdq(xmm_temp, fold, Immediate(0x00));
+  __ pxor(acc, xmm_temp);
+  // Reduce to the CRC value with the Barrett reduction, found in bits 32-63.
+  __ movdqa(xmm_temp, acc);
+  __ pand(xmm_temp, mask);
+  __ pclmulqdq(xmm_temp, barrett, Immediate(0x10));
+  __ pand(xmm_temp, mask);
+  __ pclmulqdq(xmm_temp, barrett, Immediate(0x00));
+  __ pxor(acc, xmm_temp);
+  __ psrldq(acc, Immediate(4));
+  __ movd(out, acc, /*is64bit=*/ false);
+
+  // Process the remaining data by 4 bytes.
+  __ Bind(&process_4bytes);
+  __ cmpl(length, Immediate(4));
+  __ j(kLess, &process_1byte);
+  __ Bind(&loop_4bytes);
+  __ xorl(out, Address(ptr, 0));
+  __ movd(acc, out, /*is64bit=*/ false);
+  GenerateCRC32BarrettReduction(assembler, acc, barrett, mask);
+  __ movd(out, acc, /*is64bit=*/ false);
+  __ addq(ptr, Immediate(4));
+  __ subl(length, Immediate(4));
+  __ cmpl(length, Immediate(4));
+  __ j(kGreaterEqual, &loop_4bytes);
+
+  // Process the remaining data by a byte.
+  __ Bind(&process_1byte);
+  __ testl(length, length);
+  __ j(kEqual, &done);
+  __ Bind(&loop_1byte);
+  __ movzxb(temp, Address(ptr, 0));
+  __ xorl(temp, out);
+  __ shll(temp, Immediate(24));
+  __ shrl(out, Immediate(8));
+  __ movd(acc, temp, /*is64bit=*/ false);
+  GenerateCRC32BarrettReduction(assembler, acc, barrett, mask);
+  __ movd(temp, acc, /*is64bit=*/ false);
+  __ xorl(out, temp);
+  __ addq(ptr, Immediate(1));
+  __ subl(length, Immediate(1));
+  __ j(kNotEqual, &loop_1byte);
+
+  __ Bind(&done);
+  __ notl(out);
+}
+
+static void AddCRC32ValueOfBytesTemps(LocationSummary* locations) {
+  // The pointer, the remaining length and a temporary.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  for (size_t i = 0; i != 5u; ++i) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+}
+
+static void GenerateCRC32ValueOfBytes(CodeGeneratorX86_64* codegen,
+                                      LocationSummary* locations,
+                                      Location length) {
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister remaining = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+  const XmmRegister xmm[] = {
+      locations->GetTemp(3).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(4).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(5).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(6).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(7).AsFpuRegister<XmmRegister>(),
+  };
+  __ movl(remaining, length.AsRegister<CpuRegister>());
+  GenerateCodeForCalculationCRC32ValueOfBytes(codegen, crc, ptr, remaining, out, temp, xmm);
+}
+
+// The threshold for sizes of arrays to use the library provided implementation
+// of CRC32.updateBytes instead of the intrinsic.
+static constexpr int32_t kCRC32UpdateBytesThreshold = 64 * 1024;
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  if (!CanUseCRC32Intrinsics(codegen_)) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RegisterOrConstant(invoke->InputAt(2)));
+  locations->SetInAt(3, Location::RequiresRegister());
+  AddCRC32ValueOfBytesTemps(locations);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Lower the invoke of CRC32.updateBytes(int crc, byte[] b, int off, int len)
+//
+// Note: The intrinsic is not used if len exceeds a threshold.
+void IntrinsicCodeGeneratorX86_64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  DCHECK(CanUseCRC32Intrinsics(codegen_));
+
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCode* slow_path = new (codegen_->GetScopedAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  CpuRegister length = locations->InAt(3).AsRegister<CpuRegister>();
+  __ cmpl(length, Immediate(kCRC32UpdateBytesThreshold));
+  __ j(kGreater, slow_path->GetEntryLabel());
+
+  const uint32_t array_data_offset =
+      mirror::Array::DataOffset(DataType::Size(DataType::Type::kInt8)).Uint32Value();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister array = locations->InAt(1).AsRegister<CpuRegister>();
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ leaq(ptr, Address(array, array_data_offset + offset_value));
+  } else {
+    __ leaq(ptr, Address(array, offset.AsRegister<CpuRegister>(), TIMES_1, array_data_offset));
+  }
+
+  GenerateCRC32ValueOfBytes(codegen_, locations, locations->InAt(3));
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  if (!CanUseCRC32Intrinsics(codegen_)) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  AddCRC32ValueOfBytesTemps(locations);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Lower the invoke of CRC32.updateByteBuffer(int crc, long addr, int off, int len)
+//
+// There is no need to generate code checking if addr is 0.
+// The method updateByteBuffer is a private method of java.util.zip.CRC32.
+// This guarantees no calls outside of the CRC32 class.
+// An address of DirectBuffer is always passed to the call of updateByteBuffer.
+// It might be an implementation of an empty DirectBuffer which can use a zero
+// address but it must have the length to be zero. The current generated code
+// correctly works with the zero length.
+void IntrinsicCodeGeneratorX86_64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  DCHECK(CanUseCRC32Intrinsics(codegen_));
+
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister addr = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister offset = locations->InAt(2).AsRegister<CpuRegister>();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  __ leaq(ptr, Address(addr, offset, TIMES_1, 0));
+
+  GenerateCRC32ValueOfBytes(codegen_, locations, locations->InAt(3));
+}
+
 static void CreateDivideUnsignedLocations(HInvoke* invoke, ArenaAllocator* allocator) {
   LocationSummary* locations =
       new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
@@ -3421,12 +4019,16 @@ class VarHandleSlowPathX86_64 : public IntrinsicSlowPathX86_64 {
     return &byte_array_view_check_label_;
   }
 
+  Label* GetByteBufferViewCheckLabel() {
+    return &byte_buffer_view_check_label_;
+  }
+
   Label* GetNativeByteOrderLabel() {
     return &native_byte_order_label_;
   }
 
   void EmitNativeCode(CodeGenerator* codegen) override {
-    if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    if (GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked()) {
       EmitByteArrayViewCode(down_cast<CodeGeneratorX86_64*>(codegen));
     }
     IntrinsicSlowPathX86_64::EmitNativeCode(codegen);
@@ -3442,8 +4044,10 @@ class VarHandleSlowPathX86_64 : public IntrinsicSlowPathX86_64 {
   }
 
   void EmitByteArrayViewCode(CodeGeneratorX86_64* codegen);
+  void EmitByteBufferViewChecks(CodeGeneratorX86_64* codegen, Label* byte_order_check);
 
   Label byte_array_view_check_label_;
+  Label byte_buffer_view_check_label_;
   Label native_byte_order_label_;
 
   // Arguments forwarded to specific methods.
@@ -3667,6 +4271,17 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
 
   CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
 
+  // With the exception of `kPrimNot`, `kPrimByte` and `kPrimBoolean`, we shall check
+  // for a byte array view or a ByteBuffer view in the slow path. The checks require
+  // the view VarHandle classes to be in the boot image, so we cannot emit them if
+  // we're JITting without boot image.
+  bool boot_image_available =
+      codegen->GetCompilerOptions().IsBootImage() ||
+      !Runtime::Current()->GetHeap()->GetBootImageSpaces().empty();
+  bool can_be_view = (primitive_type != Primitive::kPrimNot) &&
+                     (DataType::Size(value_type) != 1u) &&
+                     boot_image_available;
+
   // Check that the VarHandle references an array, byte array view or ByteBuffer by checking
   // that coordinateType1 != null. If that's true, coordinateType1 shall be int.class and
   // coordinateType0 shall not be null but we do not explicitly verify that.
@@ -3684,9 +4299,13 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
   // We do this check without read barrier, so there can be false negatives which we
   // defer to the slow path. There shall be no false negatives for array classes in the
   // boot image (including Object[] and primitive arrays) because they are non-movable.
+  //
+  // For a ByteBuffer view, coordinateType0 is ByteBuffer and the object is an instance
+  // of one of its subclasses, so the slow path checks for a heap ByteBuffer first.
   __ movl(temp, Address(object, class_offset.Int32Value()));
   __ cmpl(temp, Address(varhandle, coordinate_type0_offset.Int32Value()));
-  __ j(kNotEqual, slow_path->GetEntryLabel());
+  __ j(kNotEqual,
+       can_be_view ? slow_path->GetByteBufferViewCheckLabel() : slow_path->GetEntryLabel());
 
   // Check that the coordinateType0 is an array type. We do not need a read barrier
   // for loading constant reference fields (or chains of them) for comparison with null,
@@ -3698,21 +4317,8 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
   __ j(kZero, slow_path->GetEntryLabel());
 
   // Check that the array component type matches the primitive type.
-  Label* slow_path_label;
-  if (primitive_type == Primitive::kPrimNot) {
-    slow_path_label = slow_path->GetEntryLabel();
-  } else {
-    // With the exception of `kPrimNot` (handled above), `kPrimByte` and `kPrimBoolean`,
-    // we shall check for a byte array view in the slow path.
-    // The check requires the ByteArrayViewVarHandle.class to be in the boot image,
-    // so we cannot emit that if we're JITting without boot image.
-    bool boot_image_available =
-        codegen->GetCompilerOptions().IsBootImage() ||
-        !Runtime::Current()->GetHeap()->GetBootImageSpaces().empty();
-    bool can_be_view = (DataType::Size(value_type) != 1u) && boot_image_available;
-    slow_path_label =
-        can_be_view ? slow_path->GetByteArrayViewCheckLabel() : slow_path->GetEntryLabel();
-  }
+  Label* slow_path_label =
+      can_be_view ? slow_path->GetByteArrayViewCheckLabel() : slow_path->GetEntryLabel();
   __ cmpw(Address(temp, primitive_type_offset), Immediate(static_cast<uint16_t>(primitive_type)));
   __ j(kNotEqual, slow_path_label);
 
@@ -4950,18 +5556,16 @@ void IntrinsicCodeGeneratorX86_64::VisitVarHandleGetAndBitwiseXorRelease(HInvoke
                                 /*need_any_any_barrier=*/ false);
 }
 
-void VarHandleSlowPathX86_64::EmitByteArrayViewCode(CodeGeneratorX86_64* codegen) {
-  DCHECK(GetByteArrayViewCheckLabel()->IsLinked());
+void VarHandleSlowPathX86_64::EmitByteBufferViewChecks(CodeGeneratorX86_64* codegen,
+                                                       Label* byte_order_check) {
+  DCHECK(GetByteBufferViewCheckLabel()->IsLinked());
   X86_64Assembler* assembler = codegen->GetAssembler();
 
   HInvoke* invoke = GetInvoke();
   LocationSummary* locations = invoke->GetLocations();
-  mirror::VarHandle::AccessModeTemplate access_mode_template = GetAccessModeTemplate();
   DataType::Type value_type =
       GetVarHandleExpectedValueType(invoke, /*expected_coordinates_count=*/ 2u);
-  DCHECK_NE(value_type, DataType::Type::kReference);
   size_t size = DataType::Size(value_type);
-  DCHECK_GT(size, 1u);
 
   CpuRegister varhandle = locations->InAt(0).AsRegister<CpuRegister>();
   CpuRegister object = locations->InAt(1).AsRegister<CpuRegister>();
@@ -4969,40 +5573,155 @@ void VarHandleSlowPathX86_64::EmitByteArrayViewCode(CodeGeneratorX86_64* codegen
   CpuRegister temp = locations->GetTemp(locations->GetTempCount() - 1).AsRegister<CpuRegister>();
 
   MemberOffset class_offset = mirror::Object::ClassOffset();
-  MemberOffset array_length_offset = mirror::Array::LengthOffset();
+  MemberOffset super_class_offset = mirror::Class::SuperClassOffset();
+  MemberOffset coordinate_type0_offset = mirror::VarHandle::CoordinateType0Offset();
   MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
-  MemberOffset native_byte_order_offset = mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
+  MemberOffset address_offset = WellKnownClasses::java_nio_Buffer_address->GetOffset();
+  MemberOffset limit_offset = WellKnownClasses::java_nio_Buffer_limit->GetOffset();
+  MemberOffset hb_offset = WellKnownClasses::java_nio_ByteBuffer_hb->GetOffset();
+  MemberOffset buffer_offset_offset = WellKnownClasses::java_nio_ByteBuffer_offset->GetOffset();
+  MemberOffset is_read_only_offset = WellKnownClasses::java_nio_ByteBuffer_isReadOnly->GetOffset();
 
   VarHandleTarget target = GetVarHandleTarget(invoke);
+  DCHECK_EQ(target.object, object.AsRegister());
 
-  __ Bind(GetByteArrayViewCheckLabel());
+  __ Bind(GetByteBufferViewCheckLabel());
 
-  // The main path checked that the coordinateType0 is an array class that matches
-  // the class of the actual coordinate argument but it does not match the value type.
-  // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
-  codegen->LoadClassRootForIntrinsic(temp, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
+  // The main path found that the class of the actual coordinate argument is not
+  // the coordinateType0. Check if the `varhandle` references a ByteBufferViewVarHandle.
+  codegen->LoadClassRootForIntrinsic(temp, ClassRoot::kJavaLangInvokeByteBufferViewVarHandle);
   assembler->MaybePoisonHeapReference(temp);
   __ cmpl(temp, Address(varhandle, class_offset.Int32Value()));
   __ j(kNotEqual, GetEntryLabel());
 
-  // Check for array index out of bounds.
-  __ movl(temp, Address(object, array_length_offset.Int32Value()));
+  // Check that the object is a direct subclass of the coordinateType0 (ByteBuffer), such as
+  // HeapByteBuffer. As in the main path, this is done without read barriers and there can
+  // be false negatives which we defer to the runtime. Both references are poisoned.
+  __ movl(temp, Address(object, class_offset.Int32Value()));
+  assembler->MaybeUnpoisonHeapReference(temp);
+  __ movl(temp, Address(temp, super_class_offset.Int32Value()));
+  __ cmpl(temp, Address(varhandle, coordinate_type0_offset.Int32Value()));
+  __ j(kNotEqual, GetEntryLabel());
+
+  // Leave buffers backed by native memory to the runtime.
+  __ cmpq(Address(object, address_offset.Int32Value()), Immediate(0));
+  __ j(kNotEqual, GetEntryLabel());
+
+  // The runtime throws ReadOnlyBufferException for any access mode that writes.
+  if (GetAccessModeTemplate() != mirror::VarHandle::AccessModeTemplate::kGet) {
+    __ cmpb(Address(object, is_read_only_offset.Int32Value()), Immediate(0));
+    __ j(kNotEqual, GetEntryLabel());
+  }
+
+  // Check for index out of bounds. The index is relative to the buffer offset and
+  // the access must fit below the buffer limit.
+  __ movl(temp, Address(object, limit_offset.Int32Value()));
   // SUB sets flags in the same way as CMP.
   __ subl(temp, index);
   __ j(kBelowEqual, GetEntryLabel());
-  // The difference between index and array length must be enough for the `value_type` size.
   __ cmpl(temp, Immediate(size));
   __ j(kBelow, GetEntryLabel());
 
-  // Construct the target.
-  __ leal(CpuRegister(target.offset), Address(index, TIMES_1, data_offset.Int32Value()));
+  // Load the backing array. We are going to access its data, so we need the to-space
+  // reference. We cannot add a read barrier slow path while emitting slow paths, so
+  // call the marking entrypoint directly when the GC is marking.
+  __ movl(temp, Address(object, hb_offset.Int32Value()));
+  assembler->MaybeUnpoisonHeapReference(temp);
+  if (gUseReadBarrier) {
+    DCHECK(kUseBakerReadBarrier);
+    int32_t entry_point_offset =
+        Thread::ReadBarrierMarkEntryPointsOffset<kX86_64PointerSize>(temp.AsRegister());
+    NearLabel is_not_marking;
+    __ gs()->cmpl(Address::Absolute(entry_point_offset, /* no_rip= */ true), Immediate(0));
+    __ j(kEqual, &is_not_marking);
+    // This runtime call does not require a stack map.
+    codegen->InvokeRuntimeWithoutRecordingPcInfo(entry_point_offset, invoke, this);
+    __ Bind(&is_not_marking);
+  }
+  __ testl(temp, temp);
+  __ j(kZero, GetEntryLabel());
 
-  // Alignment check. For unaligned access, go to the runtime.
+  // Compute the offset of the value in the backing array and check its alignment.
+  // The array data is at least 8-byte aligned in memory, less the `data_offset`.
+  __ movl(CpuRegister(TMP), Address(object, buffer_offset_offset.Int32Value()));
+  __ leal(CpuRegister(TMP), Address(CpuRegister(TMP), index, TIMES_1, data_offset.Int32Value()));
   DCHECK(IsPowerOfTwo(size));
-  __ testl(CpuRegister(target.offset), Immediate(size - 1u));
+  __ testl(CpuRegister(TMP), Immediate(size - 1u));
   __ j(kNotZero, GetEntryLabel());
 
+  // The target object register holds the ByteBuffer and it must be preserved for the
+  // runtime call, so express the address of the value relative to the ByteBuffer.
+  // No safepoint can move either object before the access.
+  __ leaq(CpuRegister(target.offset), Address(temp, CpuRegister(TMP), TIMES_1, 0));
+  __ subq(CpuRegister(target.offset), object);
+
+  __ jmp(byte_order_check);
+}
+
+void VarHandleSlowPathX86_64::EmitByteArrayViewCode(CodeGeneratorX86_64* codegen) {
+  DCHECK(GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked());
+  X86_64Assembler* assembler = codegen->GetAssembler();
+
+  HInvoke* invoke = GetInvoke();
+  LocationSummary* locations = invoke->GetLocations();
+  mirror::VarHandle::AccessModeTemplate access_mode_template = GetAccessModeTemplate();
+  DataType::Type value_type =
+      GetVarHandleExpectedValueType(invoke, /*expected_coordinates_count=*/ 2u);
+  DCHECK_NE(value_type, DataType::Type::kReference);
+  size_t size = DataType::Size(value_type);
+  DCHECK_GT(size, 1u);
+
+  CpuRegister varhandle = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister object = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister index = locations->InAt(2).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(locations->GetTempCount() - 1).AsRegister<CpuRegister>();
+
+  MemberOffset class_offset = mirror::Object::ClassOffset();
+  MemberOffset array_length_offset = mirror::Array::LengthOffset();
+  MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
+  MemberOffset native_byte_order_offset = mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
+
+  VarHandleTarget target = GetVarHandleTarget(invoke);
+
+  // Both view VarHandle classes keep the byte order in the same field.
+  DCHECK_EQ(native_byte_order_offset.Uint32Value(),
+            mirror::ByteBufferViewVarHandle::NativeByteOrderOffset().Uint32Value());
+  Label byte_order_check;
+  if (GetByteBufferViewCheckLabel()->IsLinked()) {
+    EmitByteBufferViewChecks(codegen, &byte_order_check);
+  }
+
+  if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    __ Bind(GetByteArrayViewCheckLabel());
+
+    // The main path checked that the coordinateType0 is an array class that matches
+    // the class of the actual coordinate argument but it does not match the value type.
+    // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
+    codegen->LoadClassRootForIntrinsic(temp, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
+    assembler->MaybePoisonHeapReference(temp);
+    __ cmpl(temp, Address(varhandle, class_offset.Int32Value()));
+    __ j(kNotEqual, GetEntryLabel());
+
+    // Check for array index out of bounds.
+    __ movl(temp, Address(object, array_length_offset.Int32Value()));
+    // SUB sets flags in the same way as CMP.
+    __ subl(temp, index);
+    __ j(kBelowEqual, GetEntryLabel());
+    // The difference between index and array length must be enough for the `value_type` size.
+    __ cmpl(temp, Immediate(size));
+    __ j(kBelow, GetEntryLabel());
+
+    // Construct the target.
+    __ leal(CpuRegister(target.offset), Address(index, TIMES_1, data_offset.Int32Value()));
+
+    // Alignment check. For unaligned access, go to the runtime.
+    DCHECK(IsPowerOfTwo(size));
+    __ testl(CpuRegister(target.offset), Immediate(size - 1u));
+    __ j(kNotZero, GetEntryLabel());
+  }
+
   // Byte order check. For native byte order return to the main path.
+  __ Bind(&byte_order_check);
   if (access_mode_template == mirror::VarHandle::AccessModeTemplate::kSet &&
       IsZeroBitPattern(invoke->InputAt(invoke->GetNumberOfArguments() - 1u))) {
     // There is no reason to differentiate between native byte order and byte-swap
@@ -5041,6 +5760,143 @@ void VarHandleSlowPathX86_64::EmitByteArrayViewCode(CodeGeneratorX86_64* codegen
   __ jmp(GetExitLabel());
 }
 
+static void CreateMethodHandleInvokeLocations(HInvoke* invoke, ArenaAllocator* allocator) {
+  if (!invoke->AsInvokePolymorphic()->HasCallSiteMethodType()) {
+    // The call site is not specialized, use the generic invoke-polymorphic call.
+    return;
+  }
+
+  LocationSummary* locations = new (allocator) LocationSummary(
+      invoke, LocationSummary::kCallOnMainAndSlowPath, kIntrinsified);
+  InvokeDexCallingConventionVisitorX86_64 calling_convention;
+  size_t number_of_arguments = invoke->GetNumberOfArguments();
+  for (size_t i = 0; i != number_of_arguments; ++i) {
+    locations->SetInAt(i, calling_convention.GetNextLocation(invoke->InputAt(i)->GetType()));
+  }
+  // The call site MethodType.
+  locations->SetInAt(number_of_arguments, Location::RequiresRegister());
+  locations->SetOut(calling_convention.GetReturnLocation(invoke->GetType()));
+  // The target method is passed in the method register.
+  locations->AddTemp(calling_convention.GetMethodLocation());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+// Calls the target of a MethodHandle directly when its kind is invoke-static, invoke-direct
+// or invoke-virtual and its type is the call site MethodType. Anything else, including
+// asType() conversions needed by MethodHandle.invoke(), goes to the runtime.
+static void GenerateMethodHandleInvoke(HInvoke* invoke, CodeGeneratorX86_64* codegen) {
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+  size_t number_of_arguments = invoke->GetNumberOfArguments();
+
+  // The arguments are in the locations expected by the slow path until the call.
+  SlowPathCode* slow_path = new (codegen->GetScopedAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen->AddSlowPath(slow_path);
+
+  // Note that the null check of the MethodHandle must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+  CpuRegister method_handle = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister call_site_type = locations->InAt(number_of_arguments).AsRegister<CpuRegister>();
+  CpuRegister method = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(1).AsRegister<CpuRegister>();
+
+  // The call site type must be the MethodHandle type. A MethodType equal to but distinct
+  // from the call site one, or a from-space reference, just takes the slow path.
+  __ movl(temp, call_site_type);
+  __ MaybePoisonHeapReference(temp);
+  __ cmpl(temp, Address(method_handle, mirror::MethodHandle::MethodTypeOffset()));
+  __ j(kNotEqual, slow_path->GetEntryLabel());
+
+  Label call_target;
+  Address handle_kind(method_handle, mirror::MethodHandle::HandleKindOffset());
+  __ movq(method, Address(method_handle, mirror::MethodHandle::ArtFieldOrMethodOffset()));
+  __ cmpl(handle_kind, Immediate(mirror::MethodHandle::Kind::kInvokeStatic));
+  __ j(kEqual, &call_target);
+
+  if (number_of_arguments > 1u && invoke->InputAt(1)->GetType() == DataType::Type::kReference) {
+    Label virtual_dispatch;
+    CpuRegister receiver = locations->InAt(1).AsRegister<CpuRegister>();
+    const uint32_t class_offset = mirror::Object::ClassOffset().Uint32Value();
+    const uint32_t access_flags_offset = ArtMethod::AccessFlagsOffset().Uint32Value();
+
+    // Let the runtime throw the NullPointerException.
+    __ testl(receiver, receiver);
+    __ j(kEqual, slow_path->GetEntryLabel());
+
+    __ cmpl(handle_kind, Immediate(mirror::MethodHandle::Kind::kInvokeDirect));
+    __ j(kNotEqual, &virtual_dispatch);
+    // String constructors are replaced with StringFactory methods by the runtime.
+    __ testl(Address(method, access_flags_offset), Immediate(kAccConstructor));
+    __ j(kNotZero, slow_path->GetEntryLabel());
+    __ jmp(&call_target);
+
+    __ Bind(&virtual_dispatch);
+    __ cmpl(handle_kind, Immediate(mirror::MethodHandle::Kind::kInvokeVirtual));
+    __ j(kNotEqual, slow_path->GetEntryLabel());
+    // No dispatch is needed if the receiver is an instance of the declaring class.
+    // /* GcRoot<Class> */ temp = method->declaring_class_
+    __ movl(temp, Address(method, ArtMethod::DeclaringClassOffset()));
+    __ MaybePoisonHeapReference(temp);
+    __ cmpl(temp, Address(receiver, class_offset));
+    __ j(kEqual, &call_target);
+    // Leave private methods, which are not in the vtable, and methods declared in interfaces
+    // to the runtime.
+    __ testl(Address(method, access_flags_offset), Immediate(kAccPrivate));
+    __ j(kNotZero, slow_path->GetEntryLabel());
+    __ MaybeUnpoisonHeapReference(temp);
+    __ testl(Address(temp, mirror::Class::AccessFlagsOffset()), Immediate(kAccInterface));
+    __ j(kNotZero, slow_path->GetEntryLabel());
+    __ movzxw(temp, Address(method, ArtMethod::MethodIndexOffset()));
+    // As in virtual calls, the class reference needs no read barrier as we only load
+    // the vtable entry from it.
+    // /* HeapReference<Class> */ method = receiver->klass_
+    __ movl(method, Address(receiver, class_offset));
+    __ MaybeUnpoisonHeapReference(method);
+    __ movq(method, Address(method,
+                            temp,
+                            TIMES_8,
+                            mirror::Class::EmbeddedVTableOffset(kX86_64PointerSize).Int32Value()));
+  } else {
+    __ jmp(slow_path->GetEntryLabel());
+  }
+
+  __ Bind(&call_target);
+  // Drop the MethodHandle from the arguments: the core arguments move down by one register
+  // and the floating-point ones stay where they are.
+  size_t core_register_index = 0u;
+  for (size_t i = 1; i != number_of_arguments; ++i) {
+    if (!DataType::IsFloatingPointType(invoke->InputAt(i)->GetType())) {
+      __ movq(CpuRegister(kParameterCoreRegisters[core_register_index]),
+              CpuRegister(kParameterCoreRegisters[core_register_index + 1u]));
+      ++core_register_index;
+    }
+  }
+  // call method->GetEntryPoint();
+  __ call(Address(method, ArtMethod::EntryPointFromQuickCompiledCodeOffset(
+      kX86_64PointerSize).SizeValue()));
+  codegen->RecordPcInfo(invoke, invoke->GetDexPc());
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitMethodHandleInvokeExact(HInvoke* invoke) {
+  CreateMethodHandleInvokeLocations(invoke, allocator_);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitMethodHandleInvokeExact(HInvoke* invoke) {
+  GenerateMethodHandleInvoke(invoke, codegen_);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitMethodHandleInvoke(HInvoke* invoke) {
+  CreateMethodHandleInvokeLocations(invoke, allocator_);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitMethodHandleInvoke(HInvoke* invoke) {
+  // MethodHandle.invoke() behaves as MethodHandle.invokeExact() when the MethodHandle type
+  // is the call site type, which is the only case handled without the runtime.
+  GenerateMethodHandleInvoke(invoke, codegen_);
+}
+
 #define MARK_UNIMPLEMENTED(Name) UNIMPLEMENTED_INTRINSIC(X86_64, Name)
 UNIMPLEMENTED_INTRINSIC_LIST_X86_64(MARK_UNIMPLEMENTED);
 #undef MARK_UNIMPLEMENTED
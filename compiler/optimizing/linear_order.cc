@@ -54,6 +54,49 @@ static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
   worklist->insert(insert_pos.base(), block);
 }
 
+// Returns whether the branch profile shows that `successor` was never reached from `block`
+// while the other successor was. Profiles are only collected for HIf instructions.
+static bool IsNeverTakenEdge(HBasicBlock* block, HBasicBlock* successor) {
+  HIf* if_instr = block->GetLastInstruction()->AsIf();
+  if (if_instr == nullptr || if_instr->IfTrueSuccessor() == if_instr->IfFalseSuccessor()) {
+    return false;
+  }
+  uint16_t true_count = if_instr->GetTrueCount();
+  uint16_t false_count = if_instr->GetFalseCount();
+  if (true_count == std::numeric_limits<uint16_t>::max() &&
+      false_count == std::numeric_limits<uint16_t>::max()) {
+    // No profile for this branch.
+    return false;
+  }
+  return (successor == if_instr->IfTrueSuccessor())
+      ? (true_count == 0u && false_count != 0u)
+      : (false_count == 0u && true_count != 0u);
+}
+
+// Helper method to find the blocks that are unlikely to execute: catch blocks, blocks
+// ending in a throw, blocks only reached through never taken branches, and blocks
+// whose forward predecessors are all cold.
+static void ComputeColdBlocks(const HGraph* graph, ScopedArenaVector<bool>* is_cold) {
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->IsEntryBlock()) {
+      continue;
+    }
+    bool cold = true;
+    if (!block->IsCatchBlock() && !block->GetLastInstruction()->IsThrow()) {
+      for (HBasicBlock* predecessor : block->GetPredecessors()) {
+        if (block->IsLoopHeader() && block->GetLoopInformation()->IsBackEdge(*predecessor)) {
+          continue;
+        }
+        if (!(*is_cold)[predecessor->GetBlockId()] && !IsNeverTakenEdge(predecessor, block)) {
+          cold = false;
+          break;
+        }
+      }
+    }
+    (*is_cold)[block->GetBlockId()] = cold;
+  }
+}
+
 // Helper method to validate linear order.
 static bool IsLinearOrderWellFormed(const HGraph* graph, ArrayRef<HBasicBlock*> linear_order) {
   for (HBasicBlock* header : graph->GetBlocks()) {
@@ -87,7 +130,9 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   DCHECK_EQ(linear_order.size(), graph->GetReversePostOrder().size());
   // Create a reverse post ordering with the following properties:
   // - Blocks in a loop are consecutive,
-  // - Back-edge is the last block before loop exits.
+  // - Back-edge is the last block before loop exits,
+  // - Cold blocks outside of loops are placed after all other blocks, to keep them
+  //   out of the instruction cache lines and pages of the hot code.
   //
   // (1): Record the number of forward predecessors for each block. This is to
   //      ensure the resulting order is reverse post order. We could use the
@@ -104,11 +149,22 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
     }
     forward_predecessors[block->GetBlockId()] = number_of_forward_predecessors;
   }
-  // (2): Following a worklist approach, first start with the entry block, and
+  // (2): Find the cold blocks. We do not move blocks out of irreducible loops, as
+  //      they are not recorded as loop blocks.
+  ScopedArenaVector<bool> is_cold(graph->GetBlocks().size(),
+                                  false,
+                                  allocator.Adapter(kArenaAllocLinearOrder));
+  if (!graph->HasIrreducibleLoops()) {
+    ComputeColdBlocks(graph, &is_cold);
+  }
+  // (3): Following a worklist approach, first start with the entry block, and
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  //      Cold blocks outside of loops are deferred until the worklist is empty; at that
+  //      point no loop is partially linearized, so they can be appended safely.
   ScopedArenaVector<HBasicBlock*> worklist(allocator.Adapter(kArenaAllocLinearOrder));
+  ScopedArenaVector<HBasicBlock*> cold_worklist(allocator.Adapter(kArenaAllocLinearOrder));
   worklist.push_back(graph->GetEntryBlock());
   size_t num_added = 0u;
   do {
@@ -120,10 +176,18 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
-        AddToListForLinearization(&worklist, successor);
+        if (is_cold[block_id] && !IsLoop(successor->GetLoopInformation())) {
+          cold_worklist.push_back(successor);
+        } else {
+          AddToListForLinearization(&worklist, successor);
+        }
       }
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
+    if (worklist.empty() && !cold_worklist.empty()) {
+      worklist.push_back(cold_worklist.back());
+      cold_worklist.pop_back();
+    }
   } while (!worklist.empty());
   DCHECK_EQ(num_added, linear_order.size());
 
@@ -15,6 +15,7 @@
  */
 
 #include <fstream>
+#include <limits>
 
 #include "base/arena_allocator.h"
 #include "base/macros.h"
@@ -245,4 +246,56 @@ TEST_F(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+TEST_F(LinearizeTest, ProfiledColdBranch) {
+  // Structure of this graph
+  //                 Block0
+  //                   |
+  //                 Block1
+  //          (true) /    \ (false)
+  //           Return      Return
+  //                 \    /
+  //                  Exit
+  const std::vector<uint16_t> data = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::RETURN_VOID,
+    Instruction::RETURN_VOID);
+
+  std::unique_ptr<CompilerOptions> compiler_options =
+      CommonCompilerTest::CreateCompilerOptions(kRuntimeISA, "default");
+  // Returns whether the true successor of the graph's only HIf is laid out first.
+  auto true_successor_first = [&](uint16_t true_count, uint16_t false_count) {
+    HGraph* graph = CreateCFG(data);
+    HIf* if_instr = nullptr;
+    for (HBasicBlock* block : graph->GetReversePostOrder()) {
+      if (block->GetLastInstruction()->IsIf()) {
+        if_instr = block->GetLastInstruction()->AsIf();
+      }
+    }
+    EXPECT_TRUE(if_instr != nullptr);
+    if_instr->SetTrueCount(true_count);
+    if_instr->SetFalseCount(false_count);
+    std::unique_ptr<CodeGenerator> codegen = CodeGenerator::Create(graph, *compiler_options);
+    SsaLivenessAnalysis liveness(graph, codegen.get(), GetScopedAllocator());
+    liveness.Analyze();
+    for (HBasicBlock* block : graph->GetLinearOrder()) {
+      if (block == if_instr->IfTrueSuccessor()) {
+        return true;
+      } else if (block == if_instr->IfFalseSuccessor()) {
+        return false;
+      }
+    }
+    LOG(FATAL) << "Successors not found in the linear order";
+    UNREACHABLE();
+  };
+
+  // Without a profile, the false successor comes first.
+  constexpr uint16_t kNoProfile = std::numeric_limits<uint16_t>::max();
+  EXPECT_FALSE(true_successor_first(kNoProfile, kNoProfile));
+  // The never taken false successor is moved after the true successor.
+  EXPECT_TRUE(true_successor_first(10u, 0u));
+  // A branch taken both ways keeps the default order.
+  EXPECT_FALSE(true_successor_first(10u, 1u));
+}
+
 }  // namespace art
@@ -4914,6 +4914,7 @@ class HInvokePolymorphic final : public HInvoke {
  public:
   HInvokePolymorphic(ArenaAllocator* allocator,
                      uint32_t number_of_arguments,
+                     uint32_t number_of_other_inputs,
                      DataType::Type return_type,
                      uint32_t dex_pc,
                      MethodReference method_reference,
@@ -4926,7 +4927,7 @@ class HInvokePolymorphic final : public HInvoke {
       : HInvoke(kInvokePolymorphic,
                 allocator,
                 number_of_arguments,
-                /* number_of_other_inputs= */ 0u,
+                number_of_other_inputs,
                 return_type,
                 dex_pc,
                 method_reference,
@@ -4940,6 +4941,10 @@ class HInvokePolymorphic final : public HInvoke {
 
   dex::ProtoIndex GetProtoIndex() { return proto_idx_; }
 
+  // Whether the call site MethodType is passed as the last input, see
+  // CodeGenerator::CanSpecializeMethodHandleInvoke().
+  bool HasCallSiteMethodType() const { return InputCount() != GetNumberOfArguments(); }
+
   DECLARE_INSTRUCTION(InvokePolymorphic);
 
  protected:
@@ -31,6 +31,7 @@
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "base/scoped_arena_allocator.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "builder.h"
 #include "code_generator.h"
@@ -54,6 +55,7 @@
 #include "oat_quick_method_header.h"
 #include "optimizing/write_barrier_elimination.h"
 #include "prepare_for_register_allocation.h"
+#include "profile/profile_compilation_info.h"
 #include "profiling_info_builder.h"
 #include "reference_type_propagation.h"
 #include "register_allocator_linear_scan.h"
@@ -100,17 +102,53 @@ static constexpr const char kStringFilter[] = "";
 
 class PassScope;
 
+// Machine-readable report of the time and arena memory used by each pass of each compiled
+// method, in CSV format. Written with --dump-compilation-report and summarized by
+// tools/compilation-report.py.
+class CompilationReport {
+ public:
+  explicit CompilationReport(const std::string& file_name)
+      : lock_("compilation report lock", kGenericBottomLock),
+        output_(file_name) {
+    output_ << "method,pass,time_ns,arena_bytes,arena_stack_peak_bytes\n";
+  }
+
+  bool IsOpen() REQUIRES(!lock_) {
+    MutexLock mu(Thread::Current(), lock_);
+    return output_.is_open();
+  }
+
+  // Append the rows of one method. Rows of a method are never interleaved with rows of
+  // methods compiled concurrently.
+  void Write(const std::string& rows) REQUIRES(!lock_) {
+    MutexLock mu(Thread::Current(), lock_);
+    output_ << rows;
+    output_.flush();
+  }
+
+ private:
+  Mutex lock_;
+  std::ofstream output_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationReport);
+};
+
 class PassObserver : public ValueObject {
  public:
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
+               CompilationReport* compilation_report,
                const CompilerOptions& compiler_options)
       : graph_(graph),
         last_seen_graph_size_(0),
         cached_method_name_(),
         timing_logger_enabled_(compiler_options.GetDumpPassTimings()),
         timing_logger_(timing_logger_enabled_ ? GetMethodName() : "", true, true),
+        compilation_report_(compilation_report),
+        compilation_start_ns_(compilation_report != nullptr ? NanoTime() : 0u),
+        pass_start_ns_(0u),
+        report_oss_(),
         disasm_info_(graph->GetAllocator()),
         visualizer_oss_(),
         visualizer_output_(visualizer_output),
@@ -134,6 +172,11 @@ class PassObserver : public ValueObject {
       LOG(INFO) << "TIMINGS " << GetMethodName();
       LOG(INFO) << Dumpable<TimingLogger>(timing_logger_);
     }
+    if (compilation_report_ != nullptr) {
+      // The last row covers the whole compilation, including code generation.
+      AddReportRow("total", NanoTime() - compilation_start_ns_);
+      compilation_report_->Write(report_oss_.str());
+    }
     if (visualizer_enabled_) {
       FlushVisualizer();
     }
@@ -168,6 +211,16 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (compilation_report_ != nullptr) {
+      pass_start_ns_ = NanoTime();
+    }
+  }
+
+  // Method names contain commas, so we quote them. They never contain quotes.
+  void AddReportRow(const char* pass_name, uint64_t time_ns) {
+    report_oss_ << '"' << GetMethodName() << "\"," << pass_name << ',' << time_ns << ','
+                << graph_->GetAllocator()->BytesUsed() << ','
+                << graph_->GetArenaStack()->ApproximatePeakBytes() << '\n';
   }
 
   void FlushVisualizer() {
@@ -182,6 +235,9 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
+    if (compilation_report_ != nullptr) {
+      AddReportRow(pass_name, NanoTime() - pass_start_ns_);
+    }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass= */ true, graph_in_bad_state_);
       FlushVisualizer();
@@ -228,6 +284,11 @@ class PassObserver : public ValueObject {
   bool timing_logger_enabled_;
   TimingLogger timing_logger_;
 
+  CompilationReport* const compilation_report_;
+  const uint64_t compilation_start_ns_;
+  uint64_t pass_start_ns_;
+  std::ostringstream report_oss_;
+
   DisassemblyInformation disasm_info_;
 
   std::ostringstream visualizer_oss_;
@@ -409,6 +470,8 @@ class OptimizingCompiler final : public Compiler {
 
   std::unique_ptr<std::ostream> visualizer_output_;
 
+  std::unique_ptr<CompilationReport> compilation_report_;
+
   DISALLOW_COPY_AND_ASSIGN(OptimizingCompiler);
 };
 
@@ -428,6 +491,14 @@ OptimizingCompiler::OptimizingCompiler(const CompilerOptions& compiler_options,
   if (compiler_options.GetDumpStats()) {
     compilation_stats_.reset(new OptimizingCompilerStats());
   }
+  const std::string& report_file_name = compiler_options.GetDumpCompilationReportFileName();
+  if (!report_file_name.empty()) {
+    compilation_report_.reset(new CompilationReport(report_file_name));
+    if (!compilation_report_->IsOpen()) {
+      PLOG(ERROR) << "Failed to open compilation report file " << report_file_name;
+      compilation_report_.reset();
+    }
+  }
 }
 
 OptimizingCompiler::~OptimizingCompiler() {
@@ -560,6 +631,9 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
         OptDef(OptimizationPass::kInstructionSimplifierX86_64),
         OptDef(OptimizationPass::kSideEffectsAnalysis),
         OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
+        // Schedule before the memory operand generation, which relies on an
+        // emitted-at-use-site HArrayLength staying right before its HBoundsCheck.
+        OptDef(OptimizationPass::kScheduling),
         OptDef(OptimizationPass::kX86MemoryOperandGeneration)
       };
       return RunOptimizations(graph,
@@ -577,6 +651,34 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
   }
 }
 
+// Resolve the tiered register allocation strategy for the method being compiled. Graph
+// coloring spends more compile time than linear scan to avoid spills, so we only use it
+// for code that is known to be hot.
+static RegisterAllocator::Strategy GetRegisterAllocationStrategy(
+    const CompilerOptions& compiler_options,
+    const DexCompilationUnit& dex_compilation_unit,
+    CompilationKind compilation_kind) {
+  RegisterAllocator::Strategy strategy = compiler_options.GetRegisterAllocationStrategy();
+  if (strategy != RegisterAllocator::kRegisterAllocatorTiered) {
+    return strategy;
+  }
+  if (compiler_options.IsJitCompiler()) {
+    // Baseline code is short lived, optimized and OSR code is what hot methods end up running.
+    return (compilation_kind == CompilationKind::kBaseline)
+        ? RegisterAllocator::kRegisterAllocatorLinearScan
+        : RegisterAllocator::kRegisterAllocatorGraphColor;
+  }
+  const ProfileCompilationInfo* pci = compiler_options.GetProfileCompilationInfo();
+  if (pci != nullptr) {
+    ProfileCompilationInfo::MethodHotness hotness = pci->GetMethodHotness(MethodReference(
+        dex_compilation_unit.GetDexFile(), dex_compilation_unit.GetDexMethodIndex()));
+    if (hotness.IsHot()) {
+      return RegisterAllocator::kRegisterAllocatorGraphColor;
+    }
+  }
+  return RegisterAllocator::kRegisterAllocatorLinearScan;
+}
+
 NO_INLINE  // Avoid increasing caller's frame size by large stack-allocated objects.
 static void AllocateRegisters(HGraph* graph,
                               CodeGenerator* codegen,
@@ -601,6 +703,12 @@ static void AllocateRegisters(HGraph* graph,
     std::unique_ptr<RegisterAllocator> register_allocator =
         RegisterAllocator::Create(&local_allocator, codegen, liveness, strategy);
     register_allocator->AllocateRegisters();
+    if (strategy == RegisterAllocator::kRegisterAllocatorGraphColor) {
+      MaybeRecordStat(stats, MethodCompilationStat::kGraphColorRegisterAllocation);
+    }
+    MaybeRecordStat(stats,
+                    MethodCompilationStat::kSpillSlotsAllocated,
+                    register_allocator->GetNumberOfSpillSlots());
   }
 }
 
@@ -846,6 +954,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             compilation_report_.get(),
                              compiler_options);
 
   {
@@ -925,7 +1034,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   }
 
   RegisterAllocator::Strategy regalloc_strategy =
-    compiler_options.GetRegisterAllocationStrategy();
+      GetRegisterAllocationStrategy(compiler_options, dex_compilation_unit, compilation_kind);
   AllocateRegisters(graph,
                     codegen.get(),
                     &pass_observer,
@@ -993,6 +1102,7 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             compilation_report_.get(),
                              compiler_options);
 
   {
@@ -1024,10 +1134,15 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
     WriteBarrierElimination(graph, compilation_stats_.get()).Run();
   }
 
+  // Intrinsic graphs are tiny, there is nothing for graph coloring to improve.
+  RegisterAllocator::Strategy regalloc_strategy = compiler_options.GetRegisterAllocationStrategy();
+  if (regalloc_strategy == RegisterAllocator::kRegisterAllocatorTiered) {
+    regalloc_strategy = RegisterAllocator::kRegisterAllocatorLinearScan;
+  }
   AllocateRegisters(graph,
                     codegen.get(),
                     &pass_observer,
-                    compiler_options.GetRegisterAllocationStrategy(),
+                    regalloc_strategy,
                     compilation_stats_.get());
   if (!codegen->IsLeafMethod()) {
     VLOG(compiler) << "Intrinsic method is not leaf: " << method->GetIntrinsic()
@@ -40,7 +40,11 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
  public:
   enum Strategy {
     kRegisterAllocatorLinearScan,
-    kRegisterAllocatorGraphColor
+    kRegisterAllocatorGraphColor,
+    // Graph coloring for code that is known to be hot (optimized JIT compilations and
+    // methods marked hot in the AOT profile), linear scan otherwise. The compiler resolves
+    // it to one of the above for each method before calling `Create()`.
+    kRegisterAllocatorTiered
   };
 
   static constexpr Strategy kRegisterAllocatorDefault = kRegisterAllocatorLinearScan;
@@ -60,6 +64,10 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
   // intervals that intersect each other. Returns false if it failed.
   virtual bool Validate(bool log_fatal_on_failure) = 0;
 
+  // Returns the number of stack slots allocated for spilled values. Only valid
+  // after `AllocateRegisters()`.
+  virtual size_t GetNumberOfSpillSlots() const = 0;
+
   // Verifies that live intervals do not conflict. Used by unit testing.
   static bool ValidateIntervals(ArrayRef<LiveInterval* const> intervals,
                                 size_t number_of_spill_slots,
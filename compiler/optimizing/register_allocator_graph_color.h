@@ -96,6 +96,14 @@ class RegisterAllocatorGraphColor : public RegisterAllocator {
 
   bool Validate(bool log_fatal_on_failure) override;
 
+  size_t GetNumberOfSpillSlots() const override {
+    return num_int_spill_slots_
+        + num_long_spill_slots_
+        + num_float_spill_slots_
+        + num_double_spill_slots_
+        + catch_phi_spill_slot_counter_;
+  }
+
  private:
   // Collect all intervals and prepare for register allocation.
   void ProcessInstructions();
@@ -32,6 +32,10 @@ std::ostream& operator<<(std::ostream& os, const XmmRegister& reg) {
   return os << reg.AsFloatRegister();
 }
 
+std::ostream& operator<<(std::ostream& os, const YmmRegister& reg) {
+  return os << "ymm" << static_cast<int>(reg.AsFloatRegister());
+}
+
 std::ostream& operator<<(std::ostream& os, const X87Register& reg) {
   return os << "ST" << static_cast<int>(reg);
 }
@@ -3509,6 +3513,15 @@ void X86_64Assembler::pcmpgtq(XmmRegister dst, XmmRegister src) {
   EmitXmmRegisterOperand(dst.LowBits(), src);
 }
 
+void X86_64Assembler::pmovmskb(CpuRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0xD7);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
 void X86_64Assembler::shufpd(XmmRegister dst, XmmRegister src, const Immediate& imm) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -3541,6 +3554,18 @@ void X86_64Assembler::pshufd(XmmRegister dst, XmmRegister src, const Immediate&
 }
 
 
+void X86_64Assembler::pclmulqdq(XmmRegister dst, XmmRegister src, const Immediate& imm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x3A);
+  EmitUint8(0x44);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+  EmitUint8(imm.value());
+}
+
+
 void X86_64Assembler::punpcklbw(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -3729,6 +3754,543 @@ void X86_64Assembler::psrldq(XmmRegister reg, const Immediate& shift_count) {
 }
 
 
+void X86_64Assembler::vmovaps(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  X86_64ManagedRegister no_vvvv = ManagedRegister::NoRegister().AsX86_64();
+  if (src.NeedsRex() && !dst.NeedsRex()) {
+    // Use the store form, which keeps the short VEX prefix.
+    EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x29, src.AsFloatRegister(), no_vvvv,
+               Operand(CpuRegister(dst.AsFloatRegister())));
+  } else {
+    EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x28, dst.AsFloatRegister(), no_vvvv,
+               Operand(CpuRegister(src.AsFloatRegister())));
+  }
+}
+
+void X86_64Assembler::vmovups(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x10, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), src);
+}
+
+void X86_64Assembler::vmovups(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x11, src.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), dst);
+}
+
+void X86_64Assembler::vmovupd(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x10, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), src);
+}
+
+void X86_64Assembler::vmovupd(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x11, src.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), dst);
+}
+
+void X86_64Assembler::vmovdqu(YmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_F3, 0x6F, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), src);
+}
+
+void X86_64Assembler::vmovdqu(const Address& dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_F3, 0x7F, src.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), dst);
+}
+
+void X86_64Assembler::vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFC, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFD, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFE, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD4, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xF8, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xF9, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFA, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xFB, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD5, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x40, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaddwd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xF5, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddusb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDC, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEC, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddusw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDD, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xED, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubusb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD8, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE8, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubusw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xD9, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE9, dst, src1, src2);
+}
+
+void X86_64Assembler::vpavgb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE0, dst, src1, src2);
+}
+
+void X86_64Assembler::vpavgw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xE3, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x38, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3C, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEA, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEE, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminsd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x39, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxsd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3D, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminub(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDA, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxub(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDE, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminuw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3A, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxuw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3E, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminud(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3B, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxud(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x3F, dst, src1, src2);
+}
+
+void X86_64Assembler::vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDB, dst, src1, src2);
+}
+
+void X86_64Assembler::vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xDF, dst, src1, src2);
+}
+
+void X86_64Assembler::vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEB, dst, src1, src2);
+}
+
+void X86_64Assembler::vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0xEF, dst, src1, src2);
+}
+
+void X86_64Assembler::vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x74, dst, src1, src2);
+}
+
+void X86_64Assembler::vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x58, dst, src1, src2);
+}
+
+void X86_64Assembler::vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x58, dst, src1, src2);
+}
+
+void X86_64Assembler::vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5C, dst, src1, src2);
+}
+
+void X86_64Assembler::vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5C, dst, src1, src2);
+}
+
+void X86_64Assembler::vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x59, dst, src1, src2);
+}
+
+void X86_64Assembler::vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x59, dst, src1, src2);
+}
+
+void X86_64Assembler::vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5E, dst, src1, src2);
+}
+
+void X86_64Assembler::vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5E, dst, src1, src2);
+}
+
+void X86_64Assembler::vminps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5D, dst, src1, src2);
+}
+
+void X86_64Assembler::vminpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5D, dst, src1, src2);
+}
+
+void X86_64Assembler::vmaxps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5F, dst, src1, src2);
+}
+
+void X86_64Assembler::vmaxpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x5F, dst, src1, src2);
+}
+
+void X86_64Assembler::vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x54, dst, src1, src2);
+}
+
+void X86_64Assembler::vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x54, dst, src1, src2);
+}
+
+void X86_64Assembler::vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x55, dst, src1, src2);
+}
+
+void X86_64Assembler::vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x55, dst, src1, src2);
+}
+
+void X86_64Assembler::vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x56, dst, src1, src2);
+}
+
+void X86_64Assembler::vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x56, dst, src1, src2);
+}
+
+void X86_64Assembler::vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x57, dst, src1, src2);
+}
+
+void X86_64Assembler::vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x57, dst, src1, src2);
+}
+
+void X86_64Assembler::vpabsd(YmmRegister dst, YmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x1E, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vcvtdq2ps(YmmRegister dst, YmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5B, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x71, /*reg=*/ 6,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x72, /*reg=*/ 6,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x73, /*reg=*/ 6,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x71, /*reg=*/ 4,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x72, /*reg=*/ 4,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x71, /*reg=*/ 2,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x72, /*reg=*/ 2,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(has_AVX2_);
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F, SET_VEX_PP_66, 0x73, /*reg=*/ 2,
+             X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+             Operand(CpuRegister(src.AsFloatRegister())));
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpbroadcastb(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x78, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vpbroadcastw(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x79, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vpbroadcastd(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x58, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vpbroadcastq(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x59, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vbroadcastss(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x18, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vbroadcastsd(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x19, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(src.AsFloatRegister())));
+}
+
+void X86_64Assembler::vextracti128(XmmRegister dst, YmmRegister src, const Immediate& imm) {
+  DCHECK(has_AVX2_);
+  DCHECK(imm.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_3A, SET_VEX_PP_66, 0x39, src.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), Operand(CpuRegister(dst.AsFloatRegister())));
+  EmitUint8(imm.value());
+}
+
+void X86_64Assembler::vpmovzxbw(YmmRegister dst, const Address& src) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x30, dst.AsFloatRegister(),
+             ManagedRegister::NoRegister().AsX86_64(), src);
+}
+
+void X86_64Assembler::vzeroupper() {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  X86_64ManagedRegister vvvv_reg = ManagedRegister::NoRegister().AsX86_64();
+  EmitUint8(EmitVexPrefixByteZero(/*is_twobyte_form=*/ true));
+  EmitUint8(EmitVexPrefixByteOne(/*R=*/ false, vvvv_reg, SET_VEX_L_128, SET_VEX_PP_NONE));
+  EmitUint8(0x77);
+}
+
 void X86_64Assembler::fldl(const Address& src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xDD);
@@ -5802,5 +6364,45 @@ uint8_t X86_64Assembler::EmitVexPrefixByteTwo(bool W,
   return vex_prefix;
 }
 
+
+void X86_64Assembler::EmitVex256(int SET_VEX_M,
+                                 int SET_VEX_PP,
+                                 uint8_t opcode,
+                                 int reg,
+                                 X86_64ManagedRegister vvvv,
+                                 const Operand& rm) {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  DCHECK_LT(reg, 16);
+  uint8_t rex = rm.rex();
+  bool Rex_x = (rex & GET_REX_X) != 0;
+  bool Rex_b = (rex & GET_REX_B) != 0;
+  bool is_twobyte_form = !Rex_x && !Rex_b && SET_VEX_M == SET_VEX_M_0F;
+  EmitUint8(EmitVexPrefixByteZero(is_twobyte_form));
+  if (is_twobyte_form) {
+    EmitUint8(EmitVexPrefixByteOne(reg > 7, vvvv, SET_VEL_L_256, SET_VEX_PP));
+  } else {
+    EmitUint8(EmitVexPrefixByteOne(reg > 7, Rex_x, Rex_b, SET_VEX_M));
+    EmitUint8(vvvv.IsNoRegister()
+                  ? EmitVexPrefixByteTwo(/*W=*/ false, SET_VEL_L_256, SET_VEX_PP)
+                  : EmitVexPrefixByteTwo(/*W=*/ false, vvvv, SET_VEL_L_256, SET_VEX_PP));
+  }
+  EmitUint8(opcode);
+  EmitOperand(reg & 7, rm);
+}
+
+void X86_64Assembler::EmitVex256(int SET_VEX_M,
+                                 int SET_VEX_PP,
+                                 uint8_t opcode,
+                                 YmmRegister dst,
+                                 YmmRegister src1,
+                                 YmmRegister src2) {
+  EmitVex256(SET_VEX_M,
+             SET_VEX_PP,
+             opcode,
+             dst.AsFloatRegister(),
+             X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+             Operand(CpuRegister(src2.AsFloatRegister())));
+}
+
 }  // namespace x86_64
 }  // namespace art
@@ -722,10 +722,14 @@ class X86_64Assembler final : public Assembler {
   void pcmpgtd(XmmRegister dst, XmmRegister src);
   void pcmpgtq(XmmRegister dst, XmmRegister src);  // SSE4.2
 
+  void pmovmskb(CpuRegister dst, XmmRegister src);
+
   void shufpd(XmmRegister dst, XmmRegister src, const Immediate& imm);
   void shufps(XmmRegister dst, XmmRegister src, const Immediate& imm);
   void pshufd(XmmRegister dst, XmmRegister src, const Immediate& imm);
 
+  void pclmulqdq(XmmRegister dst, XmmRegister src, const Immediate& imm);  // PCLMULQDQ
+
   void punpcklbw(XmmRegister dst, XmmRegister src);
   void punpcklwd(XmmRegister dst, XmmRegister src);
   void punpckldq(XmmRegister dst, XmmRegister src);
@@ -749,6 +753,100 @@ class X86_64Assembler final : public Assembler {
   void psrlq(XmmRegister reg, const Immediate& shift_count);
   void psrldq(XmmRegister reg, const Immediate& shift_count);
 
+  // 256-bit (VEX.L=1) vector operations on YMM registers; the integer ones require AVX2.
+  void vmovaps(YmmRegister dst, YmmRegister src);     // move
+  void vmovups(YmmRegister dst, const Address& src);  // load unaligned
+  void vmovups(const Address& dst, YmmRegister src);  // store unaligned
+  void vmovupd(YmmRegister dst, const Address& src);  // load unaligned
+  void vmovupd(const Address& dst, YmmRegister src);  // store unaligned
+  void vmovdqu(YmmRegister dst, const Address& src);  // load unaligned
+  void vmovdqu(const Address& dst, YmmRegister src);  // store unaligned
+
+  void vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaddwd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vpaddusb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddusw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubusb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubusw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpavgb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpavgw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vpminsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxsb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxsw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminsd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxsd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminub(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxub(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminuw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxuw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpminud(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmaxud(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpabsd(YmmRegister dst, YmmRegister src);
+
+  void vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vminps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vminpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmaxps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmaxpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vcvtdq2ps(YmmRegister dst, YmmRegister src);
+
+  void vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+
+  void vpbroadcastb(YmmRegister dst, XmmRegister src);
+  void vpbroadcastw(YmmRegister dst, XmmRegister src);
+  void vpbroadcastd(YmmRegister dst, XmmRegister src);
+  void vpbroadcastq(YmmRegister dst, XmmRegister src);
+  void vbroadcastss(YmmRegister dst, XmmRegister src);
+  void vbroadcastsd(YmmRegister dst, XmmRegister src);
+  void vextracti128(XmmRegister dst, YmmRegister src, const Immediate& imm);
+  void vpmovzxbw(YmmRegister dst, const Address& src);
+
+  void vzeroupper();
+
   void flds(const Address& src);
   void fstps(const Address& dst);
   void fsts(const Address& dst);
@@ -1177,6 +1275,22 @@ class X86_64Assembler final : public Assembler {
                                int SET_VEX_L,
                                int SET_VEX_PP);
 
+  // Emit a 256-bit (VEX.L=1, VEX.W=0) instruction. `reg` is the ModRM.reg field (a register
+  // number or an opcode extension), `vvvv` the extra VEX source register (or no register)
+  // and `rm` the ModRM.r/m operand. The short 2-byte VEX prefix is used when possible.
+  void EmitVex256(int SET_VEX_M,
+                  int SET_VEX_PP,
+                  uint8_t opcode,
+                  int reg,
+                  X86_64ManagedRegister vvvv,
+                  const Operand& rm);
+  void EmitVex256(int SET_VEX_M,
+                  int SET_VEX_PP,
+                  uint8_t opcode,
+                  YmmRegister dst,
+                  YmmRegister src1,
+                  YmmRegister src2);
+
   // Helper function to emit a shorter variant of XCHG if at least one operand is RAX/EAX/AX.
   bool try_xchg_rax(CpuRegister dst,
                     CpuRegister src,
@@ -136,13 +136,15 @@ class AssemblerX86_64Test : public AssemblerTest<x86_64::X86_64Assembler,
                                                  x86_64::Address,
                                                  x86_64::CpuRegister,
                                                  x86_64::XmmRegister,
-                                                 x86_64::Immediate> {
+                                                 x86_64::Immediate,
+                                                 x86_64::YmmRegister> {
  public:
   using Base = AssemblerTest<x86_64::X86_64Assembler,
                              x86_64::Address,
                              x86_64::CpuRegister,
                              x86_64::XmmRegister,
-                             x86_64::Immediate>;
+                             x86_64::Immediate,
+                             x86_64::YmmRegister>;
 
  protected:
   InstructionSet GetIsa() override {
@@ -284,6 +286,10 @@ class AssemblerX86_64Test : public AssemblerTest<x86_64::X86_64Assembler,
       fp_registers_.push_back(new x86_64::XmmRegister(x86_64::XMM13));
       fp_registers_.push_back(new x86_64::XmmRegister(x86_64::XMM14));
       fp_registers_.push_back(new x86_64::XmmRegister(x86_64::XMM15));
+
+      for (x86_64::XmmRegister* reg : fp_registers_) {
+        vec_registers_.push_back(new x86_64::YmmRegister(*reg));
+      }
     }
   }
 
@@ -291,6 +297,7 @@ class AssemblerX86_64Test : public AssemblerTest<x86_64::X86_64Assembler,
     AssemblerTest::TearDown();
     STLDeleteElements(&registers_);
     STLDeleteElements(&fp_registers_);
+    STLDeleteElements(&vec_registers_);
   }
 
   std::vector<x86_64::Address> GetAddresses() override {
@@ -305,6 +312,10 @@ class AssemblerX86_64Test : public AssemblerTest<x86_64::X86_64Assembler,
     return fp_registers_;
   }
 
+  std::vector<x86_64::YmmRegister*> GetVectorRegisters() override {
+    return vec_registers_;
+  }
+
   x86_64::Immediate CreateImmediate(int64_t imm_value) override {
     return x86_64::Immediate(imm_value);
   }
@@ -333,6 +344,7 @@ class AssemblerX86_64Test : public AssemblerTest<x86_64::X86_64Assembler,
   std::map<x86_64::CpuRegister, std::string, X86_64CpuRegisterCompare> tertiary_register_names_;
   std::map<x86_64::CpuRegister, std::string, X86_64CpuRegisterCompare> quaternary_register_names_;
   std::vector<x86_64::XmmRegister*> fp_registers_;
+  std::vector<x86_64::YmmRegister*> vec_registers_;
 };
 
 class AssemblerX86_64AVXTest : public AssemblerX86_64Test {
@@ -343,6 +355,44 @@ class AssemblerX86_64AVXTest : public AssemblerX86_64Test {
   x86_64::X86_64Assembler* CreateAssembler(ArenaAllocator* allocator) override {
     return new (allocator) x86_64::X86_64Assembler(allocator, instruction_set_features_.get());
   }
+
+  // Drivers for the YMM forms that mix vector registers with XMM registers or addresses.
+  std::string RepeatVF(void (x86_64::X86_64Assembler::*f)(x86_64::YmmRegister,
+                                                          x86_64::XmmRegister),
+                       const std::string& fmt) {
+    return RepeatTemplatedRegisters<x86_64::YmmRegister, x86_64::XmmRegister>(
+        f,
+        GetVectorRegisters(),
+        GetFPRegisters(),
+        &AssemblerX86_64AVXTest::GetVecRegName,
+        &AssemblerX86_64AVXTest::GetFPRegName,
+        fmt);
+  }
+
+  std::string RepeatVA(void (x86_64::X86_64Assembler::*f)(x86_64::YmmRegister,
+                                                          const x86_64::Address&),
+                       const std::string& fmt) {
+    return RepeatTemplatedRegMem<x86_64::YmmRegister, x86_64::Address>(
+        f,
+        GetVectorRegisters(),
+        GetAddresses(),
+        &AssemblerX86_64AVXTest::GetVecRegName,
+        &AssemblerX86_64AVXTest::GetAddrName,
+        fmt);
+  }
+
+  std::string RepeatAV(void (x86_64::X86_64Assembler::*f)(const x86_64::Address&,
+                                                          x86_64::YmmRegister),
+                       const std::string& fmt) {
+    return RepeatTemplatedMemReg<x86_64::Address, x86_64::YmmRegister>(
+        f,
+        GetAddresses(),
+        GetVectorRegisters(),
+        &AssemblerX86_64AVXTest::GetAddrName,
+        &AssemblerX86_64AVXTest::GetVecRegName,
+        fmt);
+  }
+
  private:
   std::unique_ptr<const X86_64InstructionSetFeatures> instruction_set_features_;
 };
@@ -1899,6 +1949,476 @@ TEST_F(AssemblerX86_64AVXTest, VFmadd213sd) {
                       "vfmadd213sd %{reg3}, %{reg2}, %{reg1}"), "vfmadd213sd");
 }
 
+//
+// 256-bit (YMM) AVX2 forms.
+//
+
+TEST_F(AssemblerX86_64AVXTest, VMovapsYmm) {
+  DriverStr(RepeatVV(&x86_64::X86_64Assembler::vmovaps, "vmovaps %{reg2}, %{reg1}"),
+            "vmovaps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupsStoreYmm) {
+  DriverStr(RepeatAV(&x86_64::X86_64Assembler::vmovups, "vmovups %{reg}, {mem}"), "vmovups_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupsLoadYmm) {
+  DriverStr(RepeatVA(&x86_64::X86_64Assembler::vmovups, "vmovups {mem}, %{reg}"), "vmovups_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupdStoreYmm) {
+  DriverStr(RepeatAV(&x86_64::X86_64Assembler::vmovupd, "vmovupd %{reg}, {mem}"), "vmovupd_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovupdLoadYmm) {
+  DriverStr(RepeatVA(&x86_64::X86_64Assembler::vmovupd, "vmovupd {mem}, %{reg}"), "vmovupd_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdquStoreYmm) {
+  DriverStr(RepeatAV(&x86_64::X86_64Assembler::vmovdqu, "vmovdqu %{reg}, {mem}"), "vmovdqu_ymm_s");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdquLoadYmm) {
+  DriverStr(RepeatVA(&x86_64::X86_64Assembler::vmovdqu, "vmovdqu {mem}, %{reg}"), "vmovdqu_ymm_l");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddb,
+                      "vpaddb %{reg3}, %{reg2}, %{reg1}"), "vpaddb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddwYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddw,
+                      "vpaddw %{reg3}, %{reg2}, %{reg1}"), "vpaddw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPadddYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddd,
+                      "vpaddd %{reg3}, %{reg2}, %{reg1}"), "vpaddd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddqYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddq,
+                      "vpaddq %{reg3}, %{reg2}, %{reg1}"), "vpaddq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubb,
+                      "vpsubb %{reg3}, %{reg2}, %{reg1}"), "vpsubb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubwYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubw,
+                      "vpsubw %{reg3}, %{reg2}, %{reg1}"), "vpsubw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubd,
+                      "vpsubd %{reg3}, %{reg2}, %{reg1}"), "vpsubd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubqYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubq,
+                      "vpsubq %{reg3}, %{reg2}, %{reg1}"), "vpsubq_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmullwYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmullw,
+                      "vpmullw %{reg3}, %{reg2}, %{reg1}"), "vpmullw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmulldYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmulld,
+                      "vpmulld %{reg3}, %{reg2}, %{reg1}"), "vpmulld_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaddwdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaddwd,
+                      "vpmaddwd %{reg3}, %{reg2}, %{reg1}"), "vpmaddwd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddusbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddusb,
+                      "vpaddusb %{reg3}, %{reg2}, %{reg1}"), "vpaddusb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddsbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddsb,
+                      "vpaddsb %{reg3}, %{reg2}, %{reg1}"), "vpaddsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPadduswYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddusw,
+                      "vpaddusw %{reg3}, %{reg2}, %{reg1}"), "vpaddusw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPaddswYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpaddsw,
+                      "vpaddsw %{reg3}, %{reg2}, %{reg1}"), "vpaddsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubusbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubusb,
+                      "vpsubusb %{reg3}, %{reg2}, %{reg1}"), "vpsubusb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubsbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubsb,
+                      "vpsubsb %{reg3}, %{reg2}, %{reg1}"), "vpsubsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubuswYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubusw,
+                      "vpsubusw %{reg3}, %{reg2}, %{reg1}"), "vpsubusw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsubswYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpsubsw,
+                      "vpsubsw %{reg3}, %{reg2}, %{reg1}"), "vpsubsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPavgbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpavgb,
+                      "vpavgb %{reg3}, %{reg2}, %{reg1}"), "vpavgb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPavgwYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpavgw,
+                      "vpavgw %{reg3}, %{reg2}, %{reg1}"), "vpavgw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminsbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpminsb,
+                      "vpminsb %{reg3}, %{reg2}, %{reg1}"), "vpminsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxsbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaxsb,
+                      "vpmaxsb %{reg3}, %{reg2}, %{reg1}"), "vpmaxsb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminswYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpminsw,
+                      "vpminsw %{reg3}, %{reg2}, %{reg1}"), "vpminsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxswYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaxsw,
+                      "vpmaxsw %{reg3}, %{reg2}, %{reg1}"), "vpmaxsw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminsdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpminsd,
+                      "vpminsd %{reg3}, %{reg2}, %{reg1}"), "vpminsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxsdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaxsd,
+                      "vpmaxsd %{reg3}, %{reg2}, %{reg1}"), "vpmaxsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminubYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpminub,
+                      "vpminub %{reg3}, %{reg2}, %{reg1}"), "vpminub_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxubYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaxub,
+                      "vpmaxub %{reg3}, %{reg2}, %{reg1}"), "vpmaxub_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminuwYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpminuw,
+                      "vpminuw %{reg3}, %{reg2}, %{reg1}"), "vpminuw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxuwYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaxuw,
+                      "vpmaxuw %{reg3}, %{reg2}, %{reg1}"), "vpmaxuw_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminudYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpminud,
+                      "vpminud %{reg3}, %{reg2}, %{reg1}"), "vpminud_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmaxudYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpmaxud,
+                      "vpmaxud %{reg3}, %{reg2}, %{reg1}"), "vpmaxud_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPandYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpand,
+                      "vpand %{reg3}, %{reg2}, %{reg1}"), "vpand_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPandnYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpandn,
+                      "vpandn %{reg3}, %{reg2}, %{reg1}"), "vpandn_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPorYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpor,
+                      "vpor %{reg3}, %{reg2}, %{reg1}"), "vpor_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPxorYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpxor,
+                      "vpxor %{reg3}, %{reg2}, %{reg1}"), "vpxor_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPcmpeqbYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vpcmpeqb,
+                      "vpcmpeqb %{reg3}, %{reg2}, %{reg1}"), "vpcmpeqb_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VaddpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vaddps,
+                      "vaddps %{reg3}, %{reg2}, %{reg1}"), "vaddps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VaddpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vaddpd,
+                      "vaddpd %{reg3}, %{reg2}, %{reg1}"), "vaddpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VsubpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vsubps,
+                      "vsubps %{reg3}, %{reg2}, %{reg1}"), "vsubps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VsubpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vsubpd,
+                      "vsubpd %{reg3}, %{reg2}, %{reg1}"), "vsubpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VmulpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vmulps,
+                      "vmulps %{reg3}, %{reg2}, %{reg1}"), "vmulps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VmulpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vmulpd,
+                      "vmulpd %{reg3}, %{reg2}, %{reg1}"), "vmulpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VdivpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vdivps,
+                      "vdivps %{reg3}, %{reg2}, %{reg1}"), "vdivps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VdivpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vdivpd,
+                      "vdivpd %{reg3}, %{reg2}, %{reg1}"), "vdivpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VminpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vminps,
+                      "vminps %{reg3}, %{reg2}, %{reg1}"), "vminps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VminpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vminpd,
+                      "vminpd %{reg3}, %{reg2}, %{reg1}"), "vminpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VmaxpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vmaxps,
+                      "vmaxps %{reg3}, %{reg2}, %{reg1}"), "vmaxps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VmaxpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vmaxpd,
+                      "vmaxpd %{reg3}, %{reg2}, %{reg1}"), "vmaxpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VandpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vandps,
+                      "vandps %{reg3}, %{reg2}, %{reg1}"), "vandps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VandpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vandpd,
+                      "vandpd %{reg3}, %{reg2}, %{reg1}"), "vandpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VandnpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vandnps,
+                      "vandnps %{reg3}, %{reg2}, %{reg1}"), "vandnps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VandnpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vandnpd,
+                      "vandnpd %{reg3}, %{reg2}, %{reg1}"), "vandnpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VorpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vorps,
+                      "vorps %{reg3}, %{reg2}, %{reg1}"), "vorps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VorpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vorpd,
+                      "vorpd %{reg3}, %{reg2}, %{reg1}"), "vorpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VxorpsYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vxorps,
+                      "vxorps %{reg3}, %{reg2}, %{reg1}"), "vxorps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VxorpdYmm) {
+  DriverStr(RepeatVVV(&x86_64::X86_64Assembler::vxorpd,
+                      "vxorpd %{reg3}, %{reg2}, %{reg1}"), "vxorpd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPabsdYmm) {
+  DriverStr(RepeatVV(&x86_64::X86_64Assembler::vpabsd, "vpabsd %{reg2}, %{reg1}"), "vpabsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, Vcvtdq2psYmm) {
+  DriverStr(RepeatVV(&x86_64::X86_64Assembler::vcvtdq2ps, "vcvtdq2ps %{reg2}, %{reg1}"),
+            "vcvtdq2ps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsllwYmm) {
+  GetAssembler()->vpsllw(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsllw(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsllw $1, %ymm1, %ymm0\n"
+            "vpsllw $2, %ymm8, %ymm15\n", "vpsllwi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPslldYmm) {
+  GetAssembler()->vpslld(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpslld(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpslld $1, %ymm1, %ymm0\n"
+            "vpslld $2, %ymm8, %ymm15\n", "vpslldi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsllqYmm) {
+  GetAssembler()->vpsllq(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsllq(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsllq $1, %ymm1, %ymm0\n"
+            "vpsllq $2, %ymm8, %ymm15\n", "vpsllqi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrawYmm) {
+  GetAssembler()->vpsraw(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsraw(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsraw $1, %ymm1, %ymm0\n"
+            "vpsraw $2, %ymm8, %ymm15\n", "vpsrawi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsradYmm) {
+  GetAssembler()->vpsrad(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsrad(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsrad $1, %ymm1, %ymm0\n"
+            "vpsrad $2, %ymm8, %ymm15\n", "vpsradi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrlwYmm) {
+  GetAssembler()->vpsrlw(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsrlw(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsrlw $1, %ymm1, %ymm0\n"
+            "vpsrlw $2, %ymm8, %ymm15\n", "vpsrlwi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrldYmm) {
+  GetAssembler()->vpsrld(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsrld(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsrld $1, %ymm1, %ymm0\n"
+            "vpsrld $2, %ymm8, %ymm15\n", "vpsrldi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPsrlqYmm) {
+  GetAssembler()->vpsrlq(x86_64::YmmRegister(x86_64::XMM0),
+                        x86_64::YmmRegister(x86_64::XMM1),
+                        x86_64::Immediate(1));
+  GetAssembler()->vpsrlq(x86_64::YmmRegister(x86_64::XMM15),
+                        x86_64::YmmRegister(x86_64::XMM8),
+                        x86_64::Immediate(2));
+  DriverStr("vpsrlq $1, %ymm1, %ymm0\n"
+            "vpsrlq $2, %ymm8, %ymm15\n", "vpsrlqi_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastb) {
+  DriverStr(RepeatVF(&x86_64::X86_64Assembler::vpbroadcastb, "vpbroadcastb %{reg2}, %{reg1}"),
+            "vpbroadcastb");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastw) {
+  DriverStr(RepeatVF(&x86_64::X86_64Assembler::vpbroadcastw, "vpbroadcastw %{reg2}, %{reg1}"),
+            "vpbroadcastw");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastd) {
+  DriverStr(RepeatVF(&x86_64::X86_64Assembler::vpbroadcastd, "vpbroadcastd %{reg2}, %{reg1}"),
+            "vpbroadcastd");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastq) {
+  DriverStr(RepeatVF(&x86_64::X86_64Assembler::vpbroadcastq, "vpbroadcastq %{reg2}, %{reg1}"),
+            "vpbroadcastq");
+}
+
+TEST_F(AssemblerX86_64AVXTest, Vbroadcastss) {
+  DriverStr(RepeatVF(&x86_64::X86_64Assembler::vbroadcastss, "vbroadcastss %{reg2}, %{reg1}"),
+            "vbroadcastss");
+}
+
+TEST_F(AssemblerX86_64AVXTest, Vbroadcastsd) {
+  DriverStr(RepeatVF(&x86_64::X86_64Assembler::vbroadcastsd, "vbroadcastsd %{reg2}, %{reg1}"),
+            "vbroadcastsd");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VExtracti128) {
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM0),
+                               x86_64::YmmRegister(x86_64::XMM1),
+                               x86_64::Immediate(1));
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM9),
+                               x86_64::YmmRegister(x86_64::XMM14),
+                               x86_64::Immediate(0));
+  DriverStr("vextracti128 $1, %ymm1, %xmm0\n"
+            "vextracti128 $0, %ymm14, %xmm9\n", "vextracti128");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPmovzxbw) {
+  DriverStr(RepeatVA(&x86_64::X86_64Assembler::vpmovzxbw, "vpmovzxbw {mem}, %{reg}"), "vpmovzxbw");
+}
+
+TEST_F(AssemblerX86_64AVXTest, Vzeroupper) {
+  GetAssembler()->vzeroupper();
+  DriverStr("vzeroupper\n", "vzeroupper");
+}
+
 TEST_F(AssemblerX86_64Test, Phaddw) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::phaddw, "phaddw %{reg2}, %{reg1}"), "phaddw");
 }
@@ -2027,6 +2547,11 @@ TEST_F(AssemblerX86_64Test, PCmpgtq) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pcmpgtq, "pcmpgtq %{reg2}, %{reg1}"), "pcmpgtq");
 }
 
+TEST_F(AssemblerX86_64Test, Pmovmskb) {
+  DriverStr(RepeatrF(&x86_64::X86_64Assembler::pmovmskb, "pmovmskb %{reg2}, %{reg1}"),
+            "pmovmskb");
+}
+
 TEST_F(AssemblerX86_64Test, Shufps) {
   DriverStr(RepeatFFI(&x86_64::X86_64Assembler::shufps, /*imm_bytes*/ 1U,
                       "shufps ${imm}, %{reg2}, %{reg1}"), "shufps");
@@ -2042,6 +2567,11 @@ TEST_F(AssemblerX86_64Test, PShufd) {
                       "pshufd ${imm}, %{reg2}, %{reg1}"), "pshufd");
 }
 
+TEST_F(AssemblerX86_64Test, Pclmulqdq) {
+  DriverStr(RepeatFFI(&x86_64::X86_64Assembler::pclmulqdq, /*imm_bytes*/ 1U,
+                      "pclmulqdq ${imm}, %{reg2}, %{reg1}"), "pclmulqdq");
+}
+
 TEST_F(AssemblerX86_64Test, Punpcklbw) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::punpcklbw,
                      "punpcklbw %{reg2}, %{reg1}"), "punpcklbw");
@@ -2286,7 +2816,8 @@ TEST_F(AssemblerX86_64Test, Popcntl) {
 }
 
 TEST_F(AssemblerX86_64Test, PopcntlAddress) {
-  DriverStr(RepeatrA(&x86_64::X86_64Assembler::popcntl, "popcntl {mem}, %{reg}"), "popcntl_address");
+  DriverStr(RepeatrA(&x86_64::X86_64Assembler::popcntl, "popcntl {mem}, %{reg}"),
+            "popcntl_address");
 }
 
 TEST_F(AssemblerX86_64Test, Popcntq) {
@@ -2294,7 +2825,8 @@ TEST_F(AssemblerX86_64Test, Popcntq) {
 }
 
 TEST_F(AssemblerX86_64Test, PopcntqAddress) {
-  DriverStr(RepeatRA(&x86_64::X86_64Assembler::popcntq, "popcntq {mem}, %{reg}"), "popcntq_address");
+  DriverStr(RepeatRA(&x86_64::X86_64Assembler::popcntq, "popcntq {mem}, %{reg}"),
+            "popcntq_address");
 }
 
 TEST_F(AssemblerX86_64Test, CmovlAddress) {
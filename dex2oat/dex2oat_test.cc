@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include "android-base/file.h"
 #include "android-base/logging.h"
 #include "android-base/macros.h"
 #include "android-base/stringprintf.h"
@@ -1011,6 +1012,53 @@ TEST_F(Dex2oatWatchdogTest, TestWatchdogTrigger) {
   RunTest(false, {"--watchdog-timeout=10"});
 }
 
+class Dex2oatCompilationReportTest : public Dex2oatTest {
+ protected:
+  void RunTest(const std::string& report_location) {
+    std::string dex_location = GetScratchDir() + "/Dex2OatReportTest.jar";
+    std::string odex_location = GetOdexDir() + "/Dex2OatReportTest.odex";
+
+    Copy(GetDexSrc1(), dex_location);
+
+    output_.clear();
+    ASSERT_TRUE(GenerateOdexForTest(dex_location,
+                                    odex_location,
+                                    CompilerFilter::kSpeed,
+                                    {"--dump-compilation-report=" + report_location,
+                                     // Pass -Xuse-stderr-logger to have dex2oat output in
+                                     // output_ on target.
+                                     "--runtime-arg",
+                                     "-Xuse-stderr-logger"}));
+  }
+};
+
+TEST_F(Dex2oatCompilationReportTest, WritesHeaderAndRows) {
+  std::string report_location = GetScratchDir() + "/report.csv";
+  RunTest(report_location);
+
+  std::string report;
+  ASSERT_TRUE(android::base::ReadFileToString(report_location, &report));
+  std::istringstream iss(report);
+  std::string line;
+  ASSERT_TRUE(std::getline(iss, line));
+  EXPECT_EQ("method,pass,time_ns,arena_bytes,arena_stack_peak_bytes", line);
+
+  // Each compiled method ends with a row for the whole compilation.
+  const std::regex total_row("^\"[^\"]+\",total,[0-9]+,[0-9]+,[0-9]+$");
+  bool found_total_row = false;
+  while (std::getline(iss, line) && !found_total_row) {
+    found_total_row = std::regex_match(line, total_row);
+  }
+  EXPECT_TRUE(found_total_row) << report;
+}
+
+TEST_F(Dex2oatCompilationReportTest, BadReportLocation) {
+  // The compilation still succeeds, but the failure to open the report is logged.
+  RunTest(GetScratchDir() + "/does-not-exist/report.csv");
+  EXPECT_NE(std::string::npos, output_.find("Failed to open compilation report file"))
+      << output_;
+}
+
 class Dex2oatReturnCodeTest : public Dex2oatTest {
  protected:
   int RunTest(const std::vector<std::string>& extra_args = {}) {
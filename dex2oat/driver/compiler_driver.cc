@@ -22,6 +22,7 @@
 #include <malloc.h>  // For mallinfo
 #endif
 
+#include <algorithm>
 #include <string_view>
 #include <vector>
 
@@ -2554,6 +2555,19 @@ void CompilerDriver::InitializeClasses(jobject class_loader,
   }
 }
 
+// A method to compile. The methods of a dex file are compiled independently of their class,
+// so that a few huge classes do not leave all but one thread idle at the end of the
+// compilation.
+struct MethodCompilationWorkUnit {
+  const dex::CodeItem* code_item;
+  uint32_t access_flags;
+  InvokeType invoke_type;
+  uint16_t class_def_index;
+  uint32_t method_idx;
+  // Estimated cost of compiling the method, the size of its code item in code units.
+  uint32_t cost;
+};
+
 template <typename CompileFn>
 static void CompileDexFile(CompilerDriver* driver,
                            jobject class_loader,
@@ -2578,13 +2592,13 @@ static void CompileDexFile(CompilerDriver* driver,
       ? compiler_options.GetProfileCompilationInfo()->FindDexFile(dex_file)
       : ProfileCompilationInfo::MaxProfileIndex();
 
-  auto compile = [&context, &compile_fn, profile_index](size_t class_def_index) {
+  // First, find the classes whose methods we should compile.
+  std::vector<uint8_t> compile_class(dex_file.NumClassDefs(), 0u);
+  auto check_class = [&context, &compile_class](size_t class_def_index) {
     const DexFile& dex_file = *context.GetDexFile();
-    SCOPED_TRACE << "compile " << dex_file.GetLocation() << "@" << class_def_index;
     ClassLinker* class_linker = context.GetClassLinker();
     jobject jclass_loader = context.GetClassLoader();
     ClassReference ref(&dex_file, class_def_index);
-    const dex::ClassDef& class_def = dex_file.GetClassDef(class_def_index);
     ClassAccessor accessor(dex_file, class_def_index);
     CompilerDriver* const driver = context.GetCompiler();
     // Skip compiling classes with generic verifier failures since they will still fail at runtime
@@ -2592,36 +2606,39 @@ static void CompileDexFile(CompilerDriver* driver,
     if (driver->GetVerificationResults()->IsClassRejected(ref)) {
       return;
     }
+    // Nothing to do if there are no methods to compile.
+    if (accessor.NumDirectMethods() + accessor.NumVirtualMethods() == 0) {
+      return;
+    }
     // Use a scoped object access to perform to the quick SkipClass check.
     ScopedObjectAccess soa(Thread::Current());
-    StackHandleScope<3> hs(soa.Self());
+    StackHandleScope<2> hs(soa.Self());
     Handle<mirror::ClassLoader> class_loader(
         hs.NewHandle(soa.Decode<mirror::ClassLoader>(jclass_loader)));
     Handle<mirror::Class> klass(
         hs.NewHandle(class_linker->FindClass(soa.Self(), accessor.GetDescriptor(), class_loader)));
-    Handle<mirror::DexCache> dex_cache;
     if (klass == nullptr) {
       soa.Self()->AssertPendingException();
       soa.Self()->ClearException();
-      dex_cache = hs.NewHandle(class_linker->FindDexCache(soa.Self(), dex_file));
     } else if (SkipClass(jclass_loader, dex_file, klass.Get())) {
       return;
     } else if (&klass->GetDexFile() != &dex_file) {
       // Skip a duplicate class (as the resolved class is from another, earlier dex file).
       return;  // Do not update state.
-    } else {
-      dex_cache = hs.NewHandle(klass->GetDexCache());
     }
+    compile_class[class_def_index] = 1u;
+  };
+  context.ForAllLambda(0, dex_file.NumClassDefs(), check_class, thread_count);
 
-    // Avoid suspension if there are no methods to compile.
-    if (accessor.NumDirectMethods() + accessor.NumVirtualMethods() == 0) {
-      return;
+  // Then, collect the methods of these classes and hand them out largest first, so that the
+  // cheap methods balance the load between threads at the end of the compilation.
+  std::vector<MethodCompilationWorkUnit> work_units;
+  for (ClassAccessor accessor : dex_file.GetClasses()) {
+    const uint16_t class_def_index = accessor.GetClassDefIndex();
+    if (compile_class[class_def_index] == 0u) {
+      continue;
     }
-
-    // Go to native so that we don't block GC during compilation.
-    ScopedThreadSuspension sts(soa.Self(), ThreadState::kNative);
-
-    // Compile direct and virtual methods.
+    const dex::ClassDef& class_def = accessor.GetClassDef();
     int64_t previous_method_idx = -1;
     for (const ClassAccessor::Method& method : accessor.GetMethods()) {
       const uint32_t method_idx = method.GetIndex();
@@ -2631,20 +2648,48 @@ static void CompileDexFile(CompilerDriver* driver,
         continue;
       }
       previous_method_idx = method_idx;
-      compile_fn(soa.Self(),
-                 driver,
-                 method.GetCodeItem(),
-                 method.GetAccessFlags(),
-                 method.GetInvokeType(class_def.access_flags_),
-                 class_def_index,
-                 method_idx,
-                 class_loader,
-                 dex_file,
-                 dex_cache,
-                 profile_index);
-    }
+      work_units.push_back({method.GetCodeItem(),
+                            method.GetAccessFlags(),
+                            method.GetInvokeType(class_def.access_flags_),
+                            class_def_index,
+                            method_idx,
+                            method.GetInstructions().InsnsSizeInCodeUnits()});
+    }
+  }
+  std::stable_sort(work_units.begin(),
+                   work_units.end(),
+                   [](const MethodCompilationWorkUnit& lhs, const MethodCompilationWorkUnit& rhs) {
+                     return lhs.cost > rhs.cost;
+                   });
+
+  auto compile = [&context, &compile_fn, &work_units, profile_index](size_t index) {
+    const MethodCompilationWorkUnit& work_unit = work_units[index];
+    const DexFile& dex_file = *context.GetDexFile();
+    SCOPED_TRACE << "compile " << dex_file.GetLocation() << "@" << work_unit.class_def_index
+                 << ":" << work_unit.method_idx;
+    ClassLinker* class_linker = context.GetClassLinker();
+    ScopedObjectAccess soa(Thread::Current());
+    StackHandleScope<2> hs(soa.Self());
+    Handle<mirror::ClassLoader> class_loader(
+        hs.NewHandle(soa.Decode<mirror::ClassLoader>(context.GetClassLoader())));
+    Handle<mirror::DexCache> dex_cache(
+        hs.NewHandle(class_linker->FindDexCache(soa.Self(), dex_file)));
+
+    // Go to native so that we don't block GC during compilation.
+    ScopedThreadSuspension sts(soa.Self(), ThreadState::kNative);
+    compile_fn(soa.Self(),
+               context.GetCompiler(),
+               work_unit.code_item,
+               work_unit.access_flags,
+               work_unit.invoke_type,
+               work_unit.class_def_index,
+               work_unit.method_idx,
+               class_loader,
+               dex_file,
+               dex_cache,
+               profile_index);
   };
-  context.ForAllLambda(0, dex_file.NumClassDefs(), compile, thread_count);
+  context.ForAllLambda(0, work_units.size(), compile, thread_count);
 }
 
 void CompilerDriver::Compile(jobject class_loader,
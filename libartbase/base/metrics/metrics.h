@@ -39,35 +39,47 @@
 // See README.md in this directory for how to define metrics.
 
 // Metrics reported as Event Metrics.
-#define ART_EVENT_METRICS(METRIC)                                   \
-  METRIC(ClassLoadingTotalTime, MetricsCounter)                     \
-  METRIC(ClassVerificationTotalTime, MetricsCounter)                \
-  METRIC(ClassVerificationCount, MetricsCounter)                    \
-  METRIC(WorldStopTimeDuringGCAvg, MetricsAverage)                  \
-  METRIC(YoungGcCount, MetricsCounter)                              \
-  METRIC(FullGcCount, MetricsCounter)                               \
-  METRIC(TotalBytesAllocated, MetricsCounter)                       \
-  METRIC(TotalGcCollectionTime, MetricsCounter)                     \
-  METRIC(YoungGcThroughputAvg, MetricsAverage)                      \
-  METRIC(FullGcThroughputAvg, MetricsAverage)                       \
-  METRIC(YoungGcTracingThroughputAvg, MetricsAverage)               \
-  METRIC(FullGcTracingThroughputAvg, MetricsAverage)                \
-  METRIC(JitMethodCompileTotalTime, MetricsCounter)                 \
-  METRIC(JitMethodCompileCount, MetricsCounter)                     \
-  METRIC(YoungGcCollectionTime, MetricsHistogram, 15, 0, 60'000)    \
-  METRIC(FullGcCollectionTime, MetricsHistogram, 15, 0, 60'000)     \
-  METRIC(YoungGcThroughput, MetricsHistogram, 15, 0, 10'000)        \
-  METRIC(FullGcThroughput, MetricsHistogram, 15, 0, 10'000)         \
-  METRIC(YoungGcTracingThroughput, MetricsHistogram, 15, 0, 10'000) \
-  METRIC(FullGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)  \
-  METRIC(GcWorldStopTime, MetricsCounter)                           \
-  METRIC(GcWorldStopCount, MetricsCounter)                          \
-  METRIC(YoungGcScannedBytes, MetricsCounter)                       \
-  METRIC(YoungGcFreedBytes, MetricsCounter)                         \
-  METRIC(YoungGcDuration, MetricsCounter)                           \
-  METRIC(FullGcScannedBytes, MetricsCounter)                        \
-  METRIC(FullGcFreedBytes, MetricsCounter)                          \
-  METRIC(FullGcDuration, MetricsCounter)
+#define ART_EVENT_METRICS(METRIC)                                        \
+  METRIC(ClassLoadingTotalTime, MetricsCounter)                          \
+  METRIC(ClassVerificationTotalTime, MetricsCounter)                     \
+  METRIC(ClassVerificationCount, MetricsCounter)                         \
+  METRIC(WorldStopTimeDuringGCAvg, MetricsAverage)                       \
+  METRIC(YoungGcCount, MetricsCounter)                                   \
+  METRIC(FullGcCount, MetricsCounter)                                    \
+  METRIC(TotalBytesAllocated, MetricsCounter)                            \
+  METRIC(TotalGcCollectionTime, MetricsCounter)                          \
+  METRIC(YoungGcThroughputAvg, MetricsAverage)                           \
+  METRIC(FullGcThroughputAvg, MetricsAverage)                            \
+  METRIC(YoungGcTracingThroughputAvg, MetricsAverage)                    \
+  METRIC(FullGcTracingThroughputAvg, MetricsAverage)                     \
+  METRIC(JitMethodCompileTotalTime, MetricsCounter)                      \
+  METRIC(JitMethodCompileCount, MetricsCounter)                          \
+  METRIC(YoungGcCollectionTime, MetricsHistogram, 15, 0, 60'000)         \
+  METRIC(FullGcCollectionTime, MetricsHistogram, 15, 0, 60'000)          \
+  METRIC(YoungGcThroughput, MetricsHistogram, 15, 0, 10'000)             \
+  METRIC(FullGcThroughput, MetricsHistogram, 15, 0, 10'000)              \
+  METRIC(YoungGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)      \
+  METRIC(FullGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)       \
+  METRIC(GcWorldStopTime, MetricsCounter)                                \
+  METRIC(GcWorldStopCount, MetricsCounter)                               \
+  METRIC(YoungGcScannedBytes, MetricsCounter)                            \
+  METRIC(YoungGcFreedBytes, MetricsCounter)                              \
+  METRIC(YoungGcDuration, MetricsCounter)                                \
+  METRIC(FullGcScannedBytes, MetricsCounter)                             \
+  METRIC(FullGcFreedBytes, MetricsCounter)                               \
+  METRIC(FullGcDuration, MetricsCounter)                                 \
+  METRIC(YoungGcPauseTime, MetricsHistogram, 15, 0, 15'000)              \
+  METRIC(FullGcPauseTime, MetricsHistogram, 15, 0, 15'000)               \
+  METRIC(YoungGcMarkingTime, MetricsHistogram, 15, 0, 1'500)             \
+  METRIC(FullGcMarkingTime, MetricsHistogram, 15, 0, 1'500)              \
+  METRIC(YoungGcReferenceProcessingTime, MetricsHistogram, 15, 0, 1'500) \
+  METRIC(FullGcReferenceProcessingTime, MetricsHistogram, 15, 0, 1'500)  \
+  METRIC(YoungGcCompactionTime, MetricsHistogram, 15, 0, 1'500)          \
+  METRIC(FullGcCompactionTime, MetricsHistogram, 15, 0, 1'500)           \
+  METRIC(YoungGcSweepingTime, MetricsHistogram, 15, 0, 1'500)            \
+  METRIC(FullGcSweepingTime, MetricsHistogram, 15, 0, 1'500)             \
+  METRIC(InterpreterCacheHitCount, MetricsCounter)                       \
+  METRIC(InterpreterCacheMissCount, MetricsCounter)
 
 // Increasing counter metrics, reported as Value Metrics in delta increments.
 #define ART_VALUE_METRICS(METRIC)                              \
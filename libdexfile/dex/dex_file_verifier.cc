@@ -16,10 +16,13 @@
 
 #include "dex_file_verifier.h"
 
+#include <zlib.h>
+
 #include <algorithm>
 #include <bitset>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "android-base/logging.h"
 #include "android-base/macros.h"
@@ -46,6 +49,11 @@ namespace {
 
 constexpr uint32_t kTypeIdLimit = std::numeric_limits<uint16_t>::max();
 
+// Chunk sizes used when verification work is split through a `ParallelFor`. Anything smaller
+// than a single chunk is processed on the calling thread.
+constexpr size_t kChecksumChunkSize = 1024 * 1024;
+constexpr size_t kStringIdsChunkSize = 16 * 1024;
+
 constexpr bool IsValidOrNoTypeId(uint16_t low, uint16_t high) {
   return (high == 0) || ((high == 0xffffU) && (low == 0xffffU));
 }
@@ -191,12 +199,16 @@ std::string GetMethodDescription(const uint8_t* const begin,
 
 class DexFileVerifier {
  public:
-  DexFileVerifier(const DexFile* dex_file, const char* location, bool verify_checksum)
+  DexFileVerifier(const DexFile* dex_file,
+                  const char* location,
+                  bool verify_checksum,
+                  const ParallelFor* parallel_for = nullptr)
       : dex_file_(dex_file),
         begin_(dex_file->Begin()),
         size_(dex_file->Size()),
         location_(location),
         verify_checksum_(verify_checksum),
+        parallel_for_(parallel_for),
         header_(&dex_file->GetHeader()),
         ptr_(nullptr),
         previous_item_(nullptr),
@@ -314,6 +326,10 @@ class DexFileVerifier {
   bool CheckIntraSection();
 
   bool CheckOffsetToTypeMap(size_t offset, uint16_t type);
+  // Same as `CheckOffsetToTypeMap()` without reporting the error, safe to call concurrently.
+  bool IsValidOffsetToTypeMap(size_t offset, uint16_t type) const;
+  // Checks that all `StringId` offsets map to string data items.
+  bool CheckStringIdOffsets();
 
   // Returns kDexNoIndex if there are no fields/methods, otherwise a 16-bit type index.
   uint32_t FindFirstClassDataDefiner(const ClassAccessor& accessor);
@@ -335,6 +351,9 @@ class DexFileVerifier {
   bool CheckInterSectionIterate(size_t offset, uint32_t count, DexFile::MapItemType type);
   bool CheckInterSection();
 
+  // Computes the checksum of the dex file, in chunks if a `ParallelFor` was provided.
+  uint32_t CalculateChecksum() const;
+
   void ErrorStringPrintf(const char* fmt, ...)
       __attribute__((__format__(__printf__, 2, 3))) COLD_ATTR {
     va_list ap;
@@ -376,6 +395,7 @@ class DexFileVerifier {
   const size_t size_;
   const char* const location_;
   const bool verify_checksum_;
+  const ParallelFor* const parallel_for_;
   const DexFile::Header* const header_;
 
   struct OffsetTypeMapEmptyFn {
@@ -583,7 +603,7 @@ bool DexFileVerifier::CheckHeader() {
     return false;
   }
 
-  uint32_t adler_checksum = dex_file_->CalculateChecksum();
+  uint32_t adler_checksum = CalculateChecksum();
   // Compute and verify the checksum in the header.
   if (adler_checksum != header_->checksum_) {
     if (verify_checksum_) {
@@ -2388,6 +2408,49 @@ bool DexFileVerifier::CheckOffsetToTypeMap(size_t offset, uint16_t type) {
   return true;
 }
 
+bool DexFileVerifier::IsValidOffsetToTypeMap(size_t offset, uint16_t type) const {
+  DCHECK_NE(offset, 0u);
+  auto it = offset_to_type_map_.find(offset);
+  return it != offset_to_type_map_.end() && it->second == type;
+}
+
+bool DexFileVerifier::CheckStringIdOffsets() {
+  const dex::StringId* string_ids =
+      reinterpret_cast<const dex::StringId*>(begin_ + header_->string_ids_off_);
+  const size_t num_strings = header_->string_ids_size_;
+  size_t first_check = 0u;
+  if (parallel_for_ != nullptr && num_strings > kStringIdsChunkSize) {
+    // Look for the first bad offset of each chunk without reporting it; the chunks only read
+    // the `offset_to_type_map_` which is not modified anymore at this point.
+    const size_t num_chunks = (num_strings + kStringIdsChunkSize - 1u) / kStringIdsChunkSize;
+    std::vector<size_t> first_bad_index(num_chunks, num_strings);
+    (*parallel_for_)(num_chunks, [&](size_t chunk) {
+      const size_t end = std::min(num_strings, (chunk + 1u) * kStringIdsChunkSize);
+      for (size_t i = chunk * kStringIdsChunkSize; i != end; ++i) {
+        if (!IsValidOffsetToTypeMap(string_ids[i].string_data_off_,
+                                    DexFile::kDexTypeStringDataItem)) {
+          first_bad_index[chunk] = i;
+          break;
+        }
+      }
+    });
+    auto it = std::find_if(first_bad_index.begin(),
+                           first_bad_index.end(),
+                           [num_strings](size_t index) { return index != num_strings; });
+    if (it == first_bad_index.end()) {
+      return true;
+    }
+    // Re-check the first bad offset sequentially to report the same error as below.
+    first_check = *it;
+  }
+  for (size_t i = first_check; i != num_strings; ++i) {
+    if (!CheckOffsetToTypeMap(string_ids[i].string_data_off_, DexFile::kDexTypeStringDataItem)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 uint32_t DexFileVerifier::FindFirstClassDataDefiner(const ClassAccessor& accessor) {
   // The data item and field/method indexes have already been checked in
   // `CheckIntraClassDataItem()` or its helper functions.
@@ -3284,12 +3347,8 @@ bool DexFileVerifier::CheckInterSection() {
   // we can retrieve the string data for verifying other items (types, shorties, etc.).
   // After this we can safely use `DexFile` helpers such as `GetFieldId()` or `GetMethodId()`
   // but not `PrettyMethod()` or `PrettyField()` as descriptors have not been verified yet.
-  const dex::StringId* string_ids =
-      reinterpret_cast<const dex::StringId*>(begin_ + header_->string_ids_off_);
-  for (size_t i = 0, num_strings = header_->string_ids_size_; i != num_strings; ++i) {
-    if (!CheckOffsetToTypeMap(string_ids[i].string_data_off_, DexFile::kDexTypeStringDataItem)) {
-      return false;
-    }
+  if (!CheckStringIdOffsets()) {
+    return false;
   }
 
   const dex::MapList* map = reinterpret_cast<const dex::MapList*>(begin_ + header_->map_off_);
@@ -3350,6 +3409,32 @@ bool DexFileVerifier::CheckInterSection() {
   return true;
 }
 
+uint32_t DexFileVerifier::CalculateChecksum() const {
+  // Compact dex files also sum their shared data section, so leave them to the `DexFile`.
+  const size_t non_sum_bytes = OFFSETOF_MEMBER(DexFile::Header, signature_);
+  if (parallel_for_ == nullptr ||
+      !dex_file_->IsStandardDexFile() ||
+      size_ <= non_sum_bytes + kChecksumChunkSize) {
+    return dex_file_->CalculateChecksum();
+  }
+  const uint8_t* sum_begin = begin_ + non_sum_bytes;
+  const size_t sum_size = size_ - non_sum_bytes;
+  const size_t num_chunks = (sum_size + kChecksumChunkSize - 1u) / kChecksumChunkSize;
+  auto chunk_size = [&](size_t chunk) {
+    return std::min(kChecksumChunkSize, sum_size - chunk * kChecksumChunkSize);
+  };
+  std::vector<uint32_t> chunk_checksums(num_chunks);
+  (*parallel_for_)(num_chunks, [&](size_t chunk) {
+    chunk_checksums[chunk] =
+        DexFile::ChecksumMemoryRange(sum_begin + chunk * kChecksumChunkSize, chunk_size(chunk));
+  });
+  uint32_t checksum = chunk_checksums[0];
+  for (size_t chunk = 1u; chunk != num_chunks; ++chunk) {
+    checksum = adler32_combine(checksum, chunk_checksums[chunk], chunk_size(chunk));
+  }
+  return checksum;
+}
+
 bool DexFileVerifier::Verify() {
   // Check the header.
   if (!CheckHeader()) {
@@ -3744,5 +3829,19 @@ bool Verify(const DexFile* dex_file,
   return true;
 }
 
+bool Verify(const DexFile* dex_file,
+            const char* location,
+            bool verify_checksum,
+            std::string* error_msg,
+            const ParallelFor& parallel_for) {
+  std::unique_ptr<DexFileVerifier> verifier(new DexFileVerifier(
+      dex_file, location, verify_checksum, parallel_for != nullptr ? &parallel_for : nullptr));
+  if (!verifier->Verify()) {
+    *error_msg = verifier->FailureReason();
+    return false;
+  }
+  return true;
+}
+
 }  // namespace dex
 }  // namespace art
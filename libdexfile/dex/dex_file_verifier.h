@@ -17,6 +17,7 @@
 #ifndef ART_LIBDEXFILE_DEX_DEX_FILE_VERIFIER_H_
 #define ART_LIBDEXFILE_DEX_DEX_FILE_VERIFIER_H_
 
+#include <functional>
 #include <string>
 
 #include <inttypes.h>
@@ -32,6 +33,19 @@ bool Verify(const DexFile* dex_file,
             bool verify_checksum,
             std::string* error_msg);
 
+// Runs `task(i)` for every `i` in [0, `num_tasks`), possibly concurrently on other threads,
+// and returns once all the tasks have completed.
+using ParallelFor = std::function<void(size_t num_tasks, const std::function<void(size_t)>& task)>;
+
+// Same as above, but splits the checksum computation and the string data offset checks of
+// large dex files into chunks run through `parallel_for`. Reports the same error as the
+// sequential verification for any given dex file.
+bool Verify(const DexFile* dex_file,
+            const char* location,
+            bool verify_checksum,
+            std::string* error_msg,
+            const ParallelFor& parallel_for);
+
 }  // namespace dex
 }  // namespace art
 
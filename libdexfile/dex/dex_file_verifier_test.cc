@@ -18,12 +18,16 @@
 
 #include <zlib.h>
 
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <android-base/logging.h>
 
 #include "base/bit_utils.h"
+#include "base/globals.h"
 #include "base/leb128.h"
 #include "base/macros.h"
 #include "base64_test_util.h"
@@ -1636,6 +1640,94 @@ TEST_F(DexFileVerifierTest, Checksum) {
   EXPECT_NE(error_msg.find("Bad checksum"), std::string::npos) << error_msg;
 }
 
+// Runs each task on its own thread.
+static void ThreadPerTaskParallelFor(size_t num_tasks, const std::function<void(size_t)>& task) {
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i != num_tasks; ++i) {
+    threads.emplace_back(task, i);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_F(DexFileVerifierTest, ParallelFor) {
+  size_t length;
+  std::unique_ptr<uint8_t[]> dex_bytes(DecodeBase64(kGoodTestDex, &length));
+  CHECK(dex_bytes != nullptr);
+  // Note: `dex_file` will be destroyed before `dex_bytes`.
+  std::unique_ptr<DexFile> dex_file(GetDexFile(dex_bytes.get(), length));
+  dex::ParallelFor parallel_for = ThreadPerTaskParallelFor;
+  std::string error_msg;
+  EXPECT_TRUE(dex::Verify(dex_file.get(),
+                          "good checksum, verify",
+                          /*verify_checksum=*/true,
+                          &error_msg,
+                          parallel_for)) << error_msg;
+
+  // The parallel verification must report the same error as the sequential one.
+  DexFile::Header* header = reinterpret_cast<DexFile::Header*>(
+      const_cast<uint8_t*>(dex_file->Begin()));
+  header->checksum_ = 0;
+  std::string parallel_error_msg;
+  EXPECT_FALSE(dex::Verify(dex_file.get(),
+                           "bad checksum, verify",
+                           /*verify_checksum=*/true,
+                           &error_msg));
+  EXPECT_FALSE(dex::Verify(dex_file.get(),
+                           "bad checksum, verify",
+                           /*verify_checksum=*/true,
+                           &parallel_error_msg,
+                           parallel_for));
+  EXPECT_EQ(error_msg, parallel_error_msg);
+}
+
+TEST_F(DexFileVerifierTest, ParallelForLargeChecksum) {
+  size_t length;
+  std::unique_ptr<uint8_t[]> small_dex_bytes(DecodeBase64(kGoodTestDex, &length));
+  CHECK(small_dex_bytes != nullptr);
+  // Extend the data section with zeros, so that the checksum is computed in several chunks,
+  // the last of which is partial.
+  constexpr size_t kPadding = 3 * MB + KB;
+  const size_t large_length = length + kPadding;
+  std::unique_ptr<uint8_t[]> dex_bytes(new uint8_t[large_length]());
+  memcpy(dex_bytes.get(), small_dex_bytes.get(), length);
+  DexFile::Header* header = reinterpret_cast<DexFile::Header*>(dex_bytes.get());
+  ASSERT_EQ(header->data_off_ + header->data_size_, length);
+  header->file_size_ += kPadding;
+  header->data_size_ += kPadding;
+  FixUpChecksum(dex_bytes.get());
+  // Note: `dex_file` will be destroyed before `dex_bytes`.
+  std::unique_ptr<DexFile> dex_file(GetDexFile(dex_bytes.get(), large_length));
+  dex::ParallelFor parallel_for = ThreadPerTaskParallelFor;
+
+  std::string error_msg;
+  EXPECT_TRUE(dex::Verify(dex_file.get(),
+                          "good checksum, verify",
+                          /*verify_checksum=*/true,
+                          &error_msg)) << error_msg;
+  EXPECT_TRUE(dex::Verify(dex_file.get(),
+                          "good checksum, verify",
+                          /*verify_checksum=*/true,
+                          &error_msg,
+                          parallel_for)) << error_msg;
+
+  // Corrupt a byte in the third chunk. Both verifications must compute the same checksum.
+  dex_bytes[length + 2 * MB + 1] = 1u;
+  std::string parallel_error_msg;
+  EXPECT_FALSE(dex::Verify(dex_file.get(),
+                           "bad checksum, verify",
+                           /*verify_checksum=*/true,
+                           &error_msg));
+  EXPECT_FALSE(dex::Verify(dex_file.get(),
+                           "bad checksum, verify",
+                           /*verify_checksum=*/true,
+                           &parallel_error_msg,
+                           parallel_for));
+  EXPECT_NE(parallel_error_msg.find("Bad checksum"), std::string::npos) << parallel_error_msg;
+  EXPECT_EQ(error_msg, parallel_error_msg);
+}
+
 TEST_F(DexFileVerifierTest, BadStaticMethodName) {
   // Generated DEX file version (037) from:
   //
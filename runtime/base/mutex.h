@@ -174,6 +174,10 @@ class BaseMutex {
 std::ostream& operator<<(std::ostream& os, const Mutex& mu);
 class LOCKABLE Mutex : public BaseMutex {
  public:
+  // The default number of times `ExclusiveTryLockWithSpinning()` waits for the mutex to be
+  // released before giving up.
+  static constexpr size_t kDefaultMaxTryLockSpins = 5;
+
   explicit Mutex(const char* name, LockLevel level = kDefaultMutexLevel, bool recursive = false);
   ~Mutex();
 
@@ -186,8 +190,10 @@ class LOCKABLE Mutex : public BaseMutex {
   // Returns true if acquires exclusive access, false otherwise.
   bool ExclusiveTryLock(Thread* self) TRY_ACQUIRE(true);
   bool TryLock(Thread* self) TRY_ACQUIRE(true) { return ExclusiveTryLock(self); }
-  // Equivalent to ExclusiveTryLock, but retry for a short period before giving up.
-  bool ExclusiveTryLockWithSpinning(Thread* self) TRY_ACQUIRE(true);
+  // Equivalent to ExclusiveTryLock, but retry for a short period before giving up. The period
+  // grows with `max_spins`.
+  bool ExclusiveTryLockWithSpinning(Thread* self, size_t max_spins = kDefaultMaxTryLockSpins)
+      TRY_ACQUIRE(true);
 
   // Release exclusive access.
   void ExclusiveUnlock(Thread* self) RELEASE();
@@ -23,7 +23,9 @@
 
 namespace art {
 
-ClassTable::ClassTable() : lock_("Class loader classes", kClassLoaderClassesLock) {
+ClassTable::ClassTable()
+    : lock_("Class loader classes", kClassLoaderClassesLock),
+      frozen_snapshot_(nullptr) {
   Runtime* const runtime = Runtime::Current();
   classes_.push_back(ClassSet(runtime->GetHashTableMinLoadFactor(),
                               runtime->GetHashTableMaxLoadFactor()));
@@ -36,6 +38,19 @@ void ClassTable::FreezeSnapshot() {
   const ClassSet& last_set = classes_.back();
   ClassSet new_set(last_set.GetMinLoadFactor(), last_set.GetMaxLoadFactor());
   classes_.push_back(std::move(new_set));
+  PublishFrozenSnapshot();
+}
+
+void ClassTable::PublishFrozenSnapshot() {
+  DCHECK(!classes_.empty());
+  auto snapshot = std::make_unique<FrozenSnapshot>();
+  snapshot->sets.reserve(classes_.size() - 1u);
+  for (const ClassSet& class_set : MakeIterationRange(classes_.begin(),
+                                                      std::prev(classes_.end()))) {
+    snapshot->sets.push_back(&class_set);
+  }
+  frozen_snapshot_.store(snapshot.get(), std::memory_order_release);
+  frozen_snapshots_.push_back(std::move(snapshot));
 }
 
 ObjPtr<mirror::Class> ClassTable::UpdateClass(const char* descriptor,
@@ -79,8 +94,9 @@ size_t ClassTable::CountDefiningLoaderClasses(ObjPtr<mirror::ClassLoader> defini
 size_t ClassTable::NumZygoteClasses(ObjPtr<mirror::ClassLoader> defining_loader) const {
   ReaderMutexLock mu(Thread::Current(), lock_);
   size_t sum = 0;
-  for (size_t i = 0; i < classes_.size() - 1; ++i) {
-    sum += CountDefiningLoaderClasses(defining_loader, classes_[i]);
+  for (const ClassSet& class_set : MakeIterationRange(classes_.begin(),
+                                                      std::prev(classes_.end()))) {
+    sum += CountDefiningLoaderClasses(defining_loader, class_set);
   }
   return sum;
 }
@@ -93,8 +109,9 @@ size_t ClassTable::NumNonZygoteClasses(ObjPtr<mirror::ClassLoader> defining_load
 size_t ClassTable::NumReferencedZygoteClasses() const {
   ReaderMutexLock mu(Thread::Current(), lock_);
   size_t sum = 0;
-  for (size_t i = 0; i < classes_.size() - 1; ++i) {
-    sum += classes_[i].size();
+  for (const ClassSet& class_set : MakeIterationRange(classes_.begin(),
+                                                      std::prev(classes_.end()))) {
+    sum += class_set.size();
   }
   return sum;
 }
@@ -104,20 +121,49 @@ size_t ClassTable::NumReferencedNonZygoteClasses() const {
   return classes_.back().size();
 }
 
+ObjPtr<mirror::Class> ClassTable::LookupFrozen(const FrozenSnapshot* snapshot,
+                                               const DescriptorHashPair& pair,
+                                               size_t hash) {
+  if (snapshot == nullptr) {
+    return nullptr;
+  }
+  // Search from the last frozen set. For prebuilt boot images, this helps by searching the large
+  // table from the framework boot image extension compiled as single-image before the
+  // individual small tables from the primary boot image compiled as multi-image.
+  for (const ClassSet* class_set : ReverseRange(snapshot->sets)) {
+    auto it = class_set->FindWithHash(pair, hash);
+    if (it != class_set->end()) {
+      return it->Read();
+    }
+  }
+  return nullptr;
+}
+
 ObjPtr<mirror::Class> ClassTable::Lookup(const char* descriptor, size_t hash) {
   DescriptorHashPair pair(descriptor, hash);
+  // Frozen class sets are never modified other than by the GC updating the class references,
+  // so they can be searched without the lock. Unlike the other searches, this checks the frozen
+  // sets before the active one; a descriptor is in at most one set, so the result is the same.
+  const FrozenSnapshot* snapshot = frozen_snapshot_.load(std::memory_order_acquire);
+  ObjPtr<mirror::Class> klass = LookupFrozen(snapshot, pair, hash);
+  if (klass != nullptr) {
+    return klass;
+  }
   ReaderMutexLock mu(Thread::Current(), lock_);
-  // Search from the last table, assuming that apps shall search for their own classes
-  // more often than for boot image classes. For prebuilt boot images, this also helps
-  // by searching the large table from the framework boot image extension compiled as
-  // single-image before the individual small tables from the primary boot image
-  // compiled as multi-image.
-  for (ClassSet& class_set : ReverseRange(classes_)) {
-    auto it = class_set.FindWithHash(pair, hash);
-    if (it != class_set.end()) {
-      return it->Read();
+  // If the active set was frozen or a set was added since we loaded the snapshot, the class
+  // may now be in a set we have not searched, so search the current snapshot as well.
+  const FrozenSnapshot* current_snapshot = frozen_snapshot_.load(std::memory_order_relaxed);
+  if (current_snapshot != snapshot) {
+    klass = LookupFrozen(current_snapshot, pair, hash);
+    if (klass != nullptr) {
+      return klass;
     }
   }
+  ClassSet& active_set = classes_.back();
+  auto it = active_set.FindWithHash(pair, hash);
+  if (it != active_set.end()) {
+    return it->Read();
+  }
   return nullptr;
 }
 
@@ -178,7 +224,8 @@ void ClassTable::AddClassSet(ClassSet&& set) {
   // the number of searched frozen tables and not search them again.
   // TODO: Make use of this in `ClassLinker::FindClass()`.
   DCHECK(!classes_.empty());
-  classes_.insert(classes_.end() - 1, std::move(set));
+  classes_.insert(std::prev(classes_.end()), std::move(set));
+  PublishFrozenSnapshot();
 }
 
 void ClassTable::ClearStrongRoots() {
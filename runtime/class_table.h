@@ -17,10 +17,13 @@
 #ifndef ART_RUNTIME_CLASS_TABLE_H_
 #define ART_RUNTIME_CLASS_TABLE_H_
 
+#include <list>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/atomic.h"
 #include "base/gc_visited_arena_pool.h"
 #include "base/hash_set.h"
 #include "base/macros.h"
@@ -223,6 +226,7 @@ class ClassTable {
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Return the first class that matches the descriptor. Returns null if there are none.
+  // Frozen class sets are searched without holding `lock_`.
   ObjPtr<mirror::Class> Lookup(const char* descriptor, size_t hash)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -277,6 +281,21 @@ class ClassTable {
   }
 
  private:
+  // Immutable list of the frozen class sets that `Lookup()` searches without holding `lock_`.
+  struct FrozenSnapshot {
+    std::vector<const ClassSet*> sets;
+  };
+
+  // Search the frozen class sets of `snapshot`, which may be null. Does not need `lock_`.
+  static ObjPtr<mirror::Class> LookupFrozen(const FrozenSnapshot* snapshot,
+                                            const DescriptorHashPair& pair,
+                                            size_t hash)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Publish a new frozen snapshot after the set of frozen class sets changed.
+  void PublishFrozenSnapshot()
+      REQUIRES(lock_);
+
   size_t CountDefiningLoaderClasses(ObjPtr<mirror::ClassLoader> defining_loader,
                                     const ClassSet& set) const
       REQUIRES(lock_)
@@ -289,8 +308,16 @@ class ClassTable {
 
   // Lock to guard inserting and removing.
   mutable ReaderWriterMutex lock_;
-  // We have a vector to help prevent dirty pages after the zygote forks by calling FreezeSnapshot.
-  std::vector<ClassSet> classes_ GUARDED_BY(lock_);
+  // We have a list to help prevent dirty pages after the zygote forks by calling FreezeSnapshot.
+  // All but the last class set are frozen. A list keeps the addresses of the frozen class sets
+  // stable, so that they can be referenced from the `frozen_snapshot_`.
+  std::list<ClassSet> classes_ GUARDED_BY(lock_);
+  // The latest frozen snapshot. Published with release semantics while holding `lock_` for
+  // writing and read with acquire semantics without holding `lock_`.
+  Atomic<const FrozenSnapshot*> frozen_snapshot_;
+  // All published snapshots. Readers may still use a replaced snapshot, so snapshots are only
+  // freed with the table. Class sets are frozen rarely, once per image and at zygote fork.
+  std::vector<std::unique_ptr<const FrozenSnapshot>> frozen_snapshots_ GUARDED_BY(lock_);
   // Extra strong roots that can be either dex files or dex caches. Dex files used by the class
   // loader which may not be owned by the class loader must be held strongly live. Also dex caches
   // are held live to prevent them being unloading once they have classes in them.
@@ -16,6 +16,10 @@
 
 #include "class_table-inl.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "art_field-inl.h"
 #include "art_method-inl.h"
 #include "class_linker-inl.h"
@@ -27,6 +31,7 @@
 #include "mirror/class-alloc-inl.h"
 #include "obj_ptr.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art {
 namespace mirror {
@@ -112,6 +117,13 @@ TEST_F(ClassTableTest, ClassTable) {
   EXPECT_EQ(table.NumZygoteClasses(class_loader.Get()), 1u);
   EXPECT_EQ(table.NumNonZygoteClasses(class_loader.Get()), 1u);
 
+  // Freeze again and check that lookups see all frozen snapshots.
+  table.FreezeSnapshot();
+  EXPECT_OBJ_PTR_EQ(table.LookupByDescriptor(h_X.Get()), h_X.Get());
+  EXPECT_OBJ_PTR_EQ(table.LookupByDescriptor(h_Y.Get()), h_Y.Get());
+  EXPECT_EQ(table.NumZygoteClasses(class_loader.Get()), 2u);
+  EXPECT_EQ(table.NumNonZygoteClasses(class_loader.Get()), 0u);
+
   // Test adding / clearing strong roots.
   EXPECT_TRUE(table.InsertStrongRoot(obj_X.Get()));
   EXPECT_FALSE(table.InsertStrongRoot(obj_X.Get()));
@@ -161,5 +173,107 @@ TEST_F(ClassTableTest, ClassTable) {
   // TODO: Add tests for UpdateClass, InsertOatFile.
 }
 
+// Repeatedly looks up the classes defined in the latest round, checking that a class is found
+// as soon as it has been inserted, even while the table is being frozen.
+class LookupTask : public Task {
+ public:
+  LookupTask(std::vector<std::unique_ptr<ClassTable>>* tables,
+             Handle<mirror::Class> h_X,
+             Handle<mirror::Class> h_Y,
+             std::atomic<size_t>* x_rounds,
+             std::atomic<size_t>* y_rounds,
+             std::atomic<bool>* done)
+      : tables_(tables),
+        h_X_(h_X),
+        h_Y_(h_Y),
+        x_rounds_(x_rounds),
+        y_rounds_(y_rounds),
+        done_(done) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    while (!done_->load(std::memory_order_acquire)) {
+      size_t x_rounds = x_rounds_->load(std::memory_order_acquire);
+      if (x_rounds != 0u) {
+        ClassTable* table = (*tables_)[x_rounds - 1u].get();
+        ASSERT_OBJ_PTR_EQ(table->LookupByDescriptor(h_X_.Get()), h_X_.Get());
+      }
+      size_t y_rounds = y_rounds_->load(std::memory_order_acquire);
+      if (y_rounds != 0u) {
+        ClassTable* table = (*tables_)[y_rounds - 1u].get();
+        ASSERT_OBJ_PTR_EQ(table->LookupByDescriptor(h_X_.Get()), h_X_.Get());
+        ASSERT_OBJ_PTR_EQ(table->LookupByDescriptor(h_Y_.Get()), h_Y_.Get());
+      }
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  std::vector<std::unique_ptr<ClassTable>>* const tables_;
+  const Handle<mirror::Class> h_X_;
+  const Handle<mirror::Class> h_Y_;
+  std::atomic<size_t>* const x_rounds_;
+  std::atomic<size_t>* const y_rounds_;
+  std::atomic<bool>* const done_;
+};
+
+TEST_F(ClassTableTest, ConcurrentLookupAndFreeze) {
+  static constexpr size_t kNumThreads = 4;
+  static constexpr size_t kRounds = 2000;
+  Thread* const self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("ClassTableTest pool", kNumThreads));
+  ScopedObjectAccess soa(self);
+  jobject jclass_loader = LoadDex("XandY");
+  VariableSizedHandleScope hs(self);
+  Handle<ClassLoader> class_loader(hs.NewHandle(soa.Decode<ClassLoader>(jclass_loader)));
+  Handle<mirror::Class> h_X(
+      hs.NewHandle(class_linker_->FindClass(self, "LX;", class_loader)));
+  Handle<mirror::Class> h_Y(
+      hs.NewHandle(class_linker_->FindClass(self, "LY;", class_loader)));
+  ASSERT_TRUE(h_X != nullptr);
+  ASSERT_TRUE(h_Y != nullptr);
+
+  std::vector<std::unique_ptr<ClassTable>> tables;
+  for (size_t i = 0; i != kRounds; ++i) {
+    tables.push_back(std::make_unique<ClassTable>());
+  }
+  std::atomic<size_t> x_rounds(0u);
+  std::atomic<size_t> y_rounds(0u);
+  std::atomic<bool> done(false);
+  for (size_t i = 0; i != kNumThreads; ++i) {
+    thread_pool->AddTask(
+        self, new LookupTask(&tables, h_X, h_Y, &x_rounds, &y_rounds, &done));
+  }
+  thread_pool->StartWorkers(self);
+
+  // Each round defines X in the active set and freezes it, then does the same for Y, so that
+  // the readers race with the active set being frozen and with new frozen snapshots.
+  for (size_t i = 0; i != kRounds; ++i) {
+    ClassTable* table = tables[i].get();
+    table->Insert(h_X.Get());
+    x_rounds.store(i + 1u, std::memory_order_release);
+    table->FreezeSnapshot();
+    table->Insert(h_Y.Get());
+    y_rounds.store(i + 1u, std::memory_order_release);
+    table->FreezeSnapshot();
+  }
+  done.store(true, std::memory_order_release);
+
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    thread_pool->Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+  }
+  thread_pool->StopWorkers(self);
+
+  for (const std::unique_ptr<ClassTable>& table : tables) {
+    EXPECT_EQ(table->NumZygoteClasses(class_loader.Get()), 2u);
+    EXPECT_EQ(table->NumNonZygoteClasses(class_loader.Get()), 0u);
+  }
+}
+
 }  // namespace mirror
 }  // namespace art
@@ -2398,6 +2398,13 @@ extern "C" uint64_t artInvokePolymorphic(mirror::Object* raw_receiver, Thread* s
   if (resolved_method->GetDeclaringClass() == GetClassRoot<mirror::MethodHandle>(linker)) {
     Handle<mirror::MethodHandle> method_handle(hs.NewHandle(
         ObjPtr<mirror::MethodHandle>::DownCast(receiver_handle.Get())));
+    // Compiled code specialized on the MethodHandle kind compares the MethodHandle type with
+    // the resolved call site type by reference. Make an equal MethodHandle type the resolved
+    // one so that the next calls with this MethodHandle do not come here.
+    ObjPtr<mirror::MethodType> handle_type = method_handle->GetMethodType();
+    if (handle_type != method_type.Get() && method_type->IsExactMatch(handle_type)) {
+      caller_method->GetDexCache()->SetResolvedMethodType(proto_idx, handle_type.Ptr());
+    }
     if (intrinsic == Intrinsics::kMethodHandleInvokeExact) {
       success = MethodHandleInvokeExact(self,
                                         *shadow_frame,
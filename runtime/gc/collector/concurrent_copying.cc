@@ -182,6 +182,15 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
     gc_freed_bytes_delta_ = metrics->YoungGcFreedBytesDelta();
     gc_duration_ = metrics->YoungGcDuration();
     gc_duration_delta_ = metrics->YoungGcDurationDelta();
+    gc_pause_time_histogram_ = metrics->YoungGcPauseTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kMarking)] =
+        metrics->YoungGcMarkingTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kReferenceProcessing)] =
+        metrics->YoungGcReferenceProcessingTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kCompaction)] =
+        metrics->YoungGcCompactionTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kSweeping)] =
+        metrics->YoungGcSweepingTime();
   } else {
     gc_time_histogram_ = metrics->FullGcCollectionTime();
     metrics_gc_count_ = metrics->FullGcCount();
@@ -196,6 +205,15 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
     gc_freed_bytes_delta_ = metrics->FullGcFreedBytesDelta();
     gc_duration_ = metrics->FullGcDuration();
     gc_duration_delta_ = metrics->FullGcDurationDelta();
+    gc_pause_time_histogram_ = metrics->FullGcPauseTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kMarking)] =
+        metrics->FullGcMarkingTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kReferenceProcessing)] =
+        metrics->FullGcReferenceProcessingTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kCompaction)] =
+        metrics->FullGcCompactionTime();
+    gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kSweeping)] =
+        metrics->FullGcSweepingTime();
   }
 }
 
@@ -311,6 +329,7 @@ void ConcurrentCopying::RunPhases() {
     // In case of forced evacuation, all regions are evacuated and hence no
     // need to compute live_bytes.
     if (use_generational_cc_ && !young_gen_ && !force_evacuate_all_) {
+      ScopedPhaseTiming spt(this, GcPhase::kMarking);
       MarkingPhase();
     }
   }
@@ -325,6 +344,8 @@ void ConcurrentCopying::RunPhases() {
   }
   FlipThreadRoots();
   {
+    // Copying traces the heap and evacuates the live objects, we report it as compaction.
+    ScopedPhaseTiming spt(this, GcPhase::kCompaction);
     ReaderMutexLock mu(self, *Locks::mutator_lock_);
     CopyingPhase();
   }
@@ -343,6 +364,7 @@ void ConcurrentCopying::RunPhases() {
     CheckEmptyMarkStack();
   }
   {
+    ScopedPhaseTiming spt(this, GcPhase::kSweeping);
     ReaderMutexLock mu(self, *Locks::mutator_lock_);
     ReclaimPhase();
   }
@@ -3954,6 +3976,7 @@ void ConcurrentCopying::DelayReferenceReferent(ObjPtr<mirror::Class> klass,
 }
 
 void ConcurrentCopying::ProcessReferences(Thread* self) {
+  ScopedPhaseTiming spt(this, GcPhase::kReferenceProcessing);
   // We don't really need to lock the heap bitmap lock as we use CAS to mark in bitmaps.
   WriterMutexLock mu(self, *Locks::heap_bitmap_lock_);
   GetHeap()->GetReferenceProcessor()->ProcessReferences(self, GetTimings());
@@ -57,6 +57,7 @@ void Iteration::Reset(GcCause gc_cause, bool clear_soft_references) {
   freed_ = ObjectBytePair();
   freed_los_ = ObjectBytePair();
   freed_bytes_revoke_ = 0;
+  phase_times_ns_.fill(0u);
 }
 
 uint64_t Iteration::GetEstimatedThroughput() const {
@@ -83,6 +84,8 @@ GarbageCollector::GarbageCollector(Heap* heap, const std::string& name)
       gc_freed_bytes_delta_(nullptr),
       gc_duration_(nullptr),
       gc_duration_delta_(nullptr),
+      gc_pause_time_histogram_(nullptr),
+      gc_phase_time_histograms_{},
       cumulative_timings_(name),
       pause_histogram_lock_("pause histogram lock", kDefaultMutexLevel, true),
       is_transaction_active_(false),
@@ -224,6 +227,15 @@ void GarbageCollector::Run(GcCause gc_cause, bool clear_soft_references) {
     gc_freed_bytes_delta_->Add(current_iteration->GetFreedBytes());
     gc_duration_->Add(NsToMs(current_iteration->GetDurationNs()));
     gc_duration_delta_->Add(NsToMs(current_iteration->GetDurationNs()));
+
+    // Report the per-GC pause time in microseconds and the phase times in milliseconds.
+    gc_pause_time_histogram_->Add(total_pause_time_us);
+    for (size_t i = 0; i < kGcPhaseCount; ++i) {
+      uint64_t phase_time_ns = current_iteration->GetPhaseTimeNs(static_cast<GcPhase>(i));
+      if (phase_time_ns != 0u) {
+        gc_phase_time_histograms_[i]->Add(NsToMs(phase_time_ns));
+      }
+    }
   }
   is_transaction_active_ = false;
 }
@@ -294,6 +306,11 @@ GarbageCollector::ScopedPause::~ScopedPause() {
   runtime->GetThreadList()->ResumeAll();
 }
 
+GarbageCollector::ScopedPhaseTiming::~ScopedPhaseTiming() {
+  collector_->GetCurrentIteration()->phase_times_ns_[static_cast<size_t>(phase_)] +=
+      NanoTime() - start_time_;
+}
+
 // Returns the current GC iteration and assocated info.
 Iteration* GarbageCollector::GetCurrentIteration() {
   return heap_->GetCurrentGcIteration();
@@ -18,11 +18,13 @@
 #define ART_RUNTIME_GC_COLLECTOR_GARBAGE_COLLECTOR_H_
 
 #include <stdint.h>
+#include <array>
 #include <list>
 
 #include "base/histogram.h"
 #include "base/metrics/metrics.h"
 #include "base/mutex.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "gc/collector_type.h"
 #include "gc/gc_cause.h"
@@ -60,6 +62,19 @@ class GarbageCollector : public RootVisitor, public IsMarkedVisitor, public Mark
     bool with_reporting_;
   };
 
+  // Adds the time spent in its scope to the given phase of the current iteration.
+  class ScopedPhaseTiming {
+   public:
+    ScopedPhaseTiming(GarbageCollector* collector, GcPhase phase)
+        : start_time_(NanoTime()), collector_(collector), phase_(phase) {}
+    ~ScopedPhaseTiming();
+
+   private:
+    const uint64_t start_time_;
+    GarbageCollector* const collector_;
+    const GcPhase phase_;
+  };
+
   GarbageCollector(Heap* heap, const std::string& name);
   virtual ~GarbageCollector() { }
   const char* GetName() const {
@@ -174,6 +189,8 @@ class GarbageCollector : public RootVisitor, public IsMarkedVisitor, public Mark
   metrics::MetricsBase<uint64_t>* gc_freed_bytes_delta_;
   metrics::MetricsBase<uint64_t>* gc_duration_;
   metrics::MetricsBase<uint64_t>* gc_duration_delta_;
+  metrics::MetricsBase<int64_t>* gc_pause_time_histogram_;
+  std::array<metrics::MetricsBase<int64_t>*, kGcPhaseCount> gc_phase_time_histograms_;
   uint64_t total_thread_cpu_time_ns_;
   uint64_t total_time_ns_;
   uint64_t total_freed_objects_;
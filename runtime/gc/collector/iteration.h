@@ -18,6 +18,7 @@
 #define ART_RUNTIME_GC_COLLECTOR_ITERATION_H_
 
 #include <inttypes.h>
+#include <array>
 #include <vector>
 
 #include "android-base/macros.h"
@@ -29,6 +30,18 @@ namespace art {
 namespace gc {
 namespace collector {
 
+// The phases of a collection whose durations are reported through metrics. Not every collector
+// goes through every phase, and phases may nest (e.g. reference processing happens during marking
+// or sweeping depending on the collector).
+enum class GcPhase {
+  kMarking,
+  kReferenceProcessing,
+  kCompaction,
+  kSweeping,
+  kLast = kSweeping,
+};
+static constexpr size_t kGcPhaseCount = static_cast<size_t>(GcPhase::kLast) + 1;
+
 // A information related single garbage collector iteration. Since we only ever have one GC running
 // at any given time, we can have a single iteration info.
 class Iteration {
@@ -81,6 +94,10 @@ class Iteration {
   GcCause GetGcCause() const {
     return gc_cause_;
   }
+  // Returns how long was spent in the given phase in nanoseconds, 0 if the phase didn't run.
+  uint64_t GetPhaseTimeNs(GcPhase phase) const {
+    return phase_times_ns_[static_cast<size_t>(phase)];
+  }
 
  private:
   void SetDurationNs(uint64_t duration) {
@@ -96,6 +113,7 @@ class Iteration {
   ObjectBytePair freed_los_;
   uint64_t freed_bytes_revoke_;  // see Heap::num_bytes_freed_revoke_.
   std::vector<uint64_t> pause_times_;
+  std::array<uint64_t, kGcPhaseCount> phase_times_ns_;
 
   friend class GarbageCollector;
   DISALLOW_COPY_AND_ASSIGN(Iteration);
@@ -20,52 +20,73 @@
 #include "gc/space/bump_pointer_space.h"
 #include "mark_compact.h"
 #include "mirror/object-inl.h"
+#include "thread-current-inl.h"
 
 namespace art {
 namespace gc {
 namespace collector {
 
-inline void MarkCompact::UpdateClassAfterObjectMap(mirror::Object* obj) {
+template <bool kParallel>
+inline void MarkCompact::UpdateClassAfterObjectMap(mirror::Object* obj,
+                                                   mirror::Class** walk_super_class_cache) {
   mirror::Class* klass = obj->GetClass<kVerifyNone, kWithoutReadBarrier>();
   // Track a class if it needs walking super-classes for visiting references or
   // if it's higher in address order than its objects and is in moving space.
   if (UNLIKELY(
           (std::less<mirror::Object*>{}(obj, klass) && HasAddress(klass)) ||
           (klass->GetReferenceInstanceOffsets<kVerifyNone>() == mirror::Class::kClassWalkSuper &&
-           walk_super_class_cache_ != klass))) {
-    // Since this function gets invoked in the compaction pause as well, it is
-    // preferable to store such super class separately rather than updating key
-    // as the latter would require traversing the hierarchy for every object of 'klass'.
-    auto ret1 = class_after_obj_hash_map_.try_emplace(ObjReference::FromMirrorPtr(klass),
-                                                      ObjReference::FromMirrorPtr(obj));
-    if (ret1.second) {
-      if (klass->GetReferenceInstanceOffsets<kVerifyNone>() == mirror::Class::kClassWalkSuper) {
-        // In this case we require traversing through the super class hierarchy
-        // and find the super class at the highest address order.
-        mirror::Class* highest_klass = HasAddress(klass) ? klass : nullptr;
-        for (ObjPtr<mirror::Class> k = klass->GetSuperClass<kVerifyNone, kWithoutReadBarrier>();
-             k != nullptr;
-             k = k->GetSuperClass<kVerifyNone, kWithoutReadBarrier>()) {
-          // TODO: Can we break once we encounter a super class outside the moving space?
-          if (HasAddress(k.Ptr())) {
-            highest_klass = std::max(highest_klass, k.Ptr(), std::less<mirror::Class*>());
-          }
-        }
-        if (highest_klass != nullptr && highest_klass != klass) {
-          auto ret2 = super_class_after_class_hash_map_.try_emplace(
-              ObjReference::FromMirrorPtr(klass), ObjReference::FromMirrorPtr(highest_klass));
-          DCHECK(ret2.second);
-        } else {
-          walk_super_class_cache_ = klass;
+           *walk_super_class_cache != klass))) {
+    if (kParallel) {
+      MutexLock mu(Thread::Current(), lock_);
+      UpdateClassAfterObjectMapSlowPath(obj, klass, walk_super_class_cache);
+    } else {
+      UpdateClassAfterObjectMapSlowPath(obj, klass, walk_super_class_cache);
+    }
+  }
+}
+
+inline void MarkCompact::UpdateClassAfterObjectMapSlowPath(
+    mirror::Object* obj, mirror::Class* klass, mirror::Class** walk_super_class_cache) {
+  // Since this function gets invoked in the compaction pause as well, it is
+  // preferable to store such super class separately rather than updating key
+  // as the latter would require traversing the hierarchy for every object of 'klass'.
+  auto ret1 = class_after_obj_hash_map_.try_emplace(ObjReference::FromMirrorPtr(klass),
+                                                    ObjReference::FromMirrorPtr(obj));
+  if (ret1.second) {
+    if (klass->GetReferenceInstanceOffsets<kVerifyNone>() == mirror::Class::kClassWalkSuper) {
+      // In this case we require traversing through the super class hierarchy
+      // and find the super class at the highest address order.
+      mirror::Class* highest_klass = HasAddress(klass) ? klass : nullptr;
+      for (ObjPtr<mirror::Class> k = klass->GetSuperClass<kVerifyNone, kWithoutReadBarrier>();
+           k != nullptr;
+           k = k->GetSuperClass<kVerifyNone, kWithoutReadBarrier>()) {
+        // TODO: Can we break once we encounter a super class outside the moving space?
+        if (HasAddress(k.Ptr())) {
+          highest_klass = std::max(highest_klass, k.Ptr(), std::less<mirror::Class*>());
         }
       }
-    } else if (std::less<mirror::Object*>{}(obj, ret1.first->second.AsMirrorPtr())) {
+      if (highest_klass != nullptr && highest_klass != klass) {
+        auto ret2 = super_class_after_class_hash_map_.try_emplace(
+            ObjReference::FromMirrorPtr(klass), ObjReference::FromMirrorPtr(highest_klass));
+        DCHECK(ret2.second);
+      } else {
+        *walk_super_class_cache = klass;
+      }
+    }
+  } else {
+    if (std::less<mirror::Object*>{}(obj, ret1.first->second.AsMirrorPtr())) {
       ret1.first->second = ObjReference::FromMirrorPtr(obj);
     }
+    // Another marking task may have added the class, fill this task's cache.
+    if (klass->GetReferenceInstanceOffsets<kVerifyNone>() == mirror::Class::kClassWalkSuper &&
+        super_class_after_class_hash_map_.find(ObjReference::FromMirrorPtr(klass)) ==
+            super_class_after_class_hash_map_.end()) {
+      *walk_super_class_cache = klass;
+    }
   }
 }
 
-template <size_t kAlignment>
+template <size_t kAlignment> template <bool kParallel>
 inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_t begin,
                                                                         size_t size) {
   const uintptr_t begin_bit_idx = MemRangeBitmap::BitIndexFromAddr(begin);
@@ -79,8 +100,17 @@ inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_
   uintptr_t mask = Bitmap::BitIndexToMask(begin_bit_idx);
   // Bits that needs to be set in the first word, if it's not also the last word
   mask = ~(mask - 1);
+  // The first and the last bitmap words may be shared with other objects,
+  // which could be getting marked concurrently by other threads.
+  auto set_bits = [](uintptr_t* word, uintptr_t bits) {
+    if (kParallel) {
+      reinterpret_cast<Atomic<uintptr_t>*>(word)->fetch_or(bits, std::memory_order_relaxed);
+    } else {
+      *word |= bits;
+    }
+  };
   if (diff > 0) {
-    *begin_bm_address |= mask;
+    set_bits(begin_bm_address, mask);
     mask = ~0;
     // Even though memset can handle the (diff == 1) case but we should avoid the
     // overhead of a function call for this, highly likely (as most of the objects
@@ -91,7 +121,7 @@ inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_
     }
   }
   uintptr_t end_mask = Bitmap::BitIndexToMask(end_bit_idx);
-  *end_bm_address |= mask & (end_mask | (end_mask - 1));
+  set_bits(end_bm_address, mask & (end_mask | (end_mask - 1)));
   return begin_bit_idx;
 }
 
@@ -286,6 +316,7 @@ inline bool MarkCompact::VerifyRootSingleUpdate(void* root,
                          << " stack_high_addr=" << stack_high_addr;
     }
     DCHECK(reinterpret_cast<uint8_t*>(old_ref) >= black_allocations_begin_ ||
+           reinterpret_cast<uint8_t*>(old_ref) < compaction_begin_ ||
            live_words_bitmap_->Test(old_ref))
         << "ref=" << old_ref << " <" << mirror::Object::PrettyTypeOf(old_ref) << "> RootInfo ["
         << info << "]";
@@ -366,6 +397,10 @@ inline mirror::Object* MarkCompact::PostCompactAddressUnchecked(mirror::Object*
   if (reinterpret_cast<uint8_t*>(old_ref) >= black_allocations_begin_) {
     return PostCompactBlackObjAddr(old_ref);
   }
+  // Old objects below compaction_begin_ are not moved in a young cycle.
+  if (reinterpret_cast<uint8_t*>(old_ref) < compaction_begin_) {
+    return old_ref;
+  }
   if (kIsDebugBuild) {
     mirror::Object* from_ref = GetFromSpaceAddr(old_ref);
     DCHECK(live_words_bitmap_->Test(old_ref))
@@ -281,6 +281,12 @@ static constexpr bool kCheckLocks = kDebugLocking;
 static constexpr bool kVerifyRootsMarked = kIsDebugBuild;
 // Two threads should suffice on devices.
 static constexpr size_t kMaxNumUffdWorkers = 2;
+// Use the heap's thread-pool for draining the mark-stack.
+static constexpr bool kParallelProcessMarkStack = true;
+// Don't attempt to parallelize mark-stack processing unless the mark-stack has
+// at least these many elements. Otherwise, the overhead of creating tasks and
+// waking up the workers dominates.
+static constexpr size_t kMinimumParallelMarkStackSize = 128;
 // Number of compaction buffers reserved for mutator threads in SIGBUS feature
 // case. It's extremely unlikely that we will ever have more than these number
 // of mutator threads trying to access the moving-space during one compaction
@@ -395,7 +401,7 @@ size_t MarkCompact::InitializeInfoMap(uint8_t* p, size_t moving_space_sz) {
   return total;
 }
 
-MarkCompact::MarkCompact(Heap* heap)
+MarkCompact::MarkCompact(Heap* heap, bool use_generational)
     : GarbageCollector(heap, "concurrent mark compact"),
       gc_barrier_(0),
       lock_("mark compact lock", kGenericBottomLock),
@@ -403,6 +409,10 @@ MarkCompact::MarkCompact(Heap* heap)
       moving_space_bitmap_(bump_pointer_space_->GetMarkBitmap()),
       moving_space_begin_(bump_pointer_space_->Begin()),
       moving_space_end_(bump_pointer_space_->Limit()),
+      compaction_begin_(moving_space_begin_),
+      from_space_copy_begin_(moving_space_begin_),
+      old_gen_end_(moving_space_begin_),
+      old_gen_object_count_(0),
       moving_to_space_fd_(kFdUnused),
       moving_from_space_fd_(kFdUnused),
       uffd_(kFdUnused),
@@ -410,6 +420,8 @@ MarkCompact::MarkCompact(Heap* heap)
       compaction_in_progress_count_(0),
       thread_pool_counter_(0),
       compacting_(false),
+      use_generational_(use_generational),
+      young_gen_(false),
       uffd_initialized_(false),
       uffd_minor_fault_supported_(false),
       use_uffd_sigbus_(IsSigbusFeatureAvailable()),
@@ -521,7 +533,7 @@ MarkCompact::MarkCompact(Heap* heap)
 
   // Initialize GC metrics.
   metrics::ArtMetrics* metrics = GetMetrics();
-  // The mark-compact collector supports only full-heap collections at the moment.
+  // Young-generation cycles are accounted to YoungMarkCompact.
   gc_time_histogram_ = metrics->FullGcCollectionTime();
   metrics_gc_count_ = metrics->FullGcCount();
   metrics_gc_count_delta_ = metrics->FullGcCountDelta();
@@ -535,9 +547,50 @@ MarkCompact::MarkCompact(Heap* heap)
   gc_freed_bytes_delta_ = metrics->FullGcFreedBytesDelta();
   gc_duration_ = metrics->FullGcDuration();
   gc_duration_delta_ = metrics->FullGcDurationDelta();
+  gc_pause_time_histogram_ = metrics->FullGcPauseTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kMarking)] = metrics->FullGcMarkingTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kReferenceProcessing)] =
+      metrics->FullGcReferenceProcessingTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kCompaction)] =
+      metrics->FullGcCompactionTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kSweeping)] =
+      metrics->FullGcSweepingTime();
   are_metrics_initialized_ = true;
 }
 
+YoungMarkCompact::YoungMarkCompact(Heap* heap, MarkCompact* main)
+    : GarbageCollector(heap, "young concurrent mark compact"), main_(main) {
+  // Initialize GC metrics.
+  metrics::ArtMetrics* metrics = GetMetrics();
+  gc_time_histogram_ = metrics->YoungGcCollectionTime();
+  metrics_gc_count_ = metrics->YoungGcCount();
+  metrics_gc_count_delta_ = metrics->YoungGcCountDelta();
+  gc_throughput_histogram_ = metrics->YoungGcThroughput();
+  gc_tracing_throughput_hist_ = metrics->YoungGcTracingThroughput();
+  gc_throughput_avg_ = metrics->YoungGcThroughputAvg();
+  gc_tracing_throughput_avg_ = metrics->YoungGcTracingThroughputAvg();
+  gc_scanned_bytes_ = metrics->YoungGcScannedBytes();
+  gc_scanned_bytes_delta_ = metrics->YoungGcScannedBytesDelta();
+  gc_freed_bytes_ = metrics->YoungGcFreedBytes();
+  gc_freed_bytes_delta_ = metrics->YoungGcFreedBytesDelta();
+  gc_duration_ = metrics->YoungGcDuration();
+  gc_duration_delta_ = metrics->YoungGcDurationDelta();
+  gc_pause_time_histogram_ = metrics->YoungGcPauseTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kMarking)] =
+      metrics->YoungGcMarkingTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kReferenceProcessing)] =
+      metrics->YoungGcReferenceProcessingTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kCompaction)] =
+      metrics->YoungGcCompactionTime();
+  gc_phase_time_histograms_[static_cast<size_t>(GcPhase::kSweeping)] =
+      metrics->YoungGcSweepingTime();
+  are_metrics_initialized_ = true;
+}
+
+void YoungMarkCompact::RunPhases() {
+  main_->RunYoungPhases();
+}
+
 void MarkCompact::AddLinearAllocSpaceData(uint8_t* begin, size_t len) {
   DCHECK_ALIGNED(begin, kPageSize);
   DCHECK_ALIGNED(len, kPageSize);
@@ -662,15 +715,39 @@ void MarkCompact::PrepareCardTableForMarking(bool clear_alloc_space_cards) {
     } else if (clear_alloc_space_cards) {
       CHECK(!space->IsZygoteSpace());
       CHECK(!space->IsImageSpace());
+      uint8_t* clear_begin = space->Begin();
+      if (young_gen_) {
+        // In a young cycle we traverse only the young objects. The old ones,
+        // which are the non-moving space and the moving space below
+        // old_gen_end_, are treated as marked. Of those, only the objects on
+        // dirty cards may refer to young objects (see
+        // UpdateCardTableAfterCompaction()), so they have to be scanned. The
+        // aged cards were already scanned in the previous cycle.
+        clear_begin = space == bump_pointer_space_
+                          ? AlignUp(old_gen_end_, accounting::CardTable::kCardSize)
+                          : space->Limit();
+        card_table->ModifyCardsAtomic(
+            space->Begin(),
+            clear_begin,
+            [](uint8_t card) {
+              return (card == gc::accounting::CardTable::kCardDirty)
+                  ? card
+                  : gc::accounting::CardTable::kCardClean;
+            },
+            /* card modified visitor */ VoidFunctor());
+      }
       // The card-table corresponding to bump-pointer and non-moving space can
       // be cleared, because we are going to traverse all the reachable objects
       // in these spaces. This card-table will eventually be used to track
       // mutations while concurrent marking is going on.
-      card_table->ClearCardRange(space->Begin(), space->Limit());
+      card_table->ClearCardRange(clear_begin, space->Limit());
       if (space != bump_pointer_space_) {
         CHECK_EQ(space, heap_->GetNonMovingSpace());
         non_moving_space_ = space;
         non_moving_space_bitmap_ = space->GetMarkBitmap();
+        if (young_gen_) {
+          non_moving_space_bitmap_->CopyFrom(space->GetLiveBitmap());
+        }
       }
     } else {
       card_table->ModifyCardsAtomic(
@@ -724,6 +801,25 @@ void MarkCompact::InitializePhase() {
   black_allocations_begin_ = bump_pointer_space_->Limit();
   CHECK_EQ(moving_space_begin_, bump_pointer_space_->Begin());
   moving_space_end_ = bump_pointer_space_->Limit();
+  if (young_gen_ && (old_gen_end_ == moving_space_begin_ || old_gen_end_ >= moving_space_end_)) {
+    // There is either no old generation yet, or nothing but it. Collect the
+    // whole heap instead.
+    young_gen_ = false;
+  }
+  if (young_gen_ && uffd_minor_fault_supported_) {
+    // Young cycles zero the compacted range with madvise, which doesn't work
+    // once the moving space is mapped shared for minor-fault compaction.
+    young_gen_ = false;
+  }
+  if (use_generational_ && !young_gen_) {
+    // The old generation is retained in the mark-bitmap across cycles. A
+    // full-heap cycle starts from scratch.
+    moving_space_bitmap_->Clear();
+    old_gen_end_ = moving_space_begin_;
+    old_gen_object_count_ = 0;
+  }
+  compaction_begin_ = young_gen_ ? AlignDown(old_gen_end_, kPageSize) : moving_space_begin_;
+  from_space_copy_begin_ = moving_space_begin_;
   walk_super_class_cache_ = nullptr;
   // TODO: Would it suffice to read it once in the constructor, which is called
   // in zygote process?
@@ -764,6 +860,19 @@ class MarkCompact::FlipCallback : public Closure {
   MarkCompact* const collector_;
 };
 
+void MarkCompact::RunYoungPhases() {
+  DCHECK(use_generational_);
+  young_gen_ = true;
+  RunPhases();
+  young_gen_ = false;
+}
+
+void MarkCompact::ResetGenerations() {
+  moving_space_bitmap_->Clear();
+  old_gen_end_ = moving_space_begin_;
+  old_gen_object_count_ = 0;
+}
+
 void MarkCompact::RunPhases() {
   Thread* self = Thread::Current();
   thread_running_gc_ = self;
@@ -771,28 +880,35 @@ void MarkCompact::RunPhases() {
   InitializePhase();
   GetHeap()->PreGcVerification(this);
   {
-    ReaderMutexLock mu(self, *Locks::mutator_lock_);
-    MarkingPhase();
-  }
-  {
-    // Marking pause
-    ScopedPause pause(this);
-    MarkingPause();
-    if (kIsDebugBuild) {
-      bump_pointer_space_->AssertAllThreadLocalBuffersAreRevoked();
+    ScopedPhaseTiming spt(this, GcPhase::kMarking);
+    {
+      ReaderMutexLock mu(self, *Locks::mutator_lock_);
+      MarkingPhase();
+    }
+    {
+      // Marking pause
+      ScopedPause pause(this);
+      MarkingPause();
+      if (kIsDebugBuild) {
+        bump_pointer_space_->AssertAllThreadLocalBuffersAreRevoked();
+      }
     }
   }
   {
     ReaderMutexLock mu(self, *Locks::mutator_lock_);
-    ReclaimPhase();
+    {
+      ScopedPhaseTiming spt(this, GcPhase::kSweeping);
+      ReclaimPhase();
+    }
     PrepareForCompaction();
   }
-  if (uffd_ != kFallbackMode && !use_uffd_sigbus_) {
+  if (!CompactsInPause() && !use_uffd_sigbus_) {
     heap_->GetThreadPool()->WaitForWorkersToBeCreated();
   }
 
   {
     // Compaction pause
+    ScopedPhaseTiming spt(this, GcPhase::kCompaction);
     gc_barrier_.Init(self, 0);
     ThreadFlipVisitor visitor(this);
     FlipCallback callback(this);
@@ -804,26 +920,42 @@ void MarkCompact::RunPhases() {
     }
   }
 
-  if (IsValidFd(uffd_)) {
+  if (IsValidFd(uffd_) && !young_gen_) {
+    ScopedPhaseTiming spt(this, GcPhase::kCompaction);
     ReaderMutexLock mu(self, *Locks::mutator_lock_);
     CompactionPhase();
   }
 
+  if (young_gen_) {
+    // Nothing reads the from-space copy of the young pages once the compaction
+    // pause is over, so release it without keeping the mutators suspended.
+    TimingLogger::ScopedTiming t("ReleaseYoungFromSpaceCopy", GetTimings());
+    uint8_t* copy_end = black_allocations_begin_ + black_page_count_ * kPageSize;
+    uint8_t* from_space_copy = from_space_copy_begin_ + from_space_slide_diff_;
+    ZeroAndReleaseMemory(from_space_copy, copy_end - from_space_copy_begin_);
+    DCHECK_EQ(mprotect(from_space_copy, copy_end - from_space_copy_begin_, PROT_NONE), 0)
+        << "mprotect(PROT_NONE) for from-space failed: " << strerror(errno);
+  }
+
   FinishPhase();
   thread_running_gc_ = nullptr;
 }
 
 void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
-  // Find the first live word first.
-  size_t to_space_page_idx = 0;
+  // Find the first live word first. In a young cycle, the pages below
+  // compaction_begin_ are not compacted and so don't need first-objects.
+  size_t to_space_page_idx = (compaction_begin_ - moving_space_begin_) / kPageSize;
   uint32_t offset_in_chunk_word;
   uint32_t offset;
   mirror::Object* obj;
   const uintptr_t heap_begin = moving_space_bitmap_->HeapBegin();
+  moving_first_objs_count_ = to_space_page_idx;
 
   size_t chunk_idx;
   // Find the first live word in the space
-  for (chunk_idx = 0; chunk_info_vec_[chunk_idx] == 0; chunk_idx++) {
+  for (chunk_idx = (compaction_begin_ - moving_space_begin_) / kOffsetChunkSize;
+       chunk_info_vec_[chunk_idx] == 0;
+       chunk_idx++) {
     if (chunk_idx >= vec_len) {
       // We don't have any live data on the moving-space.
       return;
@@ -839,8 +971,13 @@ void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
                                            << " offset_in_word=" << offset_in_chunk_word
                                            << " word=" << std::hex
                                            << live_words_bitmap_->GetWord(chunk_idx);
-  // The first object doesn't require using FindPrecedingObject().
+  // The first object doesn't require using FindPrecedingObject(), unless the
+  // first live word belongs to an old object which started on a preceding
+  // page, which is possible in a young cycle.
   obj = reinterpret_cast<mirror::Object*>(heap_begin + offset * kAlignment);
+  if (compaction_begin_ != moving_space_begin_) {
+    obj = moving_space_bitmap_->FindPrecedingObject(reinterpret_cast<uintptr_t>(obj));
+  }
   // TODO: add a check to validate the object.
 
   pre_compact_offset_moving_space_[to_space_page_idx] = offset;
@@ -999,6 +1136,19 @@ void MarkCompact::PrepareForCompaction() {
   uint8_t* space_begin = bump_pointer_space_->Begin();
   size_t vector_len = (black_allocations_begin_ - space_begin) / kOffsetChunkSize;
   DCHECK_LE(vector_len, vector_length_);
+  // In a young cycle, the chunks below compaction_begin_ are not compacted.
+  const size_t vector_begin = (compaction_begin_ - space_begin) / kOffsetChunkSize;
+  if (old_gen_end_ > compaction_begin_) {
+    DCHECK(young_gen_);
+    // The old objects on the first compacted page are not discovered by
+    // marking. Treat them as live so that they stay in place.
+    live_words_bitmap_->SetLiveWords</*kParallel*/ false>(
+        reinterpret_cast<uintptr_t>(compaction_begin_), old_gen_end_ - compaction_begin_);
+    for (uint8_t* addr = compaction_begin_; addr < old_gen_end_; addr += kOffsetChunkSize) {
+      chunk_info_vec_[(addr - space_begin) / kOffsetChunkSize] +=
+          std::min(static_cast<size_t>(kOffsetChunkSize), static_cast<size_t>(old_gen_end_ - addr));
+    }
+  }
   for (size_t i = 0; i < vector_len; i++) {
     DCHECK_LE(chunk_info_vec_[i], kOffsetChunkSize);
     DCHECK_EQ(chunk_info_vec_[i], live_words_bitmap_->LiveBytesInBitmapWord(i));
@@ -1040,13 +1190,18 @@ void MarkCompact::PrepareForCompaction() {
     // std::exclusive_scan().
     total = chunk_info_vec_[vector_len - 1];
   }
-  std::exclusive_scan(chunk_info_vec_, chunk_info_vec_ + vector_len, chunk_info_vec_, 0);
+  DCHECK_LT(vector_begin, vector_len);
+  std::exclusive_scan(chunk_info_vec_ + vector_begin,
+                      chunk_info_vec_ + vector_len,
+                      chunk_info_vec_ + vector_begin,
+                      static_cast<uint32_t>(compaction_begin_ - space_begin));
   total += chunk_info_vec_[vector_len - 1];
 
   for (size_t i = vector_len; i < vector_length_; i++) {
     DCHECK_EQ(chunk_info_vec_[i], 0u);
   }
-  post_compact_end_ = AlignUp(space_begin + total, kPageSize);
+  post_compact_live_end_ = space_begin + total;
+  post_compact_end_ = AlignUp(post_compact_live_end_, kPageSize);
   CHECK_EQ(post_compact_end_, space_begin + moving_first_objs_count_ * kPageSize);
   black_objs_slide_diff_ = black_allocations_begin_ - post_compact_end_;
   // We shouldn't be consuming more space after compaction than pre-compaction.
@@ -1086,7 +1241,7 @@ void MarkCompact::PrepareForCompaction() {
   // For zygote we create the thread pool each time before starting compaction,
   // and get rid of it when finished. This is expected to happen rarely as
   // zygote spends most of the time in native fork loop.
-  if (uffd_ != kFallbackMode) {
+  if (!CompactsInPause()) {
     if (!use_uffd_sigbus_) {
       ThreadPool* pool = heap_->GetThreadPool();
       if (UNLIKELY(pool == nullptr)) {
@@ -1095,7 +1250,11 @@ void MarkCompact::PrepareForCompaction() {
         heap_->CreateThreadPool(std::min(heap_->GetParallelGCThreadCount(), kMaxNumUffdWorkers));
         pool = heap_->GetThreadPool();
       }
-      size_t num_threads = pool->GetThreadCount();
+      // The thread-pool may have more threads than required here as it is
+      // also used for parallel marking. The number of uffd workers is limited
+      // by the number of compaction buffers reserved for them.
+      size_t num_threads =
+          std::min({pool->GetThreadCount(), heap_->GetParallelGCThreadCount(), kMaxNumUffdWorkers});
       thread_pool_counter_ = num_threads;
       for (size_t i = 0; i < num_threads; i++) {
         pool->AddTask(thread_running_gc_, new ConcurrentCompactionGcTask(this, i + 1));
@@ -1332,6 +1491,10 @@ void MarkCompact::MarkingPause() {
     // Fetch only the accumulated objects-allocated count as it is guaranteed to
     // be up-to-date after the TLAB revocation above.
     freed_objects_ += bump_pointer_space_->GetAccumulatedObjectsAllocated();
+    if (young_gen_) {
+      // Old objects are not discovered by marking.
+      freed_objects_ -= old_gen_object_count_;
+    }
     // Capture 'end' of moving-space at this point. Every allocation beyond this
     // point will be considered as black.
     // Align-up to page boundary so that black allocations happen from next page
@@ -1380,6 +1543,7 @@ void MarkCompact::SweepSystemWeaks(Thread* self, Runtime* runtime, const bool pa
 }
 
 void MarkCompact::ProcessReferences(Thread* self) {
+  ScopedPhaseTiming spt(this, GcPhase::kReferenceProcessing);
   WriterMutexLock mu(self, *Locks::heap_bitmap_lock_);
   GetHeap()->GetReferenceProcessor()->ProcessReferences(self, GetTimings());
 }
@@ -1536,7 +1700,9 @@ void MarkCompact::VerifyObject(mirror::Object* ref, Callback& callback) const {
           << " post_compact_end=" << static_cast<void*>(post_compact_end_)
           << " pre_compact_klass=" << pre_compact_klass
           << " black_allocations_begin=" << static_cast<void*>(black_allocations_begin_);
-      CHECK(live_words_bitmap_->Test(pre_compact_klass));
+      // Classes below compaction_begin_ don't move in this cycle.
+      CHECK(reinterpret_cast<uint8_t*>(pre_compact_klass) < compaction_begin_ ||
+            live_words_bitmap_->Test(pre_compact_klass));
     }
     if (!IsValidObject(ref)) {
       std::ostringstream oss;
@@ -1569,8 +1735,11 @@ void MarkCompact::CompactPage(mirror::Object* obj,
                               uint32_t offset,
                               uint8_t* addr,
                               bool needs_memset_zero) {
+  // In a young cycle, the first object of the first compacted page may be an
+  // old object which starts below compaction_begin_.
   DCHECK(moving_space_bitmap_->Test(obj)
-         && live_words_bitmap_->Test(obj));
+         && (live_words_bitmap_->Test(obj)
+             || reinterpret_cast<uint8_t*>(obj) < compaction_begin_));
   DCHECK(live_words_bitmap_->Test(offset)) << "obj=" << obj
                                            << " offset=" << offset
                                            << " addr=" << static_cast<void*>(addr)
@@ -2145,6 +2314,11 @@ bool MarkCompact::FreeFromSpacePages(size_t cur_page_idx, int mode, size_t end_i
   // the to-space page up to which compaction has finished, all the from-space
   // pages corresponding to this onwards can be freed. There are some corner
   // cases to be taken care of, which are described below.
+  if (young_gen_) {
+    // Only a part of the moving space is copied to from-space in a young
+    // cycle, which is all released at the end of the compaction pause.
+    return false;
+  }
   size_t idx = last_checked_reclaim_page_idx_;
   // Find the to-space page up to which the corresponding from-space pages can be
   // freed.
@@ -2380,7 +2554,9 @@ void MarkCompact::CompactMovingSpace(uint8_t* page) {
   // processing.
   uint8_t* reserve_page = page;
   size_t end_idx_for_mapping = idx;
-  while (idx > 0) {
+  // In a young cycle the pages below compaction_begin_ are left as they are.
+  const size_t first_idx = (compaction_begin_ - bump_pointer_space_->Begin()) / kPageSize;
+  while (idx > first_idx) {
     idx--;
     to_space_end -= kPageSize;
     if (kMode == kMinorFaultMode) {
@@ -2412,10 +2588,10 @@ void MarkCompact::CompactMovingSpace(uint8_t* page) {
     }
   }
   // map one last time to finish anything left.
-  if (end_idx_for_mapping > 0) {
+  if (end_idx_for_mapping > idx) {
     MapMovingSpacePages(idx, end_idx_for_mapping);
   }
-  DCHECK_EQ(to_space_end, bump_pointer_space_->Begin());
+  DCHECK_EQ(to_space_end, compaction_begin_);
 }
 
 size_t MarkCompact::MapMovingSpacePages(size_t arr_idx, size_t arr_len) {
@@ -2580,7 +2756,7 @@ void MarkCompact::UpdateMovingSpaceBlackAllocations() {
         size_t obj_size = obj->SizeOf();
         bytes_scanned_ += obj_size;
         obj_size = RoundUp(obj_size, kAlignment);
-        UpdateClassAfterObjectMap(obj);
+        UpdateClassAfterObjectMap</*kParallel*/ false>(obj, &walk_super_class_cache_);
         if (first_obj == nullptr) {
           first_obj = obj;
         }
@@ -3041,9 +3217,9 @@ void MarkCompact::CompactionPause() {
         static_cast<GcVisitedArenaPool*>(runtime->GetLinearAllocArenaPool());
     // Update immune/pre-zygote class-tables in case class redefinition took
     // place. pre-zygote class-tables that are not in immune spaces are updated
-    // below if we are in fallback-mode or if there is no zygote space. So in
+    // below if we compact in the pause or if there is no zygote space. So in
     // that case only visit class-tables that are there in immune-spaces.
-    UpdateClassTableClasses(runtime, uffd_ == kFallbackMode || !has_zygote_space);
+    UpdateClassTableClasses(runtime, CompactsInPause() || !has_zygote_space);
 
     // Acquire arena-pool's lock, which should be released after the pool is
     // userfaultfd registered. This is to ensure that no new arenas are
@@ -3071,10 +3247,11 @@ void MarkCompact::CompactionPause() {
                              updater.SingleObjectArena(page_begin, page_size);
                            }
                          };
-    if (uffd_ == kFallbackMode || (!has_zygote_space && runtime->IsZygote())) {
-      // Besides fallback-mode, visit linear-alloc space in the pause for zygote
-      // processes prior to first fork (that's when zygote space gets created).
-      if (kIsDebugBuild && IsValidFd(uffd_)) {
+    if (CompactsInPause() || (!has_zygote_space && runtime->IsZygote())) {
+      // Besides fallback-mode and young cycles, visit linear-alloc space in the
+      // pause for zygote processes prior to first fork (that's when zygote
+      // space gets created).
+      if (kIsDebugBuild && IsValidFd(uffd_) && !young_gen_) {
         // All arenas allocated so far are expected to be pre-zygote fork.
         arena_pool->ForEachAllocatedArena(
             [](const TrackedArena& arena)
@@ -3108,17 +3285,31 @@ void MarkCompact::CompactionPause() {
             }
           });
     }
-    if (use_uffd_sigbus_) {
-      // Release order wrt to mutator threads' SIGBUS handler load.
-      sigbus_in_progress_count_.store(0, std::memory_order_release);
+    if (young_gen_) {
+      // Young cycles don't use userfaultfd, as they compact in this pause. The
+      // concurrent compaction moves the whole moving space to from-space, so
+      // mutators would then fault on every old page they touch. The pause only
+      // copies the pages allocated since the previous cycle, which the heap
+      // bounds by max_free_ between young cycles.
+      PrepareYoungCompaction();
+    } else {
+      if (use_uffd_sigbus_) {
+        // Release order wrt to mutator threads' SIGBUS handler load.
+        sigbus_in_progress_count_.store(0, std::memory_order_release);
+      }
+      KernelPreparation();
     }
-    KernelPreparation();
   }
 
   UpdateNonMovingSpace();
-  // fallback mode
-  if (uffd_ == kFallbackMode) {
+  // fallback mode or young cycle
+  if (CompactsInPause()) {
     CompactMovingSpace<kFallbackMode>(nullptr);
+    if (young_gen_) {
+      // Must be after compacting the moving space, as the old classes, which
+      // are read in place, are updated here.
+      UpdateOldGenRefs();
+    }
 
     int32_t freed_bytes = black_objs_slide_diff_;
     bump_pointer_space_->RecordFree(freed_objects_, freed_bytes);
@@ -3131,9 +3322,168 @@ void MarkCompact::CompactionPause() {
       heap_->GetThreadPool()->StartWorkers(thread_running_gc_);
     }
   }
+  if (use_generational_) {
+    UpdateCardTableAfterCompaction();
+  }
   stack_low_addr_ = nullptr;
 }
 
+void MarkCompact::PrepareYoungCompaction() {
+  TimingLogger::ScopedTiming t("(Paused)PrepareYoungCompaction", GetTimings());
+  // The first compacted page may start with an old object which began on a
+  // preceding page. The entire object must be readable from from-space.
+  const size_t first_idx = (compaction_begin_ - moving_space_begin_) / kPageSize;
+  if (moving_first_objs_count_ > first_idx) {
+    from_space_copy_begin_ = AlignDown(
+        reinterpret_cast<uint8_t*>(first_objs_moving_space_[first_idx].AsMirrorPtr()), kPageSize);
+  } else {
+    from_space_copy_begin_ = compaction_begin_;
+  }
+  uint8_t* copy_end = black_allocations_begin_ + black_page_count_ * kPageSize;
+  size_t copy_size = copy_end - from_space_copy_begin_;
+  uint8_t* from_space_copy = from_space_copy_begin_ + from_space_slide_diff_;
+  CHECK_EQ(mprotect(from_space_copy, copy_size, PROT_READ | PROT_WRITE), 0)
+      << "mprotect(PROT_READ | PROT_WRITE) for from-space failed: " << strerror(errno);
+  memcpy(from_space_copy, from_space_copy_begin_, copy_size);
+  // Compaction in the pause expects the to-space pages to be zeroed. The old
+  // objects below compaction_begin_ stay in place.
+  ZeroAndReleaseMemory(compaction_begin_, copy_end - compaction_begin_);
+}
+
+class MarkCompact::OldGenRefsUpdateVisitor {
+ public:
+  OldGenRefsUpdateVisitor(MarkCompact* collector, mirror::Object* obj, uint8_t* end)
+      : collector_(collector),
+        los_bitmap_(collector->heap_->GetLargeObjectsSpace() != nullptr
+                        ? collector->heap_->GetLargeObjectsSpace()->GetLiveBitmap()
+                        : nullptr),
+        obj_(obj),
+        end_(end),
+        has_young_ref_(false) {}
+
+  void operator()(mirror::Object* old ATTRIBUTE_UNUSED, MemberOffset offset, bool /* is_static */)
+      const ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (reinterpret_cast<uint8_t*>(obj_) + offset.Int32Value() < end_) {
+      Update(offset);
+    }
+  }
+
+  void operator()(mirror::Object* old ATTRIBUTE_UNUSED,
+                  MemberOffset offset,
+                  bool /*is_static*/,
+                  bool /*is_obj_array*/)
+      const ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_) {
+    Update(offset);
+  }
+
+  void VisitRootIfNonNull(mirror::CompressedReference<mirror::Object>* root) const
+      ALWAYS_INLINE
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (!root->IsNull()) {
+      VisitRoot(root);
+    }
+  }
+
+  void VisitRoot(mirror::CompressedReference<mirror::Object>* root) const
+      ALWAYS_INLINE
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    collector_->UpdateRoot(root, collector_->moving_space_begin_, collector_->moving_space_end_);
+    RecordRef(root->AsMirrorPtr());
+  }
+
+  bool HasYoungRef() const { return has_young_ref_; }
+
+ private:
+  void Update(MemberOffset offset) const REQUIRES_SHARED(Locks::mutator_lock_) {
+    collector_->UpdateRef(obj_, offset, collector_->moving_space_begin_,
+                          collector_->moving_space_end_);
+    RecordRef(obj_->GetFieldObject<mirror::Object, kVerifyNone, kWithoutReadBarrier>(offset));
+  }
+
+  // The objects which are young for the next cycle are the ones allocated
+  // after the marking pause.
+  void RecordRef(mirror::Object* ref) const {
+    if (collector_->HasAddress(ref)) {
+      has_young_ref_ |= reinterpret_cast<uint8_t*>(ref) >= collector_->post_compact_end_;
+    } else if (los_bitmap_ != nullptr && los_bitmap_->HasAddress(ref)) {
+      has_young_ref_ |= !los_bitmap_->Test(ref);
+    }
+  }
+
+  MarkCompact* const collector_;
+  accounting::LargeObjectBitmap* const los_bitmap_;
+  mirror::Object* const obj_;
+  uint8_t* const end_;
+  mutable bool has_young_ref_;
+};
+
+void MarkCompact::UpdateOldGenRefs() {
+  TimingLogger::ScopedTiming t("(Paused)UpdateOldGenRefs", GetTimings());
+  accounting::CardTable* card_table = heap_->GetCardTable();
+  std::vector<mirror::Object*> classes;
+  // Returns true if the object refers to a young object, or straddles
+  // compaction_begin_. The portion beyond compaction_begin_ was updated during
+  // compaction, so the card is conservatively kept dirty for it.
+  auto update_obj = [this](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+    uint8_t* obj_begin = reinterpret_cast<uint8_t*>(obj);
+    OldGenRefsUpdateVisitor visitor(this, obj, compaction_begin_);
+    size_t obj_size = obj->VisitRefsForCompaction(
+        visitor, MemberOffset(0), MemberOffset(compaction_begin_ - obj_begin));
+    return visitor.HasYoungRef() || obj_begin + obj_size > compaction_begin_;
+  };
+  // Update the old objects starting in each non-clean card. Class objects are
+  // deferred as the other objects' classes are read in place until then.
+  for (uint8_t* addr = moving_space_begin_; addr < compaction_begin_;
+       addr += accounting::CardTable::kCardSize) {
+    uint8_t* card = card_table->CardFromAddr(addr);
+    if (*card == accounting::CardTable::kCardClean) {
+      continue;
+    }
+    bool has_young_ref = false;
+    moving_space_bitmap_->VisitMarkedRange(
+        reinterpret_cast<uintptr_t>(addr),
+        reinterpret_cast<uintptr_t>(addr + accounting::CardTable::kCardSize),
+        [&](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+          if (obj->GetClass<kVerifyNone, kWithFromSpaceBarrier>()->IsClassClass<kVerifyNone>()) {
+            classes.push_back(obj);
+          } else {
+            has_young_ref |= update_obj(obj);
+          }
+        });
+    *card = has_young_ref ? accounting::CardTable::kCardDirty : accounting::CardTable::kCardClean;
+  }
+  for (mirror::Object* klass : classes) {
+    if (update_obj(klass)) {
+      card_table->MarkCard(klass);
+    }
+  }
+}
+
+void MarkCompact::UpdateCardTableAfterCompaction() {
+  TimingLogger::ScopedTiming t("(Paused)UpdateCardTableAfterCompaction", GetTimings());
+  accounting::CardTable* card_table = heap_->GetCardTable();
+  // Objects only slide towards the beginning of the space, so a card is never
+  // overwritten before it has been read. Objects which stay in place, like the
+  // old objects on the first compacted page, keep their card.
+  for (uint8_t* addr = compaction_begin_; addr < black_allocations_begin_;
+       addr += accounting::CardTable::kCardSize) {
+    uint8_t* card = card_table->CardFromAddr(addr);
+    if (*card == accounting::CardTable::kCardClean) {
+      continue;
+    }
+    *card = accounting::CardTable::kCardClean;
+    moving_space_bitmap_->VisitMarkedRange(
+        reinterpret_cast<uintptr_t>(addr),
+        reinterpret_cast<uintptr_t>(
+            std::min(addr + accounting::CardTable::kCardSize, black_allocations_begin_)),
+        [this, card_table](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+          if (live_words_bitmap_->Test(obj)) {
+            card_table->MarkCard(PostCompactAddressUnchecked(obj));
+          }
+        });
+  }
+}
+
 void MarkCompact::KernelPrepareRangeForUffd(uint8_t* to_addr,
                                             uint8_t* from_addr,
                                             size_t map_size,
@@ -4346,6 +4696,11 @@ void MarkCompact::MarkingPhase() {
   WriterMutexLock mu(thread_running_gc_, *Locks::heap_bitmap_lock_);
   MaybeClampGcStructures();
   PrepareCardTableForMarking(/*clear_alloc_space_cards*/ true);
+  if (young_gen_ && heap_->GetLargeObjectsSpace() != nullptr) {
+    // Large objects which survived the previous cycle are old. They don't
+    // have references, so there is nothing else to do for them.
+    heap_->GetLargeObjectsSpace()->CopyLiveToMarked();
+  }
   MarkZygoteLargeObjects();
   MarkRoots(
         static_cast<VisitRootFlags>(kVisitRootFlagAllRoots | kVisitRootFlagStartLoggingNewRoots));
@@ -4417,26 +4772,41 @@ size_t MarkCompact::LiveWordsBitmap<kAlignment>::LiveBytesInBitmapWord(size_t ch
   return words * kAlignment;
 }
 
-void MarkCompact::UpdateLivenessInfo(mirror::Object* obj, size_t obj_size) {
+template <bool kParallel>
+void MarkCompact::UpdateLivenessInfo(mirror::Object* obj,
+                                     size_t obj_size,
+                                     mirror::Class** walk_super_class_cache) {
   DCHECK(obj != nullptr);
   DCHECK_EQ(obj_size, obj->SizeOf<kDefaultVerifyFlags>());
   uintptr_t obj_begin = reinterpret_cast<uintptr_t>(obj);
-  UpdateClassAfterObjectMap(obj);
+  UpdateClassAfterObjectMap<kParallel>(obj, walk_super_class_cache);
   size_t size = RoundUp(obj_size, kAlignment);
-  uintptr_t bit_index = live_words_bitmap_->SetLiveWords(obj_begin, size);
+  uintptr_t bit_index = live_words_bitmap_->SetLiveWords<kParallel>(obj_begin, size);
   size_t chunk_idx = (obj_begin - live_words_bitmap_->Begin()) / kOffsetChunkSize;
   // Compute the bit-index within the chunk-info vector word.
   bit_index %= kBitsPerVectorWord;
   size_t first_chunk_portion = std::min(size, (kBitsPerVectorWord - bit_index) * kAlignment);
+  // The first and the last chunks may be shared with other objects. The
+  // intermediate ones, if any, are fully covered by this object.
+  auto add_to_chunk = [this](size_t idx, uint32_t bytes) {
+    if (kParallel) {
+      reinterpret_cast<Atomic<uint32_t>*>(&chunk_info_vec_[idx])
+          ->fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+      chunk_info_vec_[idx] += bytes;
+    }
+  };
 
-  chunk_info_vec_[chunk_idx++] += first_chunk_portion;
+  add_to_chunk(chunk_idx++, first_chunk_portion);
   DCHECK_LE(first_chunk_portion, size);
   for (size -= first_chunk_portion; size > kOffsetChunkSize; size -= kOffsetChunkSize) {
     DCHECK_EQ(chunk_info_vec_[chunk_idx], 0u);
     chunk_info_vec_[chunk_idx++] = kOffsetChunkSize;
   }
-  chunk_info_vec_[chunk_idx] += size;
-  freed_objects_--;
+  add_to_chunk(chunk_idx, size);
+  if (!kParallel) {
+    freed_objects_--;
+  }
 }
 
 template <bool kUpdateLiveWords>
@@ -4450,14 +4820,204 @@ void MarkCompact::ScanObject(mirror::Object* obj) {
   RefFieldsVisitor visitor(this);
   DCHECK(IsMarked(obj)) << "Scanning marked object " << obj << "\n" << heap_->DumpSpaces();
   if (kUpdateLiveWords && HasAddress(obj)) {
-    UpdateLivenessInfo(obj, obj_size);
+    UpdateLivenessInfo</*kParallel*/ false>(obj, obj_size, &walk_super_class_cache_);
   }
   obj->VisitReferences(visitor, visitor);
 }
 
+// A chunk of marking work executed by a thread-pool worker (or the gc-thread).
+// Each task drains its own local mark-stack. When the local mark-stack
+// overflows, half of it is handed back to the thread-pool as a new task, which
+// any idle worker can pick up. All the marking-related data structures which
+// may be shared with other tasks are updated atomically.
+class MarkCompact::MarkStackTask : public Task {
+ public:
+  MarkStackTask(ThreadPool* thread_pool,
+                MarkCompact* collector,
+                size_t mark_stack_size,
+                StackReference<mirror::Object>* mark_stack)
+      : collector_(collector),
+        thread_pool_(thread_pool),
+        mark_stack_pos_(mark_stack_size),
+        walk_super_class_cache_(nullptr),
+        bytes_scanned_(0),
+        live_objects_(0) {
+    // We may have to copy part of an existing mark stack when another mark stack overflows.
+    if (mark_stack_size != 0) {
+      DCHECK(mark_stack != nullptr);
+      std::copy(mark_stack, mark_stack + mark_stack_size, mark_stack_);
+    }
+  }
+
+  static constexpr size_t kMaxSize = 1 * KB;
+
+  // No thread safety analysis as the locks are held by the gc-thread on behalf
+  // of all the workers.
+  void Run(Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    RefFieldsVisitor visitor(this);
+    while (mark_stack_pos_ != 0) {
+      mirror::Object* obj = mark_stack_[--mark_stack_pos_].AsMirrorPtr();
+      DCHECK(obj != nullptr);
+      DCHECK(collector_->IsMarked(obj)) << "Scanning unmarked object " << obj;
+      size_t obj_size = obj->SizeOf<kDefaultVerifyFlags>();
+      bytes_scanned_ += obj_size;
+      if (collector_->HasAddress(obj)) {
+        collector_->UpdateLivenessInfo</*kParallel*/ true>(obj, obj_size, &walk_super_class_cache_);
+        live_objects_++;
+      }
+      obj->VisitReferences(visitor, visitor);
+    }
+    collector_->AddParallelMarkingStats(self, bytes_scanned_, live_objects_);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  class RefFieldsVisitor {
+   public:
+    ALWAYS_INLINE explicit RefFieldsVisitor(MarkStackTask* task) : task_(task) {}
+
+    ALWAYS_INLINE void operator()(mirror::Object* obj,
+                                  MemberOffset offset,
+                                  bool is_static ATTRIBUTE_UNUSED) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->Mark(obj->GetFieldObject<mirror::Object>(offset), obj, offset);
+    }
+
+    void operator()(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> ref) const ALWAYS_INLINE
+        REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->collector_->DelayReferenceReferent(klass, ref);
+    }
+
+    void VisitRootIfNonNull(mirror::CompressedReference<mirror::Object>* root) const ALWAYS_INLINE
+        REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+      if (!root->IsNull()) {
+        VisitRoot(root);
+      }
+    }
+
+    void VisitRoot(mirror::CompressedReference<mirror::Object>* root) const
+        REQUIRES(Locks::heap_bitmap_lock_)
+        REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->Mark(root->AsMirrorPtr(), /*holder=*/nullptr, MemberOffset(0));
+    }
+
+   private:
+    MarkStackTask* const task_;
+  };
+
+  ALWAYS_INLINE void Mark(mirror::Object* ref, mirror::Object* holder, MemberOffset offset)
+      REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (ref != nullptr &&
+        collector_->MarkObjectNonNullNoPush</*kParallel*/ true>(ref, holder, offset)) {
+      MarkStackPush(ref);
+    }
+  }
+
+  ALWAYS_INLINE void MarkStackPush(mirror::Object* obj) {
+    if (UNLIKELY(mark_stack_pos_ == kMaxSize)) {
+      // Mark stack overflow, give 1/2 the stack to the thread pool as a new work task.
+      mark_stack_pos_ /= 2;
+      auto* task = new MarkStackTask(thread_pool_,
+                                     collector_,
+                                     kMaxSize - mark_stack_pos_,
+                                     mark_stack_ + mark_stack_pos_);
+      thread_pool_->AddTask(Thread::Current(), task);
+    }
+    DCHECK(obj != nullptr);
+    DCHECK_LT(mark_stack_pos_, kMaxSize);
+    mark_stack_[mark_stack_pos_++].Assign(obj);
+  }
+
+  MarkCompact* const collector_;
+  ThreadPool* const thread_pool_;
+  // Thread local mark stack for this task.
+  StackReference<mirror::Object> mark_stack_[kMaxSize];
+  // Mark stack position.
+  size_t mark_stack_pos_;
+  // This task's cache for UpdateClassAfterObjectMap().
+  mirror::Class* walk_super_class_cache_;
+  // Statistics, which are accumulated into the collector's once the task is done.
+  uint64_t bytes_scanned_;
+  int32_t live_objects_;
+};
+
+size_t MarkCompact::GetMarkingThreadCount() const {
+  // Use less threads if we are in a background state (non jank perceptible) since we want to leave
+  // more CPU time for the foreground apps.
+  // Workers which are still being created can't run tasks during a pause, so
+  // don't use the pool until all of them are created.
+  ThreadPool* pool = heap_->GetThreadPool();
+  if (pool == nullptr ||
+      !Runtime::Current()->InJankPerceptibleProcessState() ||
+      !pool->AreWorkersCreated()) {
+    return 1;
+  }
+  size_t workers = Locks::mutator_lock_->IsExclusiveHeld(thread_running_gc_)
+                       ? heap_->GetParallelGCThreadCount()
+                       : heap_->GetConcGCThreadCount();
+  return std::min(workers, pool->GetThreadCount()) + 1;
+}
+
+void MarkCompact::MaybeCreateMarkingThreadPool() {
+  // Zygote must not have any threads other than the main thread when forking,
+  // so don't use parallel marking in that case. New threads can't attach
+  // during a pause, so the pool is only created during concurrent marking.
+  Runtime* runtime = Runtime::Current();
+  if (heap_->GetThreadPool() != nullptr ||
+      runtime->IsZygote() ||
+      !runtime->InJankPerceptibleProcessState() ||
+      Locks::mutator_lock_->IsExclusiveHeld(thread_running_gc_)) {
+    return;
+  }
+  heap_->CreateThreadPool();
+}
+
+void MarkCompact::AddParallelMarkingStats(Thread* self,
+                                          uint64_t bytes_scanned,
+                                          int32_t live_objects) {
+  MutexLock mu(self, lock_);
+  bytes_scanned_ += bytes_scanned;
+  freed_objects_ -= live_objects;
+}
+
+void MarkCompact::ProcessMarkStackParallel(size_t thread_count) {
+  Thread* self = thread_running_gc_;
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  const size_t chunk_size = std::min(mark_stack_->Size() / thread_count + 1,
+                                     MarkStackTask::kMaxSize);
+  CHECK_GT(chunk_size, 0U);
+  // Split the current mark stack up into work tasks.
+  for (auto* it = mark_stack_->Begin(), *end = mark_stack_->End(); it < end; ) {
+    const size_t delta = std::min(static_cast<size_t>(end - it), chunk_size);
+    thread_pool->AddTask(self, new MarkStackTask(thread_pool, this, delta, it));
+    it += delta;
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /*do_work=*/true, /*may_hold_locks=*/true);
+  thread_pool->StopWorkers(self);
+  // Restore the limit as the thread-pool is also used for concurrent compaction.
+  thread_pool->SetMaxActiveWorkers(thread_pool->GetThreadCount());
+  mark_stack_->Reset();
+}
+
 // Scan anything that's on the mark stack.
 void MarkCompact::ProcessMarkStack() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  if (kParallelProcessMarkStack && mark_stack_->Size() >= kMinimumParallelMarkStackSize) {
+    size_t thread_count = GetMarkingThreadCount();
+    if (thread_count > 1) {
+      ProcessMarkStackParallel(thread_count);
+      return;
+    }
+    // Drain this mark-stack on the gc-thread while the workers get created.
+    MaybeCreateMarkingThreadPool();
+  }
   // TODO: try prefetch like in CMS
   while (!mark_stack_->IsEmpty()) {
     mirror::Object* obj = mark_stack_->PopBack();
@@ -4591,6 +5151,9 @@ mirror::Object* MarkCompact::IsMarked(mirror::Object* obj) {
     if (compacting_) {
       if (is_black) {
         return PostCompactBlackObjAddr(obj);
+      } else if (reinterpret_cast<uint8_t*>(obj) < compaction_begin_) {
+        // Old objects below compaction_begin_ are all live in a young cycle.
+        return obj;
       } else if (live_words_bitmap_->Test(obj)) {
         return PostCompactOldObjAddr(obj);
       } else {
@@ -4638,6 +5201,28 @@ void MarkCompact::DelayReferenceReferent(ObjPtr<mirror::Class> klass,
   heap_->GetReferenceProcessor()->DelayReferenceReferent(klass, ref, this);
 }
 
+void MarkCompact::UpdateOldGen() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  // In a young cycle the old objects stayed in place and are still marked.
+  uint8_t* begin = young_gen_ ? old_gen_end_ : moving_space_begin_;
+  if (young_gen_) {
+    moving_space_bitmap_->ClearRange(reinterpret_cast<mirror::Object*>(begin),
+                                     reinterpret_cast<mirror::Object*>(moving_space_end_));
+  } else {
+    moving_space_bitmap_->Clear();
+    old_gen_object_count_ = 0;
+  }
+  DCHECK_LE(begin, post_compact_live_end_);
+  // The survivors are densely packed after compaction.
+  for (uint8_t* addr = begin; addr < post_compact_live_end_;) {
+    mirror::Object* obj = reinterpret_cast<mirror::Object*>(addr);
+    moving_space_bitmap_->Set(obj);
+    addr += RoundUp(obj->SizeOf<kVerifyNone>(), kAlignment);
+    old_gen_object_count_++;
+  }
+  old_gen_end_ = post_compact_live_end_;
+}
+
 void MarkCompact::FinishPhase() {
   GetCurrentIteration()->SetScannedBytes(bytes_scanned_);
   bool is_zygote = Runtime::Current()->IsZygote();
@@ -4664,7 +5249,10 @@ void MarkCompact::FinishPhase() {
   // case we need to ensure that we don't assert on this bitmap afterwards.
   // Also, we would still need to clear it here again as we may have to use the
   // bitmap for black-allocations (see UpdateMovingSpaceBlackAllocations()).
-  moving_space_bitmap_->Clear();
+  // In generational mode it is rebuilt for the old generation below.
+  if (!use_generational_) {
+    moving_space_bitmap_->Clear();
+  }
 
   if (UNLIKELY(is_zygote && IsValidFd(uffd_))) {
     heap_->DeleteThreadPool();
@@ -4688,6 +5276,9 @@ void MarkCompact::FinishPhase() {
     ReaderMutexLock mu(thread_running_gc_, *Locks::mutator_lock_);
     WriterMutexLock mu2(thread_running_gc_, *Locks::heap_bitmap_lock_);
     heap_->ClearMarkedObjects();
+    if (use_generational_) {
+      UpdateOldGen();
+    }
   }
   std::swap(moving_to_space_fd_, moving_from_space_fd_);
   if (IsValidFd(moving_to_space_fd_)) {
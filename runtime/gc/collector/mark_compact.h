@@ -70,7 +70,7 @@ class MarkCompact final : public GarbageCollector {
   static constexpr SigbusCounterType kSigbusCounterCompactionDoneMask =
       1u << (BitSizeOf<SigbusCounterType>() - 1);
 
-  explicit MarkCompact(Heap* heap);
+  MarkCompact(Heap* heap, bool use_generational);
 
   ~MarkCompact() {}
 
@@ -96,6 +96,17 @@ class MarkCompact final : public GarbageCollector {
     return kCollectorTypeCMC;
   }
 
+  // Runs a young-generation cycle, on behalf of YoungMarkCompact. Falls back
+  // to a full-heap cycle if there is no old generation yet.
+  void RunYoungPhases() REQUIRES(!Locks::mutator_lock_, !lock_);
+  // Forget the old generation, so that the next cycle is a full-heap one.
+  // Called when the moving space is emptied outside of this collector.
+  void ResetGenerations();
+  // Returns true if `obj` is in the old generation of the generational mode.
+  bool IsInOldGen(mirror::Object* obj) const {
+    return HasAddress(obj, moving_space_begin_, old_gen_end_);
+  }
+
   Barrier& GetBarrier() {
     return gc_barrier_;
   }
@@ -136,7 +147,9 @@ class MarkCompact final : public GarbageCollector {
 
   mirror::Object* GetFromSpaceAddrFromBarrier(mirror::Object* old_ref) {
     CHECK(compacting_);
-    if (HasAddress(old_ref)) {
+    // In a young cycle only the young pages (and the old page preceding them)
+    // are copied to from-space. Old objects below are read in place.
+    if (HasAddress(old_ref, from_space_copy_begin_, moving_space_end_)) {
       return GetFromSpaceAddr(old_ref);
     }
     return old_ref;
@@ -209,7 +222,10 @@ class MarkCompact final : public GarbageCollector {
     // Return offset (within the indexed chunk-info) of the nth live word.
     uint32_t FindNthLiveWordOffset(size_t chunk_idx, uint32_t n) const;
     // Sets all bits in the bitmap corresponding to the given range. Also
-    // returns the bit-index of the first word.
+    // returns the bit-index of the first word. If kParallel is true, then the
+    // boundary words, which may be shared with other objects, are updated
+    // atomically.
+    template <bool kParallel>
     ALWAYS_INLINE uintptr_t SetLiveWords(uintptr_t begin, size_t size);
     // Count number of live words upto the given bit-index. This is to be used
     // to compute the post-compact address of an old reference.
@@ -336,6 +352,24 @@ class MarkCompact final : public GarbageCollector {
   // Compute offsets (in chunk_info_vec_) and other data structures required
   // during concurrent compaction.
   void PrepareForCompaction() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Returns true if the moving space is compacted in the compaction pause
+  // rather than concurrently, which is the case in fallback mode and in young
+  // cycles.
+  bool CompactsInPause() const { return uffd_ == kFallbackMode || young_gen_; }
+  // Used in place of KernelPreparation() in young cycles. Copies the pages to
+  // be compacted to from-space and zeroes them in the moving space.
+  void PrepareYoungCompaction() REQUIRES(Locks::mutator_lock_);
+  // Update references to young objects in the old generation below
+  // compaction_begin_. Only the objects on non-clean cards can have such
+  // references. The cards are left dirty only for the objects which still
+  // refer to objects that are young for the next cycle.
+  void UpdateOldGenRefs() REQUIRES(Locks::mutator_lock_);
+  // Move the card marks of compacted objects to their post-compact addresses,
+  // so that the card table remains a remembered set for the next young cycle.
+  void UpdateCardTableAfterCompaction() REQUIRES(Locks::mutator_lock_);
+  // Promote all the objects that survived this cycle to the old generation by
+  // marking them in moving_space_bitmap_ and moving old_gen_end_ past them.
+  void UpdateOldGen() REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::heap_bitmap_lock_);
 
   // Copy kPageSize live bytes starting from 'offset' (within the moving space),
   // which must be within 'obj', into the kPageSize sized memory pointed by 'addr'.
@@ -436,6 +470,20 @@ class MarkCompact final : public GarbageCollector {
   // Go through all the objects in the mark-stack until it's empty.
   void ProcessMarkStack() override REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
+  // Split the mark-stack into tasks and drain them using the heap's thread
+  // pool. 'thread_count' includes the gc-thread.
+  void ProcessMarkStackParallel(size_t thread_count) REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_);
+  // Returns the number of threads, including the gc-thread, to be used for
+  // marking. Returns 1 if marking shouldn't be performed in parallel.
+  size_t GetMarkingThreadCount() const;
+  // Create the heap's thread-pool the first time parallel marking would be
+  // used, if it can be created at this point. The pool is used once its
+  // workers are created.
+  void MaybeCreateMarkingThreadPool();
+  // Accumulate the statistics gathered by a parallel marking task.
+  void AddParallelMarkingStats(Thread* self, uint64_t bytes_scanned, int32_t live_objects)
+      REQUIRES(!lock_);
   void ExpandMarkStack() REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
 
@@ -451,8 +499,13 @@ class MarkCompact final : public GarbageCollector {
 
   // Update the live-words bitmap as well as add the object size to the
   // chunk-info vector. Both are required for computation of post-compact addresses.
-  // Also updates freed_objects_ counter.
-  void UpdateLivenessInfo(mirror::Object* obj, size_t obj_size)
+  // Also updates freed_objects_ counter, unless kParallel is true, in which case
+  // the caller is responsible for it (see AddParallelMarkingStats()).
+  // 'walk_super_class_cache' is the caller's cache for UpdateClassAfterObjectMap().
+  template <bool kParallel>
+  void UpdateLivenessInfo(mirror::Object* obj,
+                          size_t obj_size,
+                          mirror::Class** walk_super_class_cache)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   void ProcessReferences(Thread* self)
@@ -536,8 +589,17 @@ class MarkCompact final : public GarbageCollector {
 
   bool IsValidFd(int fd) const { return fd >= 0; }
   // Add/update <class, obj> pair if class > obj and obj is the lowest address
-  // object of class.
-  ALWAYS_INLINE void UpdateClassAfterObjectMap(mirror::Object* obj)
+  // object of class. If kParallel is true, then the maps are updated with lock_
+  // held. 'walk_super_class_cache' points to the last class with kClassWalkSuper
+  // in reference bitmap but all its super classes lower in address order than
+  // itself. Each marking task has its own, as it is read without lock_.
+  template <bool kParallel>
+  ALWAYS_INLINE void UpdateClassAfterObjectMap(mirror::Object* obj,
+                                               mirror::Class** walk_super_class_cache)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  void UpdateClassAfterObjectMapSlowPath(mirror::Object* obj,
+                                         mirror::Class* klass,
+                                         mirror::Class** walk_super_class_cache)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Updates 'class_after_obj_map_' map by updating the keys (class) with its
@@ -581,8 +643,9 @@ class MarkCompact final : public GarbageCollector {
   // Every object inside the immune spaces is assumed to be marked.
   ImmuneSpaces immune_spaces_;
   // Required only when mark-stack is accessed in shared mode, which happens
-  // when collecting thread-stack roots using checkpoint. Otherwise, we use it
-  // to synchronize on updated_roots_ in debug-builds.
+  // when collecting thread-stack roots using checkpoint, and for the
+  // class-after-object maps and statistics during parallel marking. Otherwise,
+  // we use it to synchronize on updated_roots_ in debug-builds.
   Mutex lock_;
   accounting::ObjectStack* mark_stack_;
   // Special bitmap wherein all the bits corresponding to an object are set.
@@ -688,6 +751,7 @@ class MarkCompact final : public GarbageCollector {
   ObjObjOrderedMap::const_reverse_iterator class_after_obj_iter_;
   // Cached reference to the last class which has kClassWalkSuper in reference
   // bitmap but has all its super classes lower address order than itself.
+  // Only used by the gc-thread, parallel marking tasks have their own.
   mirror::Class* walk_super_class_cache_;
   // Used by FreeFromSpacePages() for maintaining markers in the moving space for
   // how far the pages have been reclaimed/checked.
@@ -753,6 +817,22 @@ class MarkCompact final : public GarbageCollector {
   // End of compacted space. Use for computing post-compact addr of black
   // allocated objects. Aligned up to page size.
   uint8_t* post_compact_end_;
+  // Page from which the moving space is compacted in this cycle. It is
+  // moving_space_begin_ except in young cycles, wherein the objects below it
+  // stay in place.
+  uint8_t* compaction_begin_;
+  // Beginning of the portion of the moving space which has a from-space copy
+  // during compaction.
+  uint8_t* from_space_copy_begin_;
+  // End of the old generation in the moving space when generational mode is
+  // used. The objects below it survived the previous cycle and remain marked
+  // in moving_space_bitmap_ across cycles.
+  uint8_t* old_gen_end_;
+  // Number of objects in [moving_space_begin_, old_gen_end_).
+  int32_t old_gen_object_count_;
+  // Post-compact end of the objects that survived this cycle, which becomes
+  // old_gen_end_ in FinishPhase().
+  uint8_t* post_compact_live_end_;
   // Cache (black_allocations_begin_ - post_compact_end_) for post-compact
   // address computations.
   ptrdiff_t black_objs_slide_diff_;
@@ -797,6 +877,10 @@ class MarkCompact final : public GarbageCollector {
   uint8_t thread_pool_counter_;
   // True while compacting.
   bool compacting_;
+  // Whether young-generation cycles are enabled.
+  const bool use_generational_;
+  // True during a young-generation cycle.
+  bool young_gen_;
   // Flag indicating whether one-time uffd initialization has been done. It will
   // be false on the first GC for non-zygote processes, and always for zygote.
   // Its purpose is to minimize the userfaultfd overhead to the minimal in
@@ -826,6 +910,7 @@ class MarkCompact final : public GarbageCollector {
   class ThreadFlipVisitor;
   class VerifyRootMarkedVisitor;
   class ScanObjectVisitor;
+  class MarkStackTask;
   class CheckpointMarkThreadRoots;
   template <size_t kBufferSize>
   class ThreadRootsVisitor;
@@ -836,10 +921,94 @@ class MarkCompact final : public GarbageCollector {
   class LinearAllocPageUpdater;
   class ImmuneSpaceUpdateObjVisitor;
   class ConcurrentCompactionGcTask;
+  class OldGenRefsUpdateVisitor;
+
+  friend class YoungMarkCompact;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MarkCompact);
 };
 
+// The young-generation collector of the generational mode. It shares all the
+// state with the main MarkCompact instance and only exists to have separate
+// GC-type and timings/metrics for young cycles.
+class YoungMarkCompact final : public GarbageCollector {
+ public:
+  YoungMarkCompact(Heap* heap, MarkCompact* main);
+
+  void RunPhases() override REQUIRES(!Locks::mutator_lock_, !main_->lock_);
+
+  GcType GetGcType() const override {
+    return kGcTypeSticky;
+  }
+
+  CollectorType GetCollectorType() const override {
+    return kCollectorTypeCMC;
+  }
+
+  // The visitors below are not expected to be called on this collector, as
+  // the runtime is always handed the main one. Forward them just in case.
+  mirror::Object* MarkObject(mirror::Object* obj) override
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_) {
+    return main_->MarkObject(obj);
+  }
+
+  void MarkHeapReference(mirror::HeapReference<mirror::Object>* obj,
+                         bool do_atomic_update) override
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_) {
+    main_->MarkHeapReference(obj, do_atomic_update);
+  }
+
+  void VisitRoots(mirror::Object*** roots,
+                  size_t count,
+                  const RootInfo& info) override
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_) {
+    main_->VisitRoots(roots, count, info);
+  }
+  void VisitRoots(mirror::CompressedReference<mirror::Object>** roots,
+                  size_t count,
+                  const RootInfo& info) override
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_) {
+    main_->VisitRoots(roots, count, info);
+  }
+
+  bool IsNullOrMarkedHeapReference(mirror::HeapReference<mirror::Object>* obj,
+                                   bool do_atomic_update) override
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_) {
+    return main_->IsNullOrMarkedHeapReference(obj, do_atomic_update);
+  }
+
+  void RevokeAllThreadLocalBuffers() override {
+    main_->RevokeAllThreadLocalBuffers();
+  }
+
+  void DelayReferenceReferent(ObjPtr<mirror::Class> klass,
+                              ObjPtr<mirror::Reference> reference) override
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    main_->DelayReferenceReferent(klass, reference);
+  }
+
+  mirror::Object* IsMarked(mirror::Object* obj) override
+      REQUIRES_SHARED(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    return main_->IsMarked(obj);
+  }
+
+  void ProcessMarkStack() override
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_) {
+    main_->ProcessMarkStack();
+  }
+
+ private:
+  MarkCompact* const main_;
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(YoungMarkCompact);
+};
+
 std::ostream& operator<<(std::ostream& os, MarkCompact::PageState value);
 std::ostream& operator<<(std::ostream& os, MarkCompact::ClampInfoStatus value);
 
@@ -295,6 +295,7 @@ Heap::Heap(size_t initial_size,
            bool measure_gc_performance,
            bool use_homogeneous_space_compaction_for_oom,
            bool use_generational_cc,
+           bool use_generational_cmc,
            uint64_t min_interval_homogeneous_space_compaction_by_oom,
            bool dump_region_info_before_gc,
            bool dump_region_info_after_gc)
@@ -379,6 +380,7 @@ Heap::Heap(size_t initial_size,
       verify_object_mode_(kVerifyObjectModeDisabled),
       disable_moving_gc_count_(0),
       semi_space_collector_(nullptr),
+      young_mark_compact_(nullptr),
       active_concurrent_copying_collector_(nullptr),
       young_concurrent_copying_collector_(nullptr),
       concurrent_copying_collector_(nullptr),
@@ -394,6 +396,7 @@ Heap::Heap(size_t initial_size,
       pending_heap_trim_(nullptr),
       use_homogeneous_space_compaction_for_oom_(use_homogeneous_space_compaction_for_oom),
       use_generational_cc_(use_generational_cc),
+      use_generational_cmc_(use_generational_cmc),
       running_collection_is_blocking_(false),
       blocking_gc_count_(0U),
       blocking_gc_time_(0U),
@@ -778,8 +781,12 @@ Heap::Heap(size_t initial_size,
       garbage_collectors_.push_back(semi_space_collector_);
     }
     if (MayUseCollector(kCollectorTypeCMC)) {
-      mark_compact_ = new collector::MarkCompact(this);
+      mark_compact_ = new collector::MarkCompact(this, use_generational_cmc_);
       garbage_collectors_.push_back(mark_compact_);
+      if (use_generational_cmc_) {
+        young_mark_compact_ = new collector::YoungMarkCompact(this, mark_compact_);
+        garbage_collectors_.push_back(young_mark_compact_);
+      }
     }
     if (MayUseCollector(kCollectorTypeCC)) {
       concurrent_copying_collector_ = new collector::ConcurrentCopying(this,
@@ -2260,6 +2267,9 @@ void Heap::ChangeCollector(CollectorType collector_type) {
         break;
       }
       case kCollectorTypeCMC: {
+        if (use_generational_cmc_) {
+          gc_plan_.push_back(collector::kGcTypeSticky);
+        }
         gc_plan_.push_back(collector::kGcTypeFull);
         if (use_tlab_) {
           ChangeAllocator(kAllocatorTypeTLAB);
@@ -2501,6 +2511,10 @@ void Heap::PreZygoteFork() {
         region_space_->GetMarkBitmap()->Clear();
       } else {
         bump_pointer_space_->GetMemMap()->Protect(PROT_READ | PROT_WRITE);
+        if (young_mark_compact_ != nullptr) {
+          // Evacuated everything out of the moving space, drop the old generation.
+          mark_compact_->ResetGenerations();
+        }
       }
     }
     if (temp_space_ != nullptr) {
@@ -2780,7 +2794,11 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
         collector = semi_space_collector_;
         break;
       case kCollectorTypeCMC:
-        collector = mark_compact_;
+        if (young_mark_compact_ != nullptr && gc_type == collector::kGcTypeSticky) {
+          collector = young_mark_compact_;
+        } else {
+          collector = mark_compact_;
+        }
         break;
       case kCollectorTypeCC:
         collector::ConcurrentCopying* active_cc_collector;
@@ -3726,6 +3744,10 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
       }
       CHECK(non_sticky_collector != nullptr);
     }
+    if (non_sticky_collector == nullptr && young_mark_compact_ != nullptr) {
+      // The mark-compact collector has no partial collection.
+      non_sticky_collector = mark_compact_;
+    }
     double sticky_gc_throughput_adjustment = GetStickyGcThroughputAdjustment(use_generational_cc_);
 
     // If the throughput of the current sticky GC >= throughput of the non sticky collector, then
@@ -15,18 +15,25 @@
  */
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
+#include "art_field-inl.h"
 #include "base/metrics/metrics.h"
 #include "class_linker-inl.h"
 #include "common_runtime_test.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/accounting/space_bitmap-inl.h"
+#include "gc/collector/mark_compact.h"
 #include "handle_scope-inl.h"
+#include "mirror/class-alloc-inl.h"
 #include "mirror/class-inl.h"
+#include "mirror/class_loader.h"
 #include "mirror/object-inl.h"
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art {
 namespace gc {
@@ -140,6 +147,8 @@ TEST_F(HeapTest, GCMetrics) {
   metrics::MetricsBase<uint64_t>* full_gc_freed_bytes_delta = metrics->FullGcFreedBytesDelta();
   metrics::MetricsBase<uint64_t>* full_gc_duration = metrics->FullGcDuration();
   metrics::MetricsBase<uint64_t>* full_gc_duration_delta = metrics->FullGcDurationDelta();
+  metrics::MetricsBase<int64_t>* full_gc_pause_time = metrics->FullGcPauseTime();
+  metrics::MetricsBase<int64_t>* full_gc_sweeping_time = metrics->FullGcSweepingTime();
   // ART young-generation GC metrics.
   metrics::MetricsBase<int64_t>* young_gc_collection_time = metrics->YoungGcCollectionTime();
   metrics::MetricsBase<uint64_t>* young_gc_count = metrics->YoungGcCount();
@@ -156,6 +165,8 @@ TEST_F(HeapTest, GCMetrics) {
   metrics::MetricsBase<uint64_t>* young_gc_freed_bytes_delta = metrics->YoungGcFreedBytesDelta();
   metrics::MetricsBase<uint64_t>* young_gc_duration = metrics->YoungGcDuration();
   metrics::MetricsBase<uint64_t>* young_gc_duration_delta = metrics->YoungGcDurationDelta();
+  metrics::MetricsBase<int64_t>* young_gc_pause_time = metrics->YoungGcPauseTime();
+  metrics::MetricsBase<int64_t>* young_gc_sweeping_time = metrics->YoungGcSweepingTime();
 
   CollectorType fg_collector_type = heap->GetForegroundCollectorType();
   if (fg_collector_type == kCollectorTypeCC || fg_collector_type == kCollectorTypeCMC) {
@@ -182,6 +193,8 @@ TEST_F(HeapTest, GCMetrics) {
       EXPECT_PRED2(AnyIsFalse, full_gc_freed_bytes->IsNull(), young_gc_freed_bytes->IsNull());
       EXPECT_PRED2(
           AnyIsFalse, full_gc_freed_bytes_delta->IsNull(), young_gc_freed_bytes_delta->IsNull());
+      EXPECT_PRED2(AnyIsFalse, full_gc_pause_time->IsNull(), young_gc_pause_time->IsNull());
+      EXPECT_PRED2(AnyIsFalse, full_gc_sweeping_time->IsNull(), young_gc_sweeping_time->IsNull());
       // We have observed that sometimes the GC duration (both for full-heap and
       // young-generation collections) is null (b/271112044). Temporarily
       // suspend the following checks while we investigate.
@@ -207,6 +220,8 @@ TEST_F(HeapTest, GCMetrics) {
       EXPECT_FALSE(full_gc_freed_bytes_delta->IsNull());
       EXPECT_FALSE(full_gc_duration->IsNull());
       EXPECT_FALSE(full_gc_duration_delta->IsNull());
+      EXPECT_FALSE(full_gc_pause_time->IsNull());
+      EXPECT_FALSE(full_gc_sweeping_time->IsNull());
 
       EXPECT_TRUE(young_gc_collection_time->IsNull());
       EXPECT_TRUE(young_gc_count->IsNull());
@@ -221,6 +236,8 @@ TEST_F(HeapTest, GCMetrics) {
       EXPECT_TRUE(young_gc_freed_bytes_delta->IsNull());
       EXPECT_TRUE(young_gc_duration->IsNull());
       EXPECT_TRUE(young_gc_duration_delta->IsNull());
+      EXPECT_TRUE(young_gc_pause_time->IsNull());
+      EXPECT_TRUE(young_gc_sweeping_time->IsNull());
     }
   } else {
     // Check that all metrics are null after trigerring the collection.
@@ -237,6 +254,8 @@ TEST_F(HeapTest, GCMetrics) {
     EXPECT_TRUE(full_gc_freed_bytes_delta->IsNull());
     EXPECT_TRUE(full_gc_duration->IsNull());
     EXPECT_TRUE(full_gc_duration_delta->IsNull());
+    EXPECT_TRUE(full_gc_pause_time->IsNull());
+    EXPECT_TRUE(full_gc_sweeping_time->IsNull());
 
     EXPECT_TRUE(young_gc_collection_time->IsNull());
     EXPECT_TRUE(young_gc_count->IsNull());
@@ -251,6 +270,8 @@ TEST_F(HeapTest, GCMetrics) {
     EXPECT_TRUE(young_gc_freed_bytes_delta->IsNull());
     EXPECT_TRUE(young_gc_duration->IsNull());
     EXPECT_TRUE(young_gc_duration_delta->IsNull());
+    EXPECT_TRUE(young_gc_pause_time->IsNull());
+    EXPECT_TRUE(young_gc_sweeping_time->IsNull());
   }
 }
 
@@ -271,5 +292,194 @@ TEST_F(ZygoteHeapTest, PreZygoteFork) {
   Runtime::Current()->GetHeap()->PreZygoteFork();
 }
 
+class GenerationalCMCHeapTest : public HeapTest {
+ public:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    HeapTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-Xgc:generational_cmc", nullptr));
+  }
+
+  static void CollectYoungGeneration(Heap* heap) {
+    heap->CollectGarbageInternal(collector::kGcTypeSticky,
+                                 kGcCauseExplicit,
+                                 /*clear_soft_references=*/ false,
+                                 heap->GetCurrentGcNum() + 1);
+  }
+};
+
+TEST_F(GenerationalCMCHeapTest, YoungGcKeepsOldToYoungReferences) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  if (!heap->GetUseGenerationalCMC()) {
+    GTEST_SKIP() << "Generational CMC is not in use";
+  }
+  if (collector::MarkCompact::GetUffdAndMinorFault().second) {
+    GTEST_SKIP() << "Young cycles run as full-heap ones with minor-fault compaction";
+  }
+  collector::MarkCompact* mark_compact = heap->MarkCompactCollector();
+  ScopedObjectAccess soa(Thread::Current());
+  Thread* self = soa.Self();
+  StackHandleScope<2> hs(self);
+  Handle<mirror::Class> c(
+      hs.NewHandle(class_linker_->FindSystemClass(self, "[Ljava/lang/Object;")));
+  ASSERT_TRUE(c != nullptr);
+  Handle<mirror::ObjectArray<mirror::Object>> old_array(
+      hs.NewHandle(mirror::ObjectArray<mirror::Object>::Alloc(self, c.Get(), 16)));
+  ASSERT_TRUE(old_array != nullptr);
+  {
+    // A full-heap cycle promotes the array to the old generation.
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    heap->CollectGarbage(/*clear_soft_references=*/ false);
+  }
+  ASSERT_TRUE(mark_compact->IsInOldGen(old_array.Get()));
+
+  // Make young objects reachable only through the old array. Storing them dirties its card,
+  // which is the only way for a young cycle to find them.
+  for (int32_t i = 0; i != old_array->GetLength(); ++i) {
+    ObjPtr<mirror::String> young =
+        mirror::String::AllocFromModifiedUtf8(self, std::to_string(i).c_str());
+    ASSERT_TRUE(young != nullptr);
+    ASSERT_FALSE(mark_compact->IsInOldGen(young.Ptr()));
+    old_array->Set(i, young);
+    // Garbage for the young cycle to reclaim between the survivors.
+    ASSERT_TRUE(mirror::String::AllocFromModifiedUtf8(self, "garbage") != nullptr);
+  }
+
+  mirror::Object* old_array_address = old_array.Get();
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    CollectYoungGeneration(heap);
+  }
+  // Old objects stay in place in a young cycle.
+  EXPECT_EQ(old_array_address, old_array.Get());
+  EXPECT_TRUE(mark_compact->IsInOldGen(old_array.Get()));
+  for (int32_t i = 0; i != old_array->GetLength(); ++i) {
+    ObjPtr<mirror::Object> survivor = old_array->Get(i);
+    ASSERT_TRUE(survivor != nullptr);
+    ASSERT_TRUE(survivor->IsString());
+    EXPECT_TRUE(survivor->AsString()->Equals(std::to_string(i).c_str()));
+    // Young survivors are promoted.
+    EXPECT_TRUE(mark_compact->IsInOldGen(survivor.Ptr()));
+  }
+
+  // The promoted objects and their references survive a second young cycle too.
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    CollectYoungGeneration(heap);
+  }
+  EXPECT_EQ(old_array_address, old_array.Get());
+  for (int32_t i = 0; i != old_array->GetLength(); ++i) {
+    ObjPtr<mirror::Object> survivor = old_array->Get(i);
+    ASSERT_TRUE(survivor != nullptr);
+    EXPECT_TRUE(survivor->AsString()->Equals(std::to_string(i).c_str()));
+  }
+}
+
+class ParallelMarkingCMCHeapTest : public HeapTest {
+ public:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    HeapTest::SetUpRuntimeOptions(options);
+    // Have more than one marking worker regardless of the number of cores.
+    options->push_back(std::make_pair("-XX:ParallelGCThreads=4", nullptr));
+    options->push_back(std::make_pair("-XX:ConcGCThreads=4", nullptr));
+  }
+};
+
+TEST_F(ParallelMarkingCMCHeapTest, MarkDeepClassHierarchy) {
+  // Level<i> has the reference fields of Level<i - 1> and four more. From Level8 on, visiting
+  // the references of an object requires walking the super classes.
+  static constexpr size_t kNumLevels = 12;
+  static constexpr size_t kFirstWalkSuperLevel = 8;
+  static constexpr size_t kFieldsPerLevel = 4;
+  static constexpr size_t kNumObjects = 4096;
+  if (!gUseUserfaultfd) {
+    GTEST_SKIP() << "MarkCompact is not in use";
+  }
+  Heap* heap = Runtime::Current()->GetHeap();
+  Thread* self = Thread::Current();
+  ASSERT_TRUE(Runtime::Current()->InJankPerceptibleProcessState());
+  // The thread-pool is otherwise only created once a large enough mark-stack is seen.
+  heap->CreateThreadPool();
+  heap->WaitForWorkersToBeCreated();
+  ASSERT_TRUE(heap->GetThreadPool() != nullptr);
+  ASSERT_GT(heap->GetThreadPool()->GetThreadCount(), 1u);
+
+  ScopedObjectAccess soa(self);
+  jobject jclass_loader = LoadDex("DeepHierarchy");
+  VariableSizedHandleScope hs(self);
+  Handle<mirror::ClassLoader> class_loader(
+      hs.NewHandle(soa.Decode<mirror::ClassLoader>(jclass_loader)));
+  std::vector<Handle<mirror::Class>> classes;
+  std::vector<ArtField*> fields;
+  for (size_t level = 0; level != kNumLevels; ++level) {
+    std::string descriptor = "LLevel" + std::to_string(level) + ";";
+    classes.push_back(
+        hs.NewHandle(class_linker_->FindClass(self, descriptor.c_str(), class_loader)));
+    ASSERT_TRUE(classes.back() != nullptr) << descriptor;
+    for (ArtField& field : classes.back()->GetIFields()) {
+      fields.push_back(&field);
+    }
+    ASSERT_EQ((level + 1u) * kFieldsPerLevel, fields.size());
+    EXPECT_EQ(level >= kFirstWalkSuperLevel,
+              classes.back()->GetReferenceInstanceOffsets() == mirror::Class::kClassWalkSuper)
+        << descriptor;
+  }
+
+  // Even objects are of the walk-super classes and are held by handles, so that marking the
+  // roots fills the mark-stack enough for it to be drained in parallel. Odd objects are only
+  // reachable through the last field of the previous even object.
+  auto level_of = [](size_t index) {
+    return (index % 2u == 0u)
+        ? kFirstWalkSuperLevel + (index / 2u) % (kNumLevels - kFirstWalkSuperLevel)
+        : (index / 2u) % kNumLevels;
+  };
+  auto last_field_of = [&](size_t index) {
+    return fields[(level_of(index) + 1u) * kFieldsPerLevel - 1u];
+  };
+  std::vector<Handle<mirror::Object>> roots;
+  auto get = [&](size_t index) REQUIRES_SHARED(Locks::mutator_lock_) {
+    return (index % 2u == 0u)
+        ? roots[index / 2u].Get()
+        : last_field_of(index - 1u)->GetObject(roots[index / 2u].Get()).Ptr();
+  };
+  for (size_t i = 0; i != kNumObjects; i += 2u) {
+    roots.push_back(hs.NewHandle(classes[level_of(i)]->AllocObject(self)));
+    ASSERT_TRUE(roots.back() != nullptr);
+    ObjPtr<mirror::Object> odd = classes[level_of(i + 1u)]->AllocObject(self);
+    ASSERT_TRUE(odd != nullptr);
+    last_field_of(i)->SetObject</*kTransactionActive=*/ false>(roots.back().Get(), odd);
+  }
+  // Every other field refers to an even object.
+  for (size_t i = 0; i != kNumObjects; ++i) {
+    mirror::Object* obj = get(i);
+    size_t num_fields = (level_of(i) + 1u) * kFieldsPerLevel;
+    for (size_t j = 0; j != num_fields; ++j) {
+      if (i % 2u == 0u && j == num_fields - 1u) {
+        continue;
+      }
+      size_t target = (i + 2u * j + 2u - i % 2u) % kNumObjects;
+      fields[j]->SetObject</*kTransactionActive=*/ false>(obj, get(target));
+    }
+  }
+
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    heap->CollectGarbage(/*clear_soft_references=*/ false);
+  }
+
+  // All the objects survived and were compacted with their references updated.
+  for (size_t i = 0; i != kNumObjects; ++i) {
+    mirror::Object* obj = get(i);
+    ASSERT_TRUE(obj != nullptr) << i;
+    ASSERT_OBJ_PTR_EQ(classes[level_of(i)].Get(), obj->GetClass());
+    size_t num_fields = (level_of(i) + 1u) * kFieldsPerLevel;
+    for (size_t j = 0; j != num_fields; ++j) {
+      size_t target = (i % 2u == 0u && j == num_fields - 1u)
+          ? i + 1u
+          : (i + 2u * j + 2u - i % 2u) % kNumObjects;
+      ASSERT_OBJ_PTR_EQ(get(target), fields[j]->GetObject(obj)) << i << " " << j;
+    }
+  }
+}
+
 }  // namespace gc
 }  // namespace art
@@ -32,11 +32,18 @@
 #include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
+#include <zlib.h>
 
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
+#include <android-base/strings.h>
 
 #include "art_field-inl.h"
 #include "art_method-inl.h"
@@ -413,6 +420,166 @@ class FileEndianOutput final : public EndianOutputBuffered {
   bool errors_;
 };
 
+// Writes a gzip-compressed dump. Records are copied into a fixed ring of buffers which a
+// background thread compresses and writes out, so memory use does not depend on the heap size
+// and compression overlaps with walking the heap. The dumping thread only blocks when the
+// compressor falls behind by the whole ring.
+class GzipFileEndianOutput final : public EndianOutputBuffered {
+ public:
+  GzipFileEndianOutput(File* fp, size_t reserved_size)
+      : EndianOutputBuffered(reserved_size), fp_(fp) {
+    DCHECK(fp != nullptr);
+    for (Chunk& chunk : ring_) {
+      chunk.data.reset(new uint8_t[kChunkSize]);
+    }
+    compressed_.reset(new uint8_t[kChunkSize]);
+    zstream_.zalloc = Z_NULL;
+    zstream_.zfree = Z_NULL;
+    zstream_.opaque = Z_NULL;
+    // Add 16 to the window bits to produce a gzip header and trailer.
+    errors_ = deflateInit2(&zstream_,
+                           Z_BEST_SPEED,
+                           Z_DEFLATED,
+                           MAX_WBITS + 16,
+                           MAX_MEM_LEVEL,
+                           Z_DEFAULT_STRATEGY) != Z_OK;
+    if (errors_) {
+      error_code_ = EIO;
+    } else {
+      compressor_ = std::thread([this]() { CompressLoop(); });
+    }
+  }
+
+  ~GzipFileEndianOutput() {
+    Finish();
+  }
+
+  // Compress the remaining data and wait for the compressor. Returns false on any error.
+  bool Finish() {
+    if (compressor_.joinable()) {
+      PublishChunk();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+      }
+      cond_.notify_all();
+      compressor_.join();
+      deflateEnd(&zstream_);
+    }
+    return !errors_;
+  }
+
+  // The errno value describing the first error. The failing write may have happened on the
+  // compressor thread, so the dumping thread's errno does not describe it.
+  int ErrorCode() const {
+    return error_code_;
+  }
+
+ protected:
+  void HandleFlush(const uint8_t* buffer, size_t length) override {
+    if (UNLIKELY(!compressor_.joinable())) {
+      return;  // Failed to initialize the compressor.
+    }
+    while (length != 0u) {
+      Chunk& chunk = ring_[produced_ % kNumChunks];
+      size_t count = std::min(length, kChunkSize - chunk.size);
+      memcpy(chunk.data.get() + chunk.size, buffer, count);
+      chunk.size += count;
+      buffer += count;
+      length -= count;
+      if (chunk.size == kChunkSize) {
+        PublishChunk();
+      }
+    }
+  }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size = 0u;
+  };
+
+  // Hand the chunk being filled to the compressor and wait for a free one.
+  void PublishChunk() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (ring_[produced_ % kNumChunks].size != 0u) {
+      ++produced_;
+      cond_.notify_all();
+    }
+    cond_.wait(lock, [this]() { return produced_ - consumed_ < kNumChunks; });
+  }
+
+  void CompressLoop() {
+    while (true) {
+      Chunk* chunk;
+      bool finish;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return consumed_ != produced_ || finished_; });
+        finish = (consumed_ == produced_);
+        chunk = finish ? nullptr : &ring_[consumed_ % kNumChunks];
+      }
+      if (finish) {
+        Deflate(nullptr, 0u, Z_FINISH);
+        return;
+      }
+      Deflate(chunk->data.get(), chunk->size, Z_NO_FLUSH);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunk->size = 0u;
+        ++consumed_;
+      }
+      cond_.notify_all();
+    }
+  }
+
+  // Only called on the compressor thread.
+  void Deflate(const uint8_t* data, size_t length, int flush) {
+    if (errors_) {
+      return;
+    }
+    zstream_.next_in = const_cast<uint8_t*>(data);
+    zstream_.avail_in = length;
+    int result;
+    do {
+      zstream_.next_out = compressed_.get();
+      zstream_.avail_out = kChunkSize;
+      result = deflate(&zstream_, flush);
+      if (result == Z_STREAM_ERROR) {
+        errors_ = true;
+        error_code_ = EIO;
+        return;
+      }
+      size_t compressed_size = kChunkSize - zstream_.avail_out;
+      if (compressed_size != 0u && !fp_->WriteFully(compressed_.get(), compressed_size)) {
+        errors_ = true;
+        error_code_ = errno;
+        return;
+      }
+    } while (zstream_.avail_out == 0u || (flush == Z_FINISH && result != Z_STREAM_END));
+  }
+
+  static constexpr size_t kNumChunks = 4u;
+  static constexpr size_t kChunkSize = 1 * MB;
+
+  File* fp_;
+  z_stream zstream_;
+  // Written by the compressor thread, read by the dumping thread after joining it.
+  bool errors_ = false;
+  int error_code_ = 0;
+
+  std::array<Chunk, kNumChunks> ring_;
+  std::unique_ptr<uint8_t[]> compressed_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  // Number of chunks handed to and finished by the compressor. Guarded by `mutex_`.
+  size_t produced_ = 0u;
+  size_t consumed_ = 0u;
+  bool finished_ = false;
+  std::thread compressor_;
+};
+
 class VectorEndianOuputput final : public EndianOutputBuffered {
  public:
   VectorEndianOuputput(std::vector<uint8_t>& data, size_t reserved_size)
@@ -439,6 +606,8 @@ class Hprof : public SingleRootVisitor {
         fd_(fd),
         direct_to_ddms_(direct_to_ddms) {
     LOG(INFO) << "hprof: heap dump \"" << filename_ << "\" starting...";
+    // Dumps to files ending in ".gz" are compressed while they are written.
+    compress_ = !direct_to_ddms && android::base::EndsWith(filename_, ".gz");
   }
 
   void Dump()
@@ -777,7 +946,19 @@ class Hprof : public SingleRootVisitor {
 
     std::unique_ptr<File> file(new File(out_fd, filename_, true));
     bool okay;
-    {
+    if (compress_) {
+      GzipFileEndianOutput gzip_output(file.get(), max_length);
+      output_ = &gzip_output;
+      ProcessHeap(true);
+      okay = gzip_output.Finish();
+      if (!okay) {
+        // Report the compressor's error below, like for uncompressed dumps.
+        errno = gzip_output.ErrorCode();
+      }
+      // The uncompressed size is expected to be less-or-equal than the first phase.
+      DCHECK_IMPLIES(okay, gzip_output.SumLength() <= overall_size);
+      output_ = nullptr;
+    } else {
       FileEndianOutput file_output(file.get(), max_length);
       output_ = &file_output;
       ProcessHeap(true);
@@ -876,6 +1057,7 @@ class Hprof : public SingleRootVisitor {
   std::string filename_;
   int fd_;
   bool direct_to_ddms_;
+  bool compress_;
 
   uint64_t start_ns_ = NanoTime();
 
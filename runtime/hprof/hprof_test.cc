@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hprof.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common_runtime_test.h"
+#include "mirror/throwable.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-current-inl.h"
+
+namespace art {
+namespace hprof {
+
+// Record tags, see hprof.cc.
+static constexpr uint8_t kTagHeapDumpSegment = 0x1C;
+static constexpr uint8_t kTagHeapDumpEnd = 0x2C;
+
+class HprofTest : public CommonRuntimeTest {
+ protected:
+  static uint32_t ReadU4(const std::vector<uint8_t>& data, size_t offset) {
+    return static_cast<uint32_t>(data[offset]) << 24 |
+           static_cast<uint32_t>(data[offset + 1]) << 16 |
+           static_cast<uint32_t>(data[offset + 2]) << 8 |
+           static_cast<uint32_t>(data[offset + 3]);
+  }
+};
+
+TEST_F(HprofTest, GzipDump) {
+  ScratchFile base;
+  std::string filename = base.GetFilename() + ".gz";
+  DumpHeap(filename.c_str(), /* fd= */ -1, /* direct_to_ddms= */ false);
+  ASSERT_FALSE(Thread::Current()->IsExceptionPending());
+
+  // Decompress the whole dump, making sure it really is gzip data.
+  gzFile gz = gzopen(filename.c_str(), "rb");
+  ASSERT_TRUE(gz != nullptr);
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> buffer(64 * KB);
+  int count;
+  while ((count = gzread(gz, buffer.data(), buffer.size())) > 0) {
+    data.insert(data.end(), buffer.begin(), buffer.begin() + count);
+  }
+  EXPECT_EQ(0, gzdirect(gz));
+  ASSERT_EQ(0, count);
+  ASSERT_EQ(Z_OK, gzclose(gz));
+  unlink(filename.c_str());
+
+  // The header: the format name, the identifier size and the time stamp.
+  const char magic[] = "JAVA PROFILE 1.0.3";
+  const size_t header_size = sizeof(magic) + 3 * sizeof(uint32_t);
+  ASSERT_GE(data.size(), header_size);
+  ASSERT_EQ(0, memcmp(data.data(), magic, sizeof(magic)));
+  EXPECT_EQ(sizeof(uint32_t), ReadU4(data, sizeof(magic)));
+
+  // The records: a tag, a time and the body length. They must exactly cover the rest of the
+  // dump, with the heap in segments and a final end record.
+  size_t offset = header_size;
+  size_t num_segments = 0u;
+  uint8_t last_tag = 0u;
+  while (offset != data.size()) {
+    ASSERT_LE(offset + 1u + 2 * sizeof(uint32_t), data.size());
+    last_tag = data[offset];
+    uint32_t length = ReadU4(data, offset + 1u + sizeof(uint32_t));
+    offset += 1u + 2 * sizeof(uint32_t);
+    ASSERT_LE(length, data.size() - offset);
+    offset += length;
+    if (last_tag == kTagHeapDumpSegment) {
+      EXPECT_NE(0u, length);
+      ++num_segments;
+    }
+  }
+  EXPECT_NE(0u, num_segments);
+  EXPECT_EQ(kTagHeapDumpEnd, last_tag);
+}
+
+TEST_F(HprofTest, GzipDumpWriteError) {
+  // Writes to /dev/full fail with ENOSPC. The failure happens on the compressor thread and
+  // must still be reported like for uncompressed dumps.
+  int fd = open("/dev/full", O_WRONLY | O_CLOEXEC);
+  if (fd < 0) {
+    GTEST_SKIP() << "No /dev/full";
+  }
+  DumpHeap("full.hprof.gz", fd, /* direct_to_ddms= */ false);
+  close(fd);
+
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  ASSERT_TRUE(self->IsExceptionPending());
+  std::string message = self->GetException()->Dump();
+  self->ClearException();
+  EXPECT_NE(std::string::npos, message.find("Couldn't dump heap")) << message;
+  EXPECT_NE(std::string::npos, message.find(strerror(ENOSPC))) << message;
+}
+
+}  // namespace hprof
+}  // namespace art
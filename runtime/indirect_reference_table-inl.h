@@ -37,7 +37,7 @@ inline bool IndirectReferenceTable::IsValidReference(IndirectRef iref,
                                                      /*out*/std::string* error_msg) const {
   DCHECK(iref != nullptr);
   DCHECK_EQ(GetIndirectRefKind(iref), kind_);
-  const uint32_t top_index = top_index_;
+  const uint32_t top_index = Capacity();
   uint32_t idx = ExtractIndex(iref);
   if (UNLIKELY(idx >= top_index)) {
     *error_msg = android::base::StringPrintf("deleted reference at index %u in a table of size %u",
@@ -45,7 +45,7 @@ inline bool IndirectReferenceTable::IsValidReference(IndirectRef iref,
                                              top_index);
     return false;
   }
-  if (UNLIKELY(table_[idx].GetReference()->IsNull())) {
+  if (UNLIKELY(table_[idx].IsFree() || table_[idx].GetReference()->IsNull())) {
     *error_msg = android::base::StringPrintf("deleted reference at index %u", idx);
     return false;
   }
@@ -82,7 +82,7 @@ template<ReadBarrierOption kReadBarrierOption>
 inline ObjPtr<mirror::Object> IndirectReferenceTable::Get(IndirectRef iref) const {
   DCHECK_EQ(GetIndirectRefKind(iref), kind_);
   uint32_t idx = ExtractIndex(iref);
-  DCHECK_LT(idx, top_index_);
+  DCHECK_LT(idx, Capacity());
   DCHECK_EQ(DecodeSerial(reinterpret_cast<uintptr_t>(iref)), table_[idx].GetSerial());
   DCHECK(!table_[idx].GetReference()->IsNull());
   ObjPtr<mirror::Object> obj = table_[idx].GetReference()->Read<kReadBarrierOption>();
@@ -93,22 +93,24 @@ inline ObjPtr<mirror::Object> IndirectReferenceTable::Get(IndirectRef iref) cons
 inline void IndirectReferenceTable::Update(IndirectRef iref, ObjPtr<mirror::Object> obj) {
   DCHECK_EQ(GetIndirectRefKind(iref), kind_);
   uint32_t idx = ExtractIndex(iref);
-  DCHECK_LT(idx, top_index_);
+  DCHECK_LT(idx, Capacity());
   DCHECK_EQ(DecodeSerial(reinterpret_cast<uintptr_t>(iref)), table_[idx].GetSerial());
   DCHECK(!table_[idx].GetReference()->IsNull());
   table_[idx].SetReference(obj);
 }
 
 inline void IrtEntry::Add(ObjPtr<mirror::Object> obj) {
-  ++serial_;
-  if (serial_ == kIRTMaxSerial) {
-    serial_ = 0;
+  uint32_t serial = GetSerial() + 1u;
+  if (serial == kIRTMaxSerial) {
+    serial = 0;
   }
   reference_ = GcRoot<mirror::Object>(obj);
+  // Clears the `kFreeBit` and the free list link.
+  state_.store(serial, std::memory_order_relaxed);
 }
 
 inline void IrtEntry::SetReference(ObjPtr<mirror::Object> obj) {
-  DCHECK_LT(serial_, kIRTMaxSerial);
+  DCHECK_LT(GetSerial(), kIRTMaxSerial);
   reference_ = GcRoot<mirror::Object>(obj);
 }
 
@@ -33,6 +33,7 @@
 #include "thread.h"
 
 #include <cstdlib>
+#include <limits>
 
 namespace art {
 
@@ -85,7 +86,8 @@ IndirectReferenceTable::IndirectReferenceTable(IndirectRefKind kind)
       kind_(kind),
       top_index_(0u),
       max_entries_(0u),
-      current_num_holes_(0) {
+      free_list_head_(0u),
+      num_free_entries_(0u) {
   CHECK_NE(kind, kJniTransition);
   CHECK_NE(kind, kLocal);
 }
@@ -146,102 +148,108 @@ void IndirectReferenceTable::ConstexprChecks() {
   static_assert((GetGlobalOrWeakGlobalMask() & EncodeIndirectRefKind(kWeakGlobal)) != 0u);
 }
 
-// Holes:
+// Free list:
 //
-// To keep the IRT compact, we want to fill "holes" created by non-stack-discipline Add & Remove
-// operation sequences. For simplicity and lower memory overhead, we do not use a free list or
-// similar. Instead, we scan for holes, with the expectation that we will find holes fast as they
-// are usually near the end of the table (see the header, TODO: verify this assumption). To avoid
-// scans when there are no holes, the number of known holes should be tracked.
-
-static size_t CountNullEntries(const IrtEntry* table, size_t to) {
-  size_t count = 0;
-  for (size_t index = 0u; index != to; ++index) {
-    if (table[index].GetReference()->IsNull()) {
-      count++;
+// Removed entries are kept on a lock-free LIFO list (a Treiber stack) so that they can be reused
+// by `Add()` without scanning the table for holes. The link to the next free entry is stored in
+// the state word of the free entry next to its serial number, so the list needs no extra memory
+// and the GC, which only looks at the references, keeps seeing the free entries as null.
+//
+// A thread popping an entry may read a stale link if the entry is concurrently popped, reused and
+// freed again by other threads. The counter in the high bits of `free_list_head_` makes its CAS
+// fail in that case.
+
+static_assert(kMaxTableSizeInBytes / sizeof(IrtEntry) < (1u << (32u - kIRTSerialBits - 1u)),
+              "Free list links do not fit in the IrtEntry state");
+
+static constexpr uint64_t kFreeListIndexMask = std::numeric_limits<uint32_t>::max();
+
+static constexpr uint64_t NewFreeListHead(uint64_t old_head, uint32_t next_free) {
+  return (((old_head >> 32) + 1u) << 32) | next_free;
+}
+
+bool IndirectReferenceTable::PopFreeEntry(/*out*/ uint32_t* table_index) {
+  uint64_t head = free_list_head_.load(std::memory_order_acquire);
+  while ((head & kFreeListIndexMask) != 0u) {
+    uint32_t index = static_cast<uint32_t>(head & kFreeListIndexMask) - 1u;
+    uint64_t new_head = NewFreeListHead(head, table_[index].GetNextFree());
+    if (free_list_head_.CompareAndSetWeakAcquire(head, new_head)) {
+      num_free_entries_.fetch_sub(1u, std::memory_order_relaxed);
+      *table_index = index;
+      return true;
     }
+    head = free_list_head_.load(std::memory_order_acquire);
   }
-  return count;
+  return false;
 }
 
-ALWAYS_INLINE
-static inline void CheckHoleCount(IrtEntry* table,
-                                  size_t exp_num_holes,
-                                  size_t top_index) {
-  if (kIsDebugBuild) {
-    size_t count = CountNullEntries(table, top_index);
-    CHECK_EQ(exp_num_holes, count) << " topIndex=" << top_index;
+void IndirectReferenceTable::PushFreeEntry(uint32_t table_index) {
+  DCHECK(table_[table_index].IsFree());
+  // Count the entry before it can be popped so that the count never underflows.
+  num_free_entries_.fetch_add(1u, std::memory_order_relaxed);
+  uint64_t head = free_list_head_.load(std::memory_order_relaxed);
+  while (true) {
+    table_[table_index].SetNextFree(static_cast<uint32_t>(head & kFreeListIndexMask));
+    // Release the link above to the thread that pops this entry.
+    if (free_list_head_.CompareAndSetWeakRelease(head, NewFreeListHead(head, table_index + 1u))) {
+      break;
+    }
+    head = free_list_head_.load(std::memory_order_relaxed);
   }
 }
 
 IndirectRef IndirectReferenceTable::Add(ObjPtr<mirror::Object> obj, std::string* error_msg) {
   if (kDebugIRT) {
-    LOG(INFO) << "+++ Add: top_index=" << top_index_
-              << " holes=" << current_num_holes_;
+    LOG(INFO) << "+++ Add: top_index=" << Capacity()
+              << " free=" << num_free_entries_.load(std::memory_order_relaxed);
   }
 
   CHECK(obj != nullptr);
   VerifyObject(obj);
   DCHECK(table_ != nullptr);
 
-  if (top_index_ == max_entries_) {
-    // TODO: Fill holes before reporting error.
-    std::ostringstream oss;
-    oss << "JNI ERROR (app bug): " << kind_ << " table overflow "
-        << "(max=" << max_entries_ << ")"
-        << MutatorLockedDumpable<IndirectReferenceTable>(*this);
-    *error_msg = oss.str();
-    return nullptr;
-  }
-
-  CheckHoleCount(table_, current_num_holes_, top_index_);
-
-  // We know there's enough room in the table.  Now we just need to find
-  // the right spot.  If there's a hole, find it and fill it; otherwise,
-  // add to the end of the list.
-  IndirectRef result;
-  size_t index;
-  if (current_num_holes_ > 0) {
-    DCHECK_GT(top_index_, 1U);
-    // Find the first hole; likely to be near the end of the list.
-    IrtEntry* p_scan = &table_[top_index_ - 1];
-    DCHECK(!p_scan->GetReference()->IsNull());
-    --p_scan;
-    while (!p_scan->GetReference()->IsNull()) {
-      DCHECK_GT(p_scan, table_);
-      --p_scan;
+  // Reuse the most recently freed entry if there is one; otherwise, add to the end of the list.
+  uint32_t index;
+  if (!PopFreeEntry(&index)) {
+    size_t top_index = top_index_.load(std::memory_order_relaxed);
+    while (true) {
+      if (top_index == max_entries_) {
+        std::ostringstream oss;
+        oss << "JNI ERROR (app bug): " << kind_ << " table overflow "
+            << "(max=" << max_entries_ << ")"
+            << MutatorLockedDumpable<IndirectReferenceTable>(*this);
+        *error_msg = oss.str();
+        return nullptr;
+      }
+      if (top_index_.CompareAndSetWeakRelaxed(top_index, top_index + 1u)) {
+        break;
+      }
+      top_index = top_index_.load(std::memory_order_relaxed);
     }
-    index = p_scan - table_;
-    current_num_holes_--;
-  } else {
-    // Add to the end.
-    index = top_index_;
-    ++top_index_;
+    index = top_index;
   }
   table_[index].Add(obj);
-  result = ToIndirectRef(index);
+  IndirectRef result = ToIndirectRef(index);
   if (kDebugIRT) {
-    LOG(INFO) << "+++ added at " << ExtractIndex(result) << " top=" << top_index_
-              << " holes=" << current_num_holes_;
+    LOG(INFO) << "+++ added at " << ExtractIndex(result) << " top=" << Capacity();
   }
 
   DCHECK(result != nullptr);
   return result;
 }
 
-// Removes an object. We extract the table offset bits from "iref"
-// and zap the corresponding entry, leaving a hole if it's not at the top.
-// Returns "false" if nothing was removed.
+// Removes an object. We extract the table offset bits from "iref", zap the corresponding entry
+// and put it on the free list. Returns "false" if nothing was removed.
 bool IndirectReferenceTable::Remove(IndirectRef iref) {
   if (kDebugIRT) {
-    LOG(INFO) << "+++ Remove: top_index=" << top_index_
-              << " holes=" << current_num_holes_;
+    LOG(INFO) << "+++ Remove: top_index=" << Capacity()
+              << " free=" << num_free_entries_.load(std::memory_order_relaxed);
   }
 
   // TODO: We should eagerly check the ref kind against the `kind_` instead of postponing until
   // `CheckEntry()` below. Passing the wrong kind shall currently result in misleading warnings.
 
-  const uint32_t top_index = top_index_;
+  const uint32_t top_index = Capacity();
 
   DCHECK(table_ != nullptr);
 
@@ -253,58 +261,26 @@ bool IndirectReferenceTable::Remove(IndirectRef iref) {
     return false;
   }
 
-  CheckHoleCount(table_, current_num_holes_, top_index_);
-
-  if (idx == top_index - 1) {
-    // Top-most entry.  Scan up and consume holes.
-
-    if (!CheckEntry("remove", iref, idx)) {
-      return false;
-    }
-
-    *table_[idx].GetReference() = GcRoot<mirror::Object>(nullptr);
-    if (current_num_holes_ != 0) {
-      uint32_t collapse_top_index = top_index;
-      while (--collapse_top_index > 0u && current_num_holes_ != 0) {
-        if (kDebugIRT) {
-          ScopedObjectAccess soa(Thread::Current());
-          LOG(INFO) << "+++ checking for hole at " << collapse_top_index - 1 << " val="
-                    << table_[collapse_top_index - 1].GetReference()->Read<kWithoutReadBarrier>();
-        }
-        if (!table_[collapse_top_index - 1].GetReference()->IsNull()) {
-          break;
-        }
-        if (kDebugIRT) {
-          LOG(INFO) << "+++ ate hole at " << (collapse_top_index - 1);
-        }
-        current_num_holes_--;
-      }
-      top_index_ = collapse_top_index;
-
-      CheckHoleCount(table_, current_num_holes_, top_index_);
-    } else {
-      top_index_ = top_index - 1;
-      if (kDebugIRT) {
-        LOG(INFO) << "+++ ate last entry " << top_index - 1;
-      }
-    }
-  } else {
-    // Not the top-most entry.  This creates a hole.  We null out the entry to prevent somebody
-    // from deleting it twice and screwing up the hole count.
-    if (table_[idx].GetReference()->IsNull()) {
-      LOG(INFO) << "--- WEIRD: removing null entry " << idx;
-      return false;
-    }
-    if (!CheckEntry("remove", iref, idx)) {
-      return false;
-    }
+  // The entry is null-ed out only once it is marked as free, to prevent somebody from deleting
+  // it twice and putting it twice on the free list.
+  IrtEntry* entry = &table_[idx];
+  if (entry->IsFree()) {
+    LOG(INFO) << "--- WEIRD: removing null entry " << idx;
+    return false;
+  }
+  if (!CheckEntry("remove", iref, idx)) {
+    return false;
+  }
+  if (!entry->MarkFree(DecodeSerial(reinterpret_cast<uintptr_t>(iref)))) {
+    // Lost a race with another thread removing the same reference.
+    LOG(INFO) << "--- WEIRD: removing null entry " << idx;
+    return false;
+  }
 
-    *table_[idx].GetReference() = GcRoot<mirror::Object>(nullptr);
-    current_num_holes_++;
-    CheckHoleCount(table_, current_num_holes_, top_index_);
-    if (kDebugIRT) {
-      LOG(INFO) << "+++ left hole at " << idx << ", holes=" << current_num_holes_;
-    }
+  *entry->GetReference() = GcRoot<mirror::Object>(nullptr);
+  PushFreeEntry(idx);
+  if (kDebugIRT) {
+    LOG(INFO) << "+++ freed entry at " << idx;
   }
 
   return true;
@@ -313,7 +289,27 @@ bool IndirectReferenceTable::Remove(IndirectRef iref) {
 void IndirectReferenceTable::Trim() {
   ScopedTrace trace(__PRETTY_FUNCTION__);
   DCHECK(table_mem_map_.IsValid());
-  const size_t top_index = Capacity();
+  // Give back the free entries at the top of the table. We have exclusive access, so we can
+  // rebuild the free list from the remaining free entries, with the lowest index on top so
+  // that the entries are reused bottom-up and the table stays compact.
+  size_t top_index = Capacity();
+  while (top_index != 0u && table_[top_index - 1u].IsFree()) {
+    --top_index;
+  }
+  uint32_t next_free = 0u;
+  size_t num_free_entries = 0u;
+  for (size_t i = top_index; i != 0u; --i) {
+    if (table_[i - 1u].IsFree()) {
+      table_[i - 1u].SetNextFree(next_free);
+      next_free = i;
+      ++num_free_entries;
+    }
+  }
+  top_index_.store(top_index, std::memory_order_relaxed);
+  free_list_head_.store(NewFreeListHead(free_list_head_.load(std::memory_order_relaxed), next_free),
+                        std::memory_order_relaxed);
+  num_free_entries_.store(num_free_entries, std::memory_order_relaxed);
+
   uint8_t* release_start = AlignUp(reinterpret_cast<uint8_t*>(&table_[top_index]), kPageSize);
   uint8_t* release_end = static_cast<uint8_t*>(table_mem_map_.BaseEnd());
   DCHECK_GE(reinterpret_cast<uintptr_t>(release_end), reinterpret_cast<uintptr_t>(release_start));
@@ -367,7 +363,7 @@ void IndirectReferenceTable::Dump(std::ostream& os) const {
 }
 
 size_t IndirectReferenceTable::FreeCapacity() const {
-  return max_entries_ - top_index_;
+  return max_entries_ - Capacity() + num_free_entries_.load(std::memory_order_relaxed);
 }
 
 }  // namespace art
@@ -25,6 +25,7 @@
 
 #include <android-base/logging.h>
 
+#include "base/atomic.h"
 #include "base/bit_utils.h"
 #include "base/locks.h"
 #include "base/macros.h"
@@ -95,14 +96,16 @@ const char* GetIndirectRefKindString(IndirectRefKind kind);
 // Table definition.
 //
 // For the global reference tables, the expected common operations are adding a new entry and
-// removing a recently-added entry (usually the most-recently-added entry).
+// removing a recently-added entry (usually the most-recently-added entry). Native code running
+// on many threads does both concurrently, so `Add()` and `Remove()` do not need exclusive access
+// to the table and can be called concurrently with each other (but not with `VisitRoots()`,
+// `SweepJniWeakGlobals()`, `Dump()` or `Trim()`, which need exclusive access).
 //
-// If we delete entries from the middle of the list, we will be left with "holes".  We track the
-// number of holes so that, when adding new elements, we can quickly decide to do a trivial append
-// or go slot-hunting.
-//
-// When the top-most entry is removed, any holes immediately below it are also removed. Thus,
-// deletion of an entry may reduce "top_index" by more than one.
+// New entries are appended by atomically bumping "top_index". Removed entries are not given back
+// to the top of the table; instead they are pushed onto a lock-free free list threaded through
+// the entries themselves and the next `Add()` pops the most recently freed entry. Thus the
+// "top_index" only grows, except in `Trim()` which gives back the free entries at the top of the
+// table and rebuilds the free list from the remaining ones.
 //
 // Common alternative implementation: make IndirectRef a pointer to the actual reference slot.
 // Instead of getting a table and doing a lookup, the lookup can be done instantly. Operations like
@@ -111,9 +114,6 @@ const char* GetIndirectRefKindString(IndirectRefKind kind);
 // the table when expanding it (so realloc() is out), and tricks like serial number checking to
 // detect stale references aren't possible (though we may be able to get similar benefits with other
 // approaches).
-//
-// TODO: consider a "lastDeleteIndex" for quick hole-filling when an add immediately follows a
-// delete.
 
 // We associate a few bits of serial number with each reference, for error checking.
 static constexpr unsigned int kIRTSerialBits = 3;
@@ -124,24 +124,51 @@ class IrtEntry {
   void Add(ObjPtr<mirror::Object> obj) REQUIRES_SHARED(Locks::mutator_lock_);
 
   GcRoot<mirror::Object>* GetReference() {
-    DCHECK_LE(serial_, kIRTMaxSerial);
     return &reference_;
   }
 
   const GcRoot<mirror::Object>* GetReference() const {
-    DCHECK_LE(serial_, kIRTMaxSerial);
     return &reference_;
   }
 
   uint32_t GetSerial() const {
-    return serial_;
+    return state_.load(std::memory_order_relaxed) & kSerialMask;
+  }
+
+  // Whether the entry has been removed and is on the free list.
+  bool IsFree() const {
+    return (state_.load(std::memory_order_relaxed) & kFreeBit) != 0u;
   }
 
   void SetReference(ObjPtr<mirror::Object> obj) REQUIRES_SHARED(Locks::mutator_lock_);
 
  private:
-  uint32_t serial_;  // Incremented for each reuse; checked against reference.
+  static constexpr uint32_t kSerialMask = (1u << kIRTSerialBits) - 1u;
+  static constexpr uint32_t kFreeBit = 1u << kIRTSerialBits;
+  static constexpr size_t kNextFreeShift = kIRTSerialBits + 1u;
+
+  // Atomically marks a live entry with the given serial number as free. Returns false if the
+  // entry is already free or has been reused, e.g. when racing with another `Remove()`.
+  bool MarkFree(uint32_t serial) {
+    return state_.CompareAndSetStrongRelaxed(serial, serial | kFreeBit);
+  }
+
+  // Link of a free entry to the next free entry, encoded as index + 1 (0 ends the list).
+  uint32_t GetNextFree() const {
+    return state_.load(std::memory_order_relaxed) >> kNextFreeShift;
+  }
+
+  void SetNextFree(uint32_t next_free) {
+    uint32_t state = state_.load(std::memory_order_relaxed) & (kSerialMask | kFreeBit);
+    state_.store(state | (next_free << kNextFreeShift), std::memory_order_relaxed);
+  }
+
+  // Serial number in the low `kIRTSerialBits`, incremented for each reuse and checked against
+  // the reference. For free entries, also the `kFreeBit` and the link to the next free entry.
+  Atomic<uint32_t> state_;
   GcRoot<mirror::Object> reference_;
+
+  friend class IndirectReferenceTable;
 };
 static_assert(sizeof(IrtEntry) == 2 * sizeof(uint32_t), "Unexpected sizeof(IrtEntry)");
 static_assert(IsPowerOfTwo(sizeof(IrtEntry)), "Unexpected sizeof(IrtEntry)");
@@ -161,6 +188,7 @@ class IndirectReferenceTable {
 
   // Add a new entry. "obj" must be a valid non-null object reference. This function will
   // return null if an error happened (with an appropriate error message set).
+  // May be called concurrently with `Add()` and `Remove()` on other threads.
   IndirectRef Add(ObjPtr<mirror::Object> obj, std::string* error_msg)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -174,11 +202,8 @@ class IndirectReferenceTable {
   // Updates an existing indirect reference to point to a new object.
   void Update(IndirectRef iref, ObjPtr<mirror::Object> obj) REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Remove an existing entry.
-  //
-  // If the entry is not between the current top index and the bottom index
-  // specified by the cookie, we don't remove anything.  This is the behavior
-  // required by JNI's DeleteLocalRef function.
+  // Remove an existing entry. May be called concurrently with `Add()` and `Remove()` on other
+  // threads.
   //
   // Returns "false" if nothing was removed.
   bool Remove(IndirectRef iref);
@@ -191,26 +216,29 @@ class IndirectReferenceTable {
     return kind_;
   }
 
-  // Return the #of entries in the entire table.  This includes holes, and
-  // so may be larger than the actual number of "live" entries.
+  // Return the #of entries in the entire table.  This includes free entries, and
+  // so may be larger than the actual number of "live" entries. Removed entries are
+  // only given back at the top of the table by `Trim()`, so use `NEntriesForGlobal()`
+  // to report how many references the table holds.
   size_t Capacity() const {
-    return top_index_;
+    return top_index_.load(std::memory_order_relaxed);
   }
 
-  // Return the number of non-null entries in the table. Only reliable for a
-  // single segment table.
-  int32_t NEntriesForGlobal() {
-    return top_index_ - current_num_holes_;
+  // Return the number of non-null entries in the table. Only an estimate when
+  // entries are being added or removed concurrently.
+  int32_t NEntriesForGlobal() const {
+    return Capacity() - num_free_entries_.load(std::memory_order_relaxed);
   }
 
-  // We'll only state here how much is trivially free, without recovering holes.
-  // Thus this is a conservative estimate.
+  // Return the number of entries that can be added before the table overflows.
+  // Only an estimate when entries are being added or removed concurrently.
   size_t FreeCapacity() const;
 
   void VisitRoots(RootVisitor* visitor, const RootInfo& root_info)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Release pages past the end of the table that may have previously held references.
+  // Give back the free entries at the top of the table and release pages past the end of the
+  // table that may have previously held references.
   void Trim() REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Determine what kind of indirect reference this is. Opposite of EncodeIndirectRefKind.
@@ -298,6 +326,12 @@ class IndirectReferenceTable {
     return DecodeIndex(reinterpret_cast<uintptr_t>(iref));
   }
 
+  // Pop an entry from the free list. Returns false if the free list is empty.
+  bool PopFreeEntry(/*out*/ uint32_t* table_index);
+
+  // Push a removed entry onto the free list.
+  void PushFreeEntry(uint32_t table_index);
+
   IndirectRef ToIndirectRef(uint32_t table_index) const {
     DCHECK_LT(table_index, max_entries_);
     uint32_t serial = table_[table_index].GetSerial();
@@ -318,16 +352,21 @@ class IndirectReferenceTable {
   // Bit mask, ORed into all irefs.
   const IndirectRefKind kind_;
 
-  // The "top of stack" index where new references are added.
-  size_t top_index_;
+  // The "top of stack" index where new references are added when the free list is empty.
+  Atomic<size_t> top_index_;
 
   // Maximum number of entries allowed.
   size_t max_entries_;
 
-  // Some values to retain old behavior with holes.
-  // Description of the algorithm is in the .cc file.
-  // TODO: Consider other data structures for compact tables, e.g., free lists.
-  size_t current_num_holes_;  // Number of holes in the current / top segment.
+  // Head of the free list: the index + 1 of the most recently freed entry (0 if the list is
+  // empty) in the low 32 bits and a counter in the high 32 bits, incremented by each update
+  // to protect the pops against ABA.
+  Atomic<uint64_t> free_list_head_;
+
+  // Number of entries on the free list.
+  Atomic<size_t> num_free_entries_;
+
+  friend class IndirectReferenceTableTest;
 };
 
 }  // namespace art
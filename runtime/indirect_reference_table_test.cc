@@ -16,6 +16,10 @@
 
 #include "indirect_reference_table-inl.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "android-base/stringprintf.h"
 
 #include "class_linker-inl.h"
@@ -23,6 +27,7 @@
 #include "mirror/class-alloc-inl.h"
 #include "mirror/object-inl.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art {
 
@@ -33,6 +38,15 @@ class IndirectReferenceTableTest : public CommonRuntimeTest {
   IndirectReferenceTableTest() {
     use_boot_image_ = true;  // Make the Runtime creation cheaper.
   }
+
+ public:
+  static uint32_t GetIndex(IndirectRef iref) {
+    return IndirectReferenceTable::ExtractIndex(iref);
+  }
+
+  static size_t GetMaxEntries(const IndirectReferenceTable& irt) {
+    return irt.max_entries_;
+  }
 };
 
 static void CheckDump(IndirectReferenceTable* irt, size_t num_objects, size_t num_unique)
@@ -104,6 +118,10 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   EXPECT_TRUE(irt.Remove(iref2));
   CheckDump(&irt, 0, 0);
 
+  // Removed entries stay in the table until it is trimmed.
+  EXPECT_EQ(3U, irt.Capacity());
+  irt.Trim();
+
   // Table should be empty now.
   EXPECT_EQ(0U, irt.Capacity());
 
@@ -128,6 +146,7 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   CheckDump(&irt, 0, 0);
 
   // Table should be empty now.
+  irt.Trim();
   ASSERT_EQ(0U, irt.Capacity());
 
   // Add three, remove middle / middle / bottom / top.  (Second attempt
@@ -156,11 +175,12 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   CheckDump(&irt, 0, 0);
 
   // Table should be empty now.
+  irt.Trim();
   ASSERT_EQ(0U, irt.Capacity());
 
   // Add four entries.  Remove #1, add new entry, verify that table size
-  // is still 4 (i.e. holes are getting filled).  Remove #1 and #3, verify
-  // that we delete one and don't hole-compact the other.
+  // is still 4 (i.e. free entries are getting reused).  Remove #1 and #3,
+  // verify that trimming gives back one and keeps the other.
   iref0 = irt.Add(obj0.Get(), &error_msg);
   EXPECT_TRUE(iref0 != nullptr);
   iref1 = irt.Add(obj1.Get(), &error_msg);
@@ -185,13 +205,16 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   ASSERT_TRUE(irt.Remove(iref3));
   CheckDump(&irt, 2, 2);
 
-  ASSERT_EQ(3U, irt.Capacity()) << "should be 3 after two deletions";
+  ASSERT_EQ(4U, irt.Capacity()) << "should be 4 after two deletions";
+  irt.Trim();
+  ASSERT_EQ(3U, irt.Capacity()) << "should be 3 after two deletions and trimming";
 
   ASSERT_TRUE(irt.Remove(iref2));
   CheckDump(&irt, 1, 1);
   ASSERT_TRUE(irt.Remove(iref0));
   CheckDump(&irt, 0, 0);
 
+  irt.Trim();
   ASSERT_EQ(0U, irt.Capacity()) << "not empty after split remove";
 
   // Add an entry, remove it, add a new entry, and try to use the original
@@ -208,6 +231,7 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   ASSERT_FALSE(irt.Remove(iref0)) << "mismatched del succeeded";
   CheckDump(&irt, 1, 1);
   ASSERT_TRUE(irt.Remove(iref1)) << "switched del failed";
+  irt.Trim();
   ASSERT_EQ(0U, irt.Capacity()) << "switching del not empty";
   CheckDump(&irt, 0, 0);
 
@@ -226,6 +250,7 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
     ASSERT_FALSE(irt.Remove(iref0)) << "temporal del succeeded";
   }
   ASSERT_TRUE(irt.Remove(iref1)) << "temporal cleanup failed";
+  irt.Trim();
   ASSERT_EQ(0U, irt.Capacity()) << "temporal del not empty";
   CheckDump(&irt, 0, 0);
 
@@ -256,13 +281,131 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
     ASSERT_TRUE(irt.Remove(manyRefs[i])) << "failed removing " << i;
     CheckDump(&irt, kTableInitial - i, 1);
   }
-  // Because of removal order, should have 11 entries, 10 of them holes.
+  // Should have 11 entries, 10 of them free, even after trimming.
+  ASSERT_EQ(kTableInitial + 1, irt.Capacity());
+  irt.Trim();
   ASSERT_EQ(kTableInitial + 1, irt.Capacity());
 
+  // Free entries are reused before the table grows.
+  for (size_t i = 0; i < kTableInitial; i++) {
+    manyRefs[i] = irt.Add(obj0.Get(), &error_msg);
+    ASSERT_TRUE(manyRefs[i] != nullptr) << "Failed re-adding " << i;
+  }
+  ASSERT_EQ(kTableInitial + 1, irt.Capacity());
+  CheckDump(&irt, kTableInitial + 1, 1);
+  for (size_t i = 0; i < kTableInitial; i++) {
+    ASSERT_TRUE(irt.Remove(manyRefs[i])) << "failed removing " << i;
+  }
+
   ASSERT_TRUE(irt.Remove(iref0)) << "multi-remove final failed";
 
+  irt.Trim();
   ASSERT_EQ(0U, irt.Capacity()) << "multi-del not empty";
   CheckDump(&irt, 0, 0);
 }
 
+// Repeatedly adds and removes references to its own object, checking that no other thread is
+// handed out the same entries at the same time.
+class AddRemoveTask : public Task {
+ public:
+  static constexpr size_t kRefsPerTask = 64;
+  static constexpr size_t kIterations = 500;
+
+  AddRemoveTask(IndirectReferenceTable* irt,
+                Handle<mirror::Object> obj,
+                std::vector<std::atomic<bool>>* entry_in_use)
+      : irt_(irt), obj_(obj), entry_in_use_(entry_in_use) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    std::string error_msg;
+    IndirectRef irefs[kRefsPerTask];
+    for (size_t iteration = 0; iteration != kIterations; ++iteration) {
+      for (size_t i = 0; i != kRefsPerTask; ++i) {
+        irefs[i] = irt_->Add(obj_.Get(), &error_msg);
+        ASSERT_TRUE(irefs[i] != nullptr) << error_msg;
+        uint32_t index = IndirectReferenceTableTest::GetIndex(irefs[i]);
+        ASSERT_LT(index, irt_->Capacity());
+        ASSERT_FALSE((*entry_in_use_)[index].exchange(true, std::memory_order_relaxed))
+            << "Entry " << index << " handed out twice";
+      }
+      for (size_t i = 0; i != kRefsPerTask; ++i) {
+        // A reused entry gets a new serial, so an entry handed out twice would either fail the
+        // serial check or hold the object of another task.
+        ASSERT_TRUE(irt_->IsValidReference(irefs[i], &error_msg)) << error_msg;
+        ASSERT_OBJ_PTR_EQ(obj_.Get(), irt_->Get(irefs[i]));
+      }
+      // Remove the references in the order they were added or in the reverse order.
+      for (size_t j = 0; j != kRefsPerTask; ++j) {
+        size_t i = (iteration % 2u == 0u) ? j : kRefsPerTask - 1u - j;
+        uint32_t index = IndirectReferenceTableTest::GetIndex(irefs[i]);
+        // The entry may be handed out again as soon as it is removed.
+        (*entry_in_use_)[index].store(false, std::memory_order_relaxed);
+        ASSERT_TRUE(irt_->Remove(irefs[i]));
+      }
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  IndirectReferenceTable* const irt_;
+  const Handle<mirror::Object> obj_;
+  std::vector<std::atomic<bool>>* const entry_in_use_;
+};
+
+TEST_F(IndirectReferenceTableTest, ConcurrentAddRemove) {
+  static constexpr size_t kNumThreads = 4;
+  static constexpr size_t kTableMax = kNumThreads * AddRemoveTask::kRefsPerTask;
+  Thread* const self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("IndirectReferenceTableTest pool", kNumThreads));
+  ScopedObjectAccess soa(self);
+  IndirectReferenceTable irt(kGlobal);
+  std::string error_msg;
+  ASSERT_TRUE(irt.Initialize(kTableMax, &error_msg)) << error_msg;
+  std::vector<std::atomic<bool>> entry_in_use(GetMaxEntries(irt));
+
+  StackHandleScope<kNumThreads + 2u> hs(self);
+  Handle<mirror::Class> c =
+      hs.NewHandle(class_linker_->FindSystemClass(self, "Ljava/lang/Object;"));
+  ASSERT_TRUE(c != nullptr);
+  for (size_t i = 0; i != kNumThreads; ++i) {
+    Handle<mirror::Object> obj = hs.NewHandle(c->AllocObject(self));
+    ASSERT_TRUE(obj != nullptr);
+    thread_pool->AddTask(self, new AddRemoveTask(&irt, obj, &entry_in_use));
+  }
+  thread_pool->StartWorkers(self);
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    thread_pool->Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+  }
+  thread_pool->StopWorkers(self);
+
+  // The tasks never held more than `kTableMax` entries at a time and the free entries are
+  // reused before the table grows, so the table did not grow past that.
+  EXPECT_LE(irt.Capacity(), kTableMax);
+  EXPECT_EQ(0, irt.NEntriesForGlobal());
+  EXPECT_EQ(GetMaxEntries(irt), irt.FreeCapacity());
+  for (size_t i = 0; i != irt.Capacity(); ++i) {
+    EXPECT_FALSE(entry_in_use[i].load(std::memory_order_relaxed));
+  }
+  CheckDump(&irt, 0, 0);
+  irt.Trim();
+  EXPECT_EQ(0u, irt.Capacity());
+  EXPECT_EQ(GetMaxEntries(irt), irt.FreeCapacity());
+
+  // All entries are reusable after the churn.
+  Handle<mirror::Object> obj = hs.NewHandle(c->AllocObject(self));
+  ASSERT_TRUE(obj != nullptr);
+  IndirectRef iref = irt.Add(obj.Get(), &error_msg);
+  ASSERT_TRUE(iref != nullptr) << error_msg;
+  EXPECT_EQ(1u, irt.Capacity());
+  EXPECT_EQ(1, irt.NEntriesForGlobal());
+  EXPECT_OBJ_PTR_EQ(obj.Get(), irt.Get(iref));
+  EXPECT_TRUE(irt.Remove(iref));
+}
+
 }  // namespace art
@@ -113,6 +113,9 @@ inline size_t InternTable::AddTableFromMemory(const uint8_t* ptr,
     // Visit the unordered set, may remove elements.
     visitor(set);
     if (!set.empty()) {
+      if (is_boot_image) {
+        AddBootImageSet(ptr, set.size());
+      }
       strong_interns_.AddInternStrings(std::move(set), is_boot_image);
     }
   }
@@ -39,7 +39,44 @@ namespace art {
 InternTable::InternTable()
     : log_new_roots_(false),
       weak_intern_condition_("New intern condition", *Locks::intern_table_lock_),
-      weak_root_state_(gc::kWeakRootStateNormal) {
+      weak_root_state_(gc::kWeakRootStateNormal),
+      boot_image_sets_(nullptr) {
+}
+
+InternTable::~InternTable() {
+  delete boot_image_sets_.load(std::memory_order_relaxed);
+}
+
+InternTable::BootImageInternSet::BootImageInternSet(const uint8_t* ptr,
+                                                    BootImageInternSet* next_set)
+    : next(next_set) {
+  size_t read_count = 0;
+  // Do not copy the data, the view shares the image memory with the table in `tables_`.
+  set = UnorderedSet(ptr, /*make_copy_of_data=*/ false, &read_count);
+}
+
+void InternTable::AddBootImageSet(const uint8_t* ptr, size_t expected_size) {
+  BootImageInternSet* node =
+      new BootImageInternSet(ptr, boot_image_sets_.load(std::memory_order_relaxed));
+  // The view is created from the serialized header, so boot image visitors must not remove
+  // any strings. Otherwise the element count would be stale.
+  DCHECK_EQ(node->set.size(), expected_size);
+  boot_image_sets_.store(node, std::memory_order_release);
+}
+
+template <typename K>
+ALWAYS_INLINE
+inline ObjPtr<mirror::String> InternTable::FindInBootImageSets(
+    const K& key, uint32_t hash, const BootImageInternSet** searched_sets) const {
+  const BootImageInternSet* head = boot_image_sets_.load(std::memory_order_acquire);
+  *searched_sets = head;
+  for (const BootImageInternSet* node = head; node != nullptr; node = node->next.get()) {
+    auto it = node->set.FindWithHash(key, hash);
+    if (it != node->set.end()) {
+      return it->Read();
+    }
+  }
+  return nullptr;
 }
 
 size_t InternTable::Size() const {
@@ -114,16 +151,29 @@ ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self, ObjPtr<mirror::St
   DCHECK(s != nullptr);
   // `String::GetHashCode()` ensures that the stored hash is calculated.
   uint32_t hash = static_cast<uint32_t>(s->GetHashCode());
+  const BootImageInternSet* searched_sets;
+  ObjPtr<mirror::String> boot_image_string =
+      FindInBootImageSets(GcRoot<mirror::String>(s), hash, &searched_sets);
+  if (boot_image_string != nullptr) {
+    return boot_image_string;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
-  return strong_interns_.Find(s, hash);
+  return strong_interns_.Find(
+      s, hash, /*num_searched_frozen_tables=*/ 0u, SearchedAllBootImageSets(searched_sets));
 }
 
 ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self,
                                                  uint32_t utf16_length,
                                                  const char* utf8_data) {
   uint32_t hash = Utf8String::Hash(utf16_length, utf8_data);
+  Utf8String string(utf16_length, utf8_data);
+  const BootImageInternSet* searched_sets;
+  ObjPtr<mirror::String> boot_image_string = FindInBootImageSets(string, hash, &searched_sets);
+  if (boot_image_string != nullptr) {
+    return boot_image_string;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
-  return strong_interns_.Find(Utf8String(utf16_length, utf8_data), hash);
+  return strong_interns_.Find(string, hash, SearchedAllBootImageSets(searched_sets));
 }
 
 ObjPtr<mirror::String> InternTable::LookupWeakLocked(ObjPtr<mirror::String> s) {
@@ -205,6 +255,13 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
   DCHECK(s != nullptr);
   DCHECK_EQ(hash, static_cast<uint32_t>(s->GetStoredHashCode()));
   DCHECK_IMPLIES(hash == 0u, s->ComputeHashCode() == 0);
+  // Strings from the boot image are the most common hits and do not need the lock.
+  const BootImageInternSet* searched_sets;
+  ObjPtr<mirror::String> boot_image_string =
+      FindInBootImageSets(GcRoot<mirror::String>(s), hash, &searched_sets);
+  if (boot_image_string != nullptr) {
+    return boot_image_string;
+  }
   Thread* const self = Thread::Current();
   MutexLock mu(self, *Locks::intern_table_lock_);
   if (kDebugLocking) {
@@ -213,8 +270,8 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
   }
   while (true) {
     // Check the strong table for a match.
-    ObjPtr<mirror::String> strong =
-        strong_interns_.Find(s, hash, num_searched_strong_frozen_tables);
+    ObjPtr<mirror::String> strong = strong_interns_.Find(
+        s, hash, num_searched_strong_frozen_tables, SearchedAllBootImageSets(searched_sets));
     if (strong != nullptr) {
       return strong;
     }
@@ -252,15 +309,20 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
 ObjPtr<mirror::String> InternTable::InternStrong(uint32_t utf16_length, const char* utf8_data) {
   DCHECK(utf8_data != nullptr);
   uint32_t hash = Utf8String::Hash(utf16_length, utf8_data);
+  Utf8String string(utf16_length, utf8_data);
+  const BootImageInternSet* searched_sets;
+  ObjPtr<mirror::String> s = FindInBootImageSets(string, hash, &searched_sets);
+  if (s != nullptr) {
+    return s;
+  }
   Thread* self = Thread::Current();
-  ObjPtr<mirror::String> s;
   size_t num_searched_strong_frozen_tables;
   {
     // Try to avoid allocation. If we need to allocate, release the mutex before the allocation.
     MutexLock mu(self, *Locks::intern_table_lock_);
     DCHECK(!strong_interns_.tables_.empty());
     num_searched_strong_frozen_tables = strong_interns_.tables_.size() - 1u;
-    s = strong_interns_.Find(Utf8String(utf16_length, utf8_data), hash);
+    s = strong_interns_.Find(string, hash, SearchedAllBootImageSets(searched_sets));
   }
   if (s != nullptr) {
     return s;
@@ -334,15 +396,21 @@ void InternTable::Table::Remove(ObjPtr<mirror::String> s, uint32_t hash) {
 FLATTEN
 ObjPtr<mirror::String> InternTable::Table::Find(ObjPtr<mirror::String> s,
                                                 uint32_t hash,
-                                                size_t num_searched_frozen_tables) {
+                                                size_t num_searched_frozen_tables,
+                                                bool skip_boot_image) {
   Locks::intern_table_lock_->AssertHeld(Thread::Current());
   auto mid = tables_.begin() + num_searched_frozen_tables;
   for (Table::InternalTable& table : MakeIterationRange(tables_.begin(), mid)) {
     DCHECK(table.set_.FindWithHash(GcRoot<mirror::String>(s), hash) == table.set_.end());
   }
   // Search from the last table, assuming that apps shall search for their own
-  // strings more often than for boot image strings.
+  // strings more often than for boot image strings. The strong lookups search
+  // the boot image tables before taking the lock (see FindInBootImageSets()),
+  // so they can skip them here.
   for (Table::InternalTable& table : ReverseRange(MakeIterationRange(mid, tables_.end()))) {
+    if (skip_boot_image && table.IsBootImage()) {
+      continue;
+    }
     auto it = table.set_.FindWithHash(GcRoot<mirror::String>(s), hash);
     if (it != table.set_.end()) {
       return it->Read();
@@ -352,11 +420,17 @@ ObjPtr<mirror::String> InternTable::Table::Find(ObjPtr<mirror::String> s,
 }
 
 FLATTEN
-ObjPtr<mirror::String> InternTable::Table::Find(const Utf8String& string, uint32_t hash) {
+ObjPtr<mirror::String> InternTable::Table::Find(const Utf8String& string,
+                                                uint32_t hash,
+                                                bool skip_boot_image) {
   Locks::intern_table_lock_->AssertHeld(Thread::Current());
   // Search from the last table, assuming that apps shall search for their own
-  // strings more often than for boot image strings.
+  // strings more often than for boot image strings. As above, the boot image
+  // tables may have been searched already without the lock.
   for (InternalTable& table : ReverseRange(tables_)) {
+    if (skip_boot_image && table.IsBootImage()) {
+      continue;
+    }
     auto it = table.set_.FindWithHash(string, hash);
     if (it != table.set_.end()) {
       return it->Read();
@@ -17,6 +17,9 @@
 #ifndef ART_RUNTIME_INTERN_TABLE_H_
 #define ART_RUNTIME_INTERN_TABLE_H_
 
+#include <memory>
+
+#include "base/atomic.h"
 #include "base/dchecked_vector.h"
 #include "base/gc_visited_arena_pool.h"
 #include "base/hash_set.h"
@@ -117,6 +120,7 @@ class InternTable {
               GcRootArenaAllocator<GcRoot<mirror::String>, kAllocatorTagInternTable>>;
 
   InternTable();
+  ~InternTable();
 
   // Interns a potentially new string in the 'strong' table. May cause thread suspension.
   ObjPtr<mirror::String> InternStrong(uint32_t utf16_length, const char* utf8_data)
@@ -142,7 +146,9 @@ class InternTable {
   void SweepInternTableWeaks(IsMarkedVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::intern_table_lock_);
 
-  // Lookup a strong intern, returns null if not found.
+  // Lookup a strong intern, returns null if not found. Boot image interns are found without
+  // taking the `intern_table_lock_`; other interns are then looked up with the lock held,
+  // without searching the boot image tables again.
   ObjPtr<mirror::String> LookupStrong(Thread* self, ObjPtr<mirror::String> s)
       REQUIRES(!Locks::intern_table_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -237,11 +243,16 @@ class InternTable {
     };
 
     Table();
+    // Search the tables from the newest one. If `skip_boot_image` is true, the caller has
+    // already searched all the boot image tables.
     ObjPtr<mirror::String> Find(ObjPtr<mirror::String> s,
                                 uint32_t hash,
-                                size_t num_searched_frozen_tables = 0u)
+                                size_t num_searched_frozen_tables = 0u,
+                                bool skip_boot_image = false)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
-    ObjPtr<mirror::String> Find(const Utf8String& string, uint32_t hash)
+    ObjPtr<mirror::String> Find(const Utf8String& string,
+                                uint32_t hash,
+                                bool skip_boot_image = false)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
     void Insert(ObjPtr<mirror::String> s, uint32_t hash)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
@@ -279,6 +290,35 @@ class InternTable {
     ART_FRIEND_TEST(InternTableTest, CrossHash);
   };
 
+  // Immutable view of a boot image intern table. Boot image strings never move and boot image
+  // tables are neither modified nor removed once added, so these views can be searched without
+  // holding the `intern_table_lock_`. Each node owns the rest of the list.
+  struct BootImageInternSet {
+    BootImageInternSet(const uint8_t* ptr, BootImageInternSet* next_set);
+
+    UnorderedSet set;
+    std::unique_ptr<BootImageInternSet> next;
+  };
+
+  // Lock-free search of the boot image intern tables, returns null if not found. The searched
+  // list is returned in `searched_sets` for SearchedAllBootImageSets().
+  template <typename K>
+  ObjPtr<mirror::String> FindInBootImageSets(const K& key,
+                                             uint32_t hash,
+                                             const BootImageInternSet** searched_sets) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns true if no boot image table was added since FindInBootImageSets() searched
+  // `searched_sets`, so that the locked search can skip the boot image tables.
+  bool SearchedAllBootImageSets(const BootImageInternSet* searched_sets) const
+      REQUIRES(Locks::intern_table_lock_) {
+    return boot_image_sets_.load(std::memory_order_relaxed) == searched_sets;
+  }
+
+  // Publish a view of the boot image intern table read from `ptr` for lock-free lookups.
+  void AddBootImageSet(const uint8_t* ptr, size_t expected_size)
+      REQUIRES(Locks::intern_table_lock_);
+
   // Insert if non null, otherwise return null. Must be called holding the mutator lock.
   ObjPtr<mirror::String> Insert(ObjPtr<mirror::String> s,
                                 uint32_t hash,
@@ -324,11 +364,15 @@ class InternTable {
   Table weak_interns_ GUARDED_BY(Locks::intern_table_lock_);
   // Weak root state, used for concurrent system weak processing and more.
   gc::WeakRootState weak_root_state_ GUARDED_BY(Locks::intern_table_lock_);
+  // Head of the list of boot image intern sets. Written with release semantics while holding
+  // the `intern_table_lock_` and read with acquire semantics without it. Owns the list.
+  Atomic<BootImageInternSet*> boot_image_sets_;
 
   friend class gc::space::ImageSpace;
   friend class linker::ImageWriter;
   friend class Transaction;
   ART_FRIEND_TEST(InternTableTest, CrossHash);
+  ART_FRIEND_TEST(InternTableTest, LookupStrongBootImage);
   DISALLOW_COPY_AND_ASSIGN(InternTable);
 };
 
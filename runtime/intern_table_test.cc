@@ -19,10 +19,12 @@
 #include "base/hash_set.h"
 #include "common_runtime_test.h"
 #include "dex/utf.h"
+#include "gc/heap.h"
 #include "gc_root-inl.h"
 #include "handle_scope-inl.h"
 #include "mirror/object.h"
 #include "mirror/string.h"
+#include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
 
 namespace art {
@@ -247,6 +249,55 @@ TEST_F(InternTableTest, LookupStrong) {
   EXPECT_TRUE(lookup_foobbS == nullptr);
 }
 
+TEST_F(InternTableTest, LookupStrongBootImage) {
+  ScopedObjectAccess soa(Thread::Current());
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  InternTable* intern_table = Runtime::Current()->GetInternTable();
+  const InternTable::BootImageInternSet* boot_image_sets =
+      intern_table->boot_image_sets_.load(std::memory_order_acquire);
+  ASSERT_TRUE(boot_image_sets != nullptr);
+  ASSERT_TRUE(boot_image_sets->set.begin() != boot_image_sets->set.end());
+  StackHandleScope<3> hs(soa.Self());
+  Handle<mirror::String> boot_string(hs.NewHandle(boot_image_sets->set.begin()->Read()));
+  ASSERT_TRUE(heap->ObjectIsInBootImageSpace(boot_string.Get()));
+  const int32_t boot_length = boot_string->GetLength();
+  const std::string boot_utf8 = boot_string->ToModifiedUtf8();
+
+  // Boot image hit, found by the lock-free search.
+  EXPECT_OBJ_PTR_EQ(boot_string.Get(), intern_table->LookupStrong(soa.Self(), boot_string.Get()));
+  EXPECT_OBJ_PTR_EQ(boot_string.Get(),
+                    intern_table->LookupStrong(soa.Self(), boot_length, boot_utf8.c_str()));
+  EXPECT_OBJ_PTR_EQ(boot_string.Get(), intern_table->InternStrong(boot_length, boot_utf8.c_str()));
+  {
+    // The locked search finds it only if it does not skip the boot image tables.
+    MutexLock mu(soa.Self(), *Locks::intern_table_lock_);
+    EXPECT_TRUE(intern_table->SearchedAllBootImageSets(boot_image_sets));
+    uint32_t hash = static_cast<uint32_t>(boot_string->GetHashCode());
+    EXPECT_TRUE(intern_table->strong_interns_.Find(
+        boot_string.Get(), hash, /*num_searched_frozen_tables=*/ 0u, /*skip_boot_image=*/ true)
+            == nullptr);
+    EXPECT_OBJ_PTR_EQ(boot_string.Get(),
+                      intern_table->strong_interns_.Find(boot_string.Get(), hash));
+  }
+
+  // Miss, then insert into the app table.
+  static constexpr const char* kAppUtf8 = "InternTableTest.LookupStrongBootImage";
+  const int32_t app_length = strlen(kAppUtf8);
+  EXPECT_TRUE(intern_table->LookupStrong(soa.Self(), app_length, kAppUtf8) == nullptr);
+  Handle<mirror::String> app_string(hs.NewHandle(intern_table->InternStrong(app_length, kAppUtf8)));
+  ASSERT_TRUE(app_string != nullptr);
+  EXPECT_FALSE(heap->ObjectIsInBootImageSpace(app_string.Get()));
+
+  // App table hit, found by the locked search.
+  Handle<mirror::String> app_copy(
+      hs.NewHandle(mirror::String::AllocFromModifiedUtf8(soa.Self(), kAppUtf8)));
+  ASSERT_TRUE(app_copy != nullptr);
+  ASSERT_NE(app_string.Get(), app_copy.Get());
+  EXPECT_OBJ_PTR_EQ(app_string.Get(), intern_table->LookupStrong(soa.Self(), app_length, kAppUtf8));
+  EXPECT_OBJ_PTR_EQ(app_string.Get(), intern_table->LookupStrong(soa.Self(), app_copy.Get()));
+  EXPECT_OBJ_PTR_EQ(app_string.Get(), intern_table->InternStrong(app_copy.Get()));
+}
+
 TEST_F(InternTableTest, InternStrongFrozenWeak) {
   ScopedObjectAccess soa(Thread::Current());
   InternTable intern_table;
@@ -25,19 +25,44 @@ namespace art {
 
 inline bool InterpreterCache::Get(Thread* self, const void* key, /* out */ size_t* value) {
   DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
-  Entry& entry = data_[IndexOf(key)];
-  if (LIKELY(entry.first == key)) {
-    *value = entry.second;
+  Entry* set = &data_[IndexOf(key)];
+  if (LIKELY(set[0].first == key)) {
+    ++hits_;
+    *value = set[0].second;
     return true;
   }
+  for (size_t way = 1; way != kWays; ++way) {
+    if (set[way].first == key) {
+      // Move the entry to the first way, where nterp looks for it.
+      Entry entry = set[way];
+      for (; way != 0u; --way) {
+        set[way] = set[way - 1u];
+      }
+      set[0] = entry;
+      ++hits_;
+      *value = entry.second;
+      return true;
+    }
+  }
+  ++misses_;
   return false;
 }
 
 inline void InterpreterCache::Set(Thread* self, const void* key, size_t value) {
   DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
-  // Simple store works here as the cache is always read/written by the owning
+  // Simple stores work here as the cache is always read/written by the owning
   // thread only (or in a stop-the-world pause).
-  data_[IndexOf(key)] = Entry{key, value};
+  // Insert in the first way and push the older entries of the set down. This evicts
+  // the last way, unless the set already holds an entry for `key`.
+  Entry* set = &data_[IndexOf(key)];
+  size_t way = 0u;
+  while (way != kWays - 1u && set[way].first != key) {
+    ++way;
+  }
+  for (; way != 0u; --way) {
+    set[way] = set[way - 1u];
+  }
+  set[0] = Entry{key, value};
 }
 
 }  // namespace art
@@ -15,6 +15,9 @@
  */
 
 #include "interpreter_cache.h"
+
+#include "base/metrics/metrics.h"
+#include "runtime.h"
 #include "thread-inl.h"
 
 namespace art {
@@ -31,4 +34,15 @@ void InterpreterCache::Clear(Thread* owning_thread) {
   }
 }
 
+void InterpreterCache::ReportMetrics(Thread* owning_thread) {
+  DCHECK(owning_thread->GetInterpreterCache() == this);
+  if (hits_ != 0u || misses_ != 0u) {
+    metrics::ArtMetrics* metrics = GetMetrics();
+    metrics->InterpreterCacheHitCount()->Add(hits_);
+    metrics->InterpreterCacheMissCount()->Add(misses_);
+    hits_ = 0u;
+    misses_ = 0u;
+  }
+}
+
 }  // namespace art
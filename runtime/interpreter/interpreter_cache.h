@@ -42,6 +42,10 @@ class Thread;
 // We ensure consistency of the cache by clearing it
 // whenever any dex file is unloaded.
 //
+// The cache is set-associative. Nterp only probes the first way of a set in its
+// assembly fast path, so lookups done from C++ move hits to the first way and new
+// entries are inserted there, pushing older entries of the set to the other ways.
+//
 // Aligned to 16-bytes to make it easier to get the address of the cache
 // from assembly (it ensures that the offset is valid immediate value).
 class ALIGNED(16) InterpreterCache {
@@ -50,8 +54,11 @@ class ALIGNED(16) InterpreterCache {
   using Entry ALIGNED(2 * sizeof(size_t)) = std::pair<const void*, size_t>;
 
   // 2x size increase/decrease corresponds to ~0.5% interpreter performance change.
-  // Value of 256 has around 75% cache hit rate.
-  static constexpr size_t kSize = 256;
+  // A direct-mapped cache of 256 entries has around 75% cache hit rate. The number
+  // of sets and ways can be changed here; nterp reads the layout from asm_defines.
+  static constexpr size_t kSets = 256;
+  static constexpr size_t kWays = 2;
+  static constexpr size_t kSize = kSets * kWays;
 
   InterpreterCache() {
     // We can not use the Clear() method since the constructor will not
@@ -62,6 +69,10 @@ class ALIGNED(16) InterpreterCache {
   // Clear the whole cache. It requires the owning thread for DCHECKs.
   void Clear(Thread* owning_thread);
 
+  // Add the hit and miss counts to the runtime metrics and reset them. This must be
+  // called from the owning thread or while it cannot use the cache, e.g. when sweeping.
+  void ReportMetrics(Thread* owning_thread);
+
   ALWAYS_INLINE bool Get(Thread* self, const void* key, /* out */ size_t* value);
 
   ALWAYS_INLINE void Set(Thread* self, const void* key, size_t value);
@@ -71,14 +82,21 @@ class ALIGNED(16) InterpreterCache {
   }
 
  private:
+  // Returns the index of the first way of the set for `key`.
   static ALWAYS_INLINE size_t IndexOf(const void* key) {
-    static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
-    size_t index = (reinterpret_cast<uintptr_t>(key) >> 2) & (kSize - 1);
+    static_assert(IsPowerOfTwo(kSets), "Number of sets must be power of two");
+    static_assert(kWays == 1u || kWays == 2u || kWays == 4u, "Unsupported number of ways");
+    size_t index = ((reinterpret_cast<uintptr_t>(key) >> 2) & (kSets - 1)) * kWays;
     DCHECK_LT(index, kSize);
     return index;
   }
 
   std::array<Entry, kSize> data_;
+
+  // Lookups done from C++. Hits in the first way found by the nterp fast path
+  // are not counted.
+  uint64_t hits_ = 0u;
+  uint64_t misses_ = 0u;
 };
 
 }  // namespace art
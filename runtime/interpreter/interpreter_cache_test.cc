@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interpreter_cache-inl.h"
+
+#include <vector>
+
+#include "common_runtime_test.h"
+#include "dex/dex_instruction.h"
+#include "thread-current-inl.h"
+
+namespace art {
+
+class InterpreterCacheTest : public CommonRuntimeTest {};
+
+TEST_F(InterpreterCacheTest, SetAssociative) {
+  Thread* self = Thread::Current();
+  InterpreterCache* cache = self->GetInterpreterCache();
+  cache->Clear(self);
+
+  // Keys `kStride` code units apart map to the same set. They point to IGET
+  // instructions, for which sweeping the cache has nothing to do.
+  constexpr size_t kWays = InterpreterCache::kWays;
+  constexpr size_t kStride = InterpreterCache::kSets * sizeof(uint32_t) / sizeof(uint16_t);
+  std::vector<uint16_t> code((kWays + 1u) * kStride, Instruction::IGET);
+  auto key = [&](size_t i) { return &code[i * kStride]; };
+  auto first_way = [&](size_t i) -> InterpreterCache::Entry& {
+    size_t set = (reinterpret_cast<uintptr_t>(key(i)) >> 2) & (InterpreterCache::kSets - 1u);
+    return cache->GetArray()[set * kWays];
+  };
+
+  size_t value;
+  for (size_t i = 0; i != kWays; ++i) {
+    EXPECT_FALSE(cache->Get(self, key(i), &value));
+    cache->Set(self, key(i), i);
+    // New entries go to the first way, where nterp looks for them.
+    EXPECT_EQ(first_way(i).first, key(i));
+  }
+
+  // The set holds all of them. A hit moves the entry to the first way.
+  for (size_t i = 0; i != kWays; ++i) {
+    ASSERT_TRUE(cache->Get(self, key(i), &value));
+    EXPECT_EQ(value, i);
+    EXPECT_EQ(first_way(i).first, key(i));
+  }
+
+  // Another entry evicts the least recently used one.
+  cache->Set(self, key(kWays), kWays);
+  EXPECT_FALSE(cache->Get(self, key(0), &value));
+  for (size_t i = 1; i != kWays + 1u; ++i) {
+    ASSERT_TRUE(cache->Get(self, key(i), &value));
+    EXPECT_EQ(value, i);
+  }
+
+  // Setting an existing key does not duplicate it.
+  cache->Set(self, key(1), 42u);
+  ASSERT_TRUE(cache->Get(self, key(1), &value));
+  EXPECT_EQ(value, 42u);
+  if (kWays != 1u) {
+    ASSERT_TRUE(cache->Get(self, key(kWays), &value));
+    EXPECT_EQ(value, kWays);
+  }
+
+  cache->Clear(self);
+}
+
+}  // namespace art
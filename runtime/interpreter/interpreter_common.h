@@ -308,15 +308,15 @@ ALWAYS_INLINE static JValue GetFieldValue(const ShadowFrame& shadow_frame, uint3
   return field_value;
 }
 
-extern "C" size_t NterpGetStaticField(Thread* self,
-                                      ArtMethod* caller,
-                                      const uint16_t* dex_pc_ptr,
-                                      size_t resolve_field_type);
+extern "C" size_t NterpResolveStaticField(Thread* self,
+                                          ArtMethod* caller,
+                                          const uint16_t* dex_pc_ptr,
+                                          size_t resolve_field_type);
 
-extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
-                                                ArtMethod* caller,
-                                                const uint16_t* dex_pc_ptr,
-                                                size_t resolve_field_type);
+extern "C" uint32_t NterpResolveInstanceFieldOffset(Thread* self,
+                                                    ArtMethod* caller,
+                                                    const uint16_t* dex_pc_ptr,
+                                                    size_t resolve_field_type);
 
 static inline void GetFieldInfo(Thread* self,
                                 ArtMethod* caller,
@@ -329,9 +329,9 @@ static inline void GetFieldInfo(Thread* self,
   size_t tls_value = 0u;
   if (!self->GetInterpreterCache()->Get(self, dex_pc_ptr, &tls_value)) {
     if (is_static) {
-      tls_value = NterpGetStaticField(self, caller, dex_pc_ptr, resolve_field_type);
+      tls_value = NterpResolveStaticField(self, caller, dex_pc_ptr, resolve_field_type);
     } else {
-      tls_value = NterpGetInstanceFieldOffset(self, caller, dex_pc_ptr, resolve_field_type);
+      tls_value = NterpResolveInstanceFieldOffset(self, caller, dex_pc_ptr, resolve_field_type);
     }
 
     if (self->IsExceptionPending()) {
@@ -232,7 +232,7 @@ static constexpr std::array<uint8_t, 256u> GenerateOpcodeInvokeTypes() {
 static constexpr std::array<uint8_t, 256u> kOpcodeInvokeTypes = GenerateOpcodeInvokeTypes();
 
 FLATTEN
-extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, const uint16_t* dex_pc_ptr)
+extern "C" size_t NterpResolveMethod(Thread* self, ArtMethod* caller, const uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
   const Instruction* inst = Instruction::At(dex_pc_ptr);
@@ -304,10 +304,10 @@ extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, const uint16_t
   }
 }
 
-extern "C" size_t NterpGetStaticField(Thread* self,
-                                      ArtMethod* caller,
-                                      const uint16_t* dex_pc_ptr,
-                                      size_t resolve_field_type)  // Resolve if not zero
+extern "C" size_t NterpResolveStaticField(Thread* self,
+                                          ArtMethod* caller,
+                                          const uint16_t* dex_pc_ptr,
+                                          size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
   const Instruction* inst = Instruction::At(dex_pc_ptr);
@@ -359,10 +359,11 @@ extern "C" size_t NterpGetStaticField(Thread* self,
   }
 }
 
-extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
-                                                ArtMethod* caller,
-                                                const uint16_t* dex_pc_ptr,
-                                                size_t resolve_field_type)  // Resolve if not zero
+extern "C" uint32_t NterpResolveInstanceFieldOffset(Thread* self,
+                                                    ArtMethod* caller,
+                                                    const uint16_t* dex_pc_ptr,
+                                                    // Resolve if not zero
+                                                    size_t resolve_field_type)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
   const Instruction* inst = Instruction::At(dex_pc_ptr);
@@ -401,6 +402,46 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
   return resolved_field->GetOffset().Uint32Value();
 }
 
+// The nterp fast path only looks at the first way of the cache set. When it misses,
+// look at the other ways before resolving, which also moves a hit to the first way.
+// Like a resolution, a hit there counts towards the hotness of the caller.
+// The interpreter looks at all ways itself and calls the NterpResolve* functions.
+extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, const uint16_t* dex_pc_ptr)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  size_t value;
+  if (self->GetInterpreterCache()->Get(self, dex_pc_ptr, &value)) {
+    UpdateHotness(caller);
+    return value;
+  }
+  return NterpResolveMethod(self, caller, dex_pc_ptr);
+}
+
+extern "C" size_t NterpGetStaticField(Thread* self,
+                                      ArtMethod* caller,
+                                      const uint16_t* dex_pc_ptr,
+                                      size_t resolve_field_type)  // Resolve if not zero
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  size_t value;
+  if (self->GetInterpreterCache()->Get(self, dex_pc_ptr, &value)) {
+    UpdateHotness(caller);
+    return value;
+  }
+  return NterpResolveStaticField(self, caller, dex_pc_ptr, resolve_field_type);
+}
+
+extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
+                                                ArtMethod* caller,
+                                                const uint16_t* dex_pc_ptr,
+                                                size_t resolve_field_type)  // Resolve if not zero
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  size_t value;
+  if (self->GetInterpreterCache()->Get(self, dex_pc_ptr, &value)) {
+    UpdateHotness(caller);
+    return static_cast<uint32_t>(value);
+  }
+  return NterpResolveInstanceFieldOffset(self, caller, dex_pc_ptr, resolve_field_type);
+}
+
 extern "C" mirror::Object* NterpGetClass(Thread* self, ArtMethod* caller, uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
@@ -1838,9 +1838,9 @@ void JitThreadPool::RemoveAllTasks(Thread* self) {
   } while (true);
 
   MutexLock mu(self, task_queue_lock_);
-  baseline_queue_.clear();
-  optimized_queue_.clear();
-  osr_queue_.clear();
+  baseline_queue_.Clear();
+  optimized_queue_.Clear();
+  osr_queue_.Clear();
 }
 
 JitThreadPool::~JitThreadPool() {
@@ -1870,31 +1870,20 @@ void JitThreadPool::AddTask(Thread* self, ArtMethod* method, CompilationKind kin
   if (!started_) {
     return;
   }
+  bool enqueued = false;
   switch (kind) {
     case CompilationKind::kOsr:
-      if (ContainsElement(osr_enqueued_methods_, method)) {
-        return;
-      }
-      osr_enqueued_methods_.insert(method);
-      osr_queue_.push_back(method);
+      enqueued = osr_queue_.Add(method);
       break;
     case CompilationKind::kBaseline:
-      if (ContainsElement(baseline_enqueued_methods_, method)) {
-        return;
-      }
-      baseline_enqueued_methods_.insert(method);
-      baseline_queue_.push_back(method);
+      enqueued = baseline_queue_.Add(method);
       break;
     case CompilationKind::kOptimized:
-      if (ContainsElement(optimized_enqueued_methods_, method)) {
-        return;
-      }
-      optimized_enqueued_methods_.insert(method);
-      optimized_queue_.push_back(method);
+      enqueued = optimized_queue_.Add(method);
       break;
   }
   // If we have any waiters, signal one.
-  if (waiting_count_ != 0) {
+  if (enqueued && waiting_count_ != 0) {
     task_queue_condition_.Signal(self);
   }
 }
@@ -1911,26 +1900,119 @@ Task* JitThreadPool::TryGetTaskLocked() {
     return task;
   }
 
-  // OSR requests second, then baseline and finally optimized.
-  Task* task = FetchFrom(osr_queue_, CompilationKind::kOsr);
-  if (task == nullptr) {
-    task = FetchFrom(baseline_queue_, CompilationKind::kBaseline);
-    if (task == nullptr) {
-      task = FetchFrom(optimized_queue_, CompilationKind::kOptimized);
+  // OSR requests second. Whether OSR code already exists is only known under the JIT lock, so
+  // these requests are not checked for staleness here.
+  if (osr_queue_.PeekRequests() != 0u) {
+    return CreateCompileTask(osr_queue_.Fetch(), CompilationKind::kOsr);
+  }
+
+  // Then baseline and optimized. Baseline requests are served first, unless the optimized
+  // request has been made more times than the hottest baseline one, which means the method
+  // keeps getting hot while running baseline code.
+  while (true) {
+    uint32_t baseline_requests = baseline_queue_.PeekRequests();
+    uint32_t optimized_requests = optimized_queue_.PeekRequests();
+    RequestQueue* queue = nullptr;
+    CompilationKind kind;
+    if (optimized_requests > baseline_requests) {
+      queue = &optimized_queue_;
+      kind = CompilationKind::kOptimized;
+    } else if (baseline_requests != 0u) {
+      queue = &baseline_queue_;
+      kind = CompilationKind::kBaseline;
+    } else {
+      return nullptr;
+    }
+    ArtMethod* method = queue->Fetch();
+    if (!IsStaleRequest(method, kind)) {
+      return CreateCompileTask(method, kind);
     }
+    queue->Remove(method);
+  }
+}
+
+bool JitThreadPool::IsStaleRequest(ArtMethod* method, CompilationKind kind) {
+  if (kind == CompilationKind::kOsr) {
+    return false;
+  }
+  const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
+  if (!Runtime::Current()->GetJit()->GetCodeCache()->ContainsPc(entry_point)) {
+    return false;
+  }
+  if (kind == CompilationKind::kBaseline) {
+    // The existing code is either baseline or optimized.
+    return true;
   }
+  DCHECK_EQ(kind, CompilationKind::kOptimized);
+  const OatQuickMethodHeader* header = OatQuickMethodHeader::FromEntryPoint(entry_point);
+  return header->IsOptimized() && !CodeInfo::IsBaseline(header->GetOptimizedCodeInfoPtr());
+}
+
+Task* JitThreadPool::CreateCompileTask(ArtMethod* method, CompilationKind kind) {
+  JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
+  current_compilations_.insert(task);
   return task;
 }
 
-Task* JitThreadPool::FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) {
-  if (!methods.empty()) {
-    ArtMethod* method = methods.front();
-    methods.pop_front();
-    JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
-    current_compilations_.insert(task);
-    return task;
+bool JitThreadPool::RequestQueue::Add(ArtMethod* method) {
+  auto [it, inserted] = requests_.emplace(method, 1u);
+  if (!inserted) {
+    // The method got hot again while waiting: bump its priority, unless it is already being
+    // compiled.
+    if (it->second == 0u || it->second == kMaxRequests) {
+      return false;
+    }
+    ++it->second;
+  } else {
+    ++num_enqueued_;
   }
-  return nullptr;
+  buckets_[it->second].push_back(method);
+  return inserted;
+}
+
+uint32_t JitThreadPool::RequestQueue::PeekRequests() {
+  while (!buckets_.empty()) {
+    auto bucket = buckets_.begin();
+    std::deque<ArtMethod*>& methods = bucket->second;
+    while (!methods.empty()) {
+      auto it = requests_.find(methods.front());
+      if (it != requests_.end() && it->second == bucket->first) {
+        return bucket->first;
+      }
+      methods.pop_front();
+    }
+    buckets_.erase(bucket);
+  }
+  return 0u;
+}
+
+ArtMethod* JitThreadPool::RequestQueue::Fetch() {
+  DCHECK(!buckets_.empty());
+  std::deque<ArtMethod*>& methods = buckets_.begin()->second;
+  DCHECK(!methods.empty());
+  ArtMethod* method = methods.front();
+  methods.pop_front();
+  if (methods.empty()) {
+    buckets_.erase(buckets_.begin());
+  }
+  requests_[method] = 0u;
+  DCHECK_NE(num_enqueued_, 0u);
+  --num_enqueued_;
+  return method;
+}
+
+void JitThreadPool::RequestQueue::Remove(ArtMethod* method) {
+  DCHECK_EQ(requests_.count(method), 1u);
+  DCHECK_EQ(requests_.find(method)->second, 0u);
+  requests_.erase(method);
+}
+
+void JitThreadPool::RequestQueue::Clear() {
+  for (auto& [method, requests] : requests_) {
+    requests = 0u;
+  }
+  buckets_.clear();
+  num_enqueued_ = 0u;
 }
 
 void JitThreadPool::Remove(JitCompileTask* task) {
@@ -1938,15 +2020,15 @@ void JitThreadPool::Remove(JitCompileTask* task) {
   current_compilations_.erase(task);
   switch (task->GetCompilationKind()) {
     case CompilationKind::kOsr: {
-      osr_enqueued_methods_.erase(task->GetArtMethod());
+      osr_queue_.Remove(task->GetArtMethod());
       break;
     }
     case CompilationKind::kBaseline: {
-      baseline_enqueued_methods_.erase(task->GetArtMethod());
+      baseline_queue_.Remove(task->GetArtMethod());
       break;
     }
     case CompilationKind::kOptimized: {
-      optimized_enqueued_methods_.erase(task->GetArtMethod());
+      optimized_queue_.Remove(task->GetArtMethod());
       break;
     }
   }
@@ -1973,9 +2055,10 @@ void JitThreadPool::VisitRoots(RootVisitor* visitor) {
     // - Generic tasks like `ZygoteVerificationTask` which don't hold any root.
     // - `JitCompileTask` for precompiled methods, which we know are live, being
     //   part of the boot classpath or system server classpath.
-    methods.insert(methods.end(), osr_queue_.begin(), osr_queue_.end());
-    methods.insert(methods.end(), baseline_queue_.begin(), baseline_queue_.end());
-    methods.insert(methods.end(), optimized_queue_.begin(), optimized_queue_.end());
+    auto add_method = [&](ArtMethod* method) { methods.push_back(method); };
+    osr_queue_.VisitEnqueuedMethods(add_method);
+    baseline_queue_.VisitEnqueuedMethods(add_method);
+    optimized_queue_.VisitEnqueuedMethods(add_method);
     for (JitCompileTask* task : current_compilations_) {
       methods.push_back(task->GetArtMethod());
     }
@@ -17,6 +17,10 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include <deque>
+#include <functional>
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <android-base/unique_fd.h>
@@ -280,26 +284,84 @@ class JitThreadPool : public AbstractThreadPool {
       // We need peers as we may report the JIT thread, e.g., in the debugger.
       : AbstractThreadPool(name, num_threads, /* create_peers= */ true, worker_stack_size) {}
 
-  // Try to fetch an entry from `methods`. Return null if `methods` is empty.
-  Task* FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) REQUIRES(task_queue_lock_);
+  // The compilation requests of one kind. A method that keeps getting hot while waiting in
+  // the queue is requested again, so the number of requests since it was enqueued approximates
+  // its hotness velocity. Methods are served by decreasing number of requests, and in FIFO
+  // order for the same number of requests.
+  //
+  // The queue keeps one FIFO bucket per number of requests. A new request for an enqueued
+  // method adds it to the next bucket and leaves its previous entry behind, to be dropped when
+  // it reaches the front. Adding and fetching are therefore constant time, amortized, apart
+  // from the lookup of the bucket.
+  class RequestQueue {
+   public:
+    // Record a request for `method`. Methods are only enqueued once, until the compilation
+    // they have been fetched for is done. Return whether `method` got enqueued.
+    bool Add(ArtMethod* method);
+
+    // Return the number of requests of the method to fetch next, or 0 if there is none.
+    uint32_t PeekRequests();
+
+    // Fetch the method with the most requests. `PeekRequests()` must have returned non-zero.
+    ArtMethod* Fetch();
+
+    // Forget about `method`, which has been fetched, so that it can be enqueued again.
+    void Remove(ArtMethod* method);
+
+    // Drop all the enqueued methods. They are not enqueued again until removed.
+    void Clear();
+
+    bool empty() const {
+      return num_enqueued_ == 0u;
+    }
+
+    size_t size() const {
+      return num_enqueued_;
+    }
+
+    template <typename Visitor>
+    void VisitEnqueuedMethods(const Visitor& visitor) const {
+      for (const auto& [method, requests] : requests_) {
+        if (requests != 0u) {
+          visitor(method);
+        }
+      }
+    }
+
+   private:
+    // Beyond this number of requests, methods are kept in FIFO order. This bounds the number
+    // of entries a method can leave behind.
+    static constexpr uint32_t kMaxRequests = 32u;
+
+    // Methods that are enqueued or being compiled, mapped to their number of requests since
+    // they were enqueued, or 0 once fetched.
+    std::unordered_map<ArtMethod*, uint32_t> requests_;
+    // The entries for each number of requests, hottest first. An entry is stale if the
+    // number of requests of its method has changed since it was added.
+    std::map<uint32_t, std::deque<ArtMethod*>, std::greater<uint32_t>> buckets_;
+    size_t num_enqueued_ = 0u;
+  };
+
+  // Return whether a request of `kind` for `method` is no longer needed, because the method
+  // got compiled since it was enqueued. This is also checked when compiling, but dropping the
+  // request when fetching it avoids making other requests wait behind it.
+  static bool IsStaleRequest(ArtMethod* method, CompilationKind kind);
+
+  // Create a compilation task for `method`.
+  Task* CreateCompileTask(ArtMethod* method, CompilationKind kind) REQUIRES(task_queue_lock_);
 
   std::deque<Task*> generic_queue_ GUARDED_BY(task_queue_lock_);
 
-  std::deque<ArtMethod*> osr_queue_ GUARDED_BY(task_queue_lock_);
-  std::deque<ArtMethod*> baseline_queue_ GUARDED_BY(task_queue_lock_);
-  std::deque<ArtMethod*> optimized_queue_ GUARDED_BY(task_queue_lock_);
-
-  // We track the methods that are currently enqueued to avoid
-  // adding them to the queue multiple times, which could bloat the
-  // queues.
-  std::set<ArtMethod*> osr_enqueued_methods_ GUARDED_BY(task_queue_lock_);
-  std::set<ArtMethod*> baseline_enqueued_methods_ GUARDED_BY(task_queue_lock_);
-  std::set<ArtMethod*> optimized_enqueued_methods_ GUARDED_BY(task_queue_lock_);
+  RequestQueue osr_queue_ GUARDED_BY(task_queue_lock_);
+  RequestQueue baseline_queue_ GUARDED_BY(task_queue_lock_);
+  RequestQueue optimized_queue_ GUARDED_BY(task_queue_lock_);
 
   // A set to keep track of methods that are currently being compiled. Entries
   // will be removed when JitCompileTask->Finalize is called.
   std::unordered_set<JitCompileTask*> current_compilations_ GUARDED_BY(task_queue_lock_);
 
+  friend class JitThreadPoolTest;
+
   DISALLOW_COPY_AND_ASSIGN(JitThreadPool);
 };
 
@@ -613,7 +613,8 @@ void JitCodeCache::DisallowInlineCacheAccess() {
 
 void JitCodeCache::CopyInlineCacheInto(
     const InlineCache& ic,
-    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes) {
+    /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+    /*out*/uint16_t* counts) {
   if (classes == nullptr) return;
   static_assert(arraysize(ic.classes_) == InlineCache::kIndividualCacheSize);
   DCHECK_EQ(classes->Capacity(), InlineCache::kIndividualCacheSize);
@@ -629,6 +630,9 @@ void JitCodeCache::CopyInlineCacheInto(
     mirror::Class* object = root.Read();
     if (object != nullptr) {
       DCHECK_LT(classes->Size(), classes->Capacity());
+      if (counts != nullptr) {
+        counts[classes->Size()] = ic.counts_[i];
+      }
       classes->NewHandle(object);
     }
   }
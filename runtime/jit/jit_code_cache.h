@@ -310,8 +310,11 @@ class JitCodeCache {
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Copy the non-null classes of `ic` into `classes`. If `counts` is not null, the receiver
+  // count of each copied class is stored at the same index as its handle.
   void CopyInlineCacheInto(const InlineCache& ic,
-                           /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes)
+                           /*out*/StackHandleScope<InlineCache::kIndividualCacheSize>* classes,
+                           /*out*/uint16_t* counts = nullptr)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+#include <set>
+
+#include "common_runtime_test.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-inl.h"
+
+namespace art {
+namespace jit {
+
+class JitThreadPoolTest : public CommonRuntimeTest {
+ protected:
+  using RequestQueue = JitThreadPool::RequestQueue;
+
+  // The queue only uses the methods as keys, so they do not need to be real methods.
+  ArtMethod* Method(size_t index) {
+    return reinterpret_cast<ArtMethod*>(&fake_methods_[index]);
+  }
+
+ private:
+  uint64_t fake_methods_[8];
+};
+
+TEST_F(JitThreadPoolTest, RequestQueueFifo) {
+  RequestQueue queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.PeekRequests());
+  for (size_t i = 0; i != 4u; ++i) {
+    EXPECT_TRUE(queue.Add(Method(i)));
+  }
+  EXPECT_EQ(4u, queue.size());
+  // Methods requested the same number of times are served in the order they were enqueued.
+  for (size_t i = 0; i != 4u; ++i) {
+    ASSERT_EQ(1u, queue.PeekRequests());
+    EXPECT_EQ(Method(i), queue.Fetch());
+    EXPECT_EQ(3u - i, queue.size());
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.PeekRequests());
+
+  // A fetched method is not enqueued again until its compilation is done.
+  EXPECT_FALSE(queue.Add(Method(0)));
+  EXPECT_TRUE(queue.empty());
+  queue.Remove(Method(0));
+  EXPECT_TRUE(queue.Add(Method(0)));
+  EXPECT_EQ(1u, queue.size());
+  EXPECT_EQ(Method(0), queue.Fetch());
+}
+
+TEST_F(JitThreadPoolTest, RequestQueuePriority) {
+  RequestQueue queue;
+  for (size_t i = 0; i != 4u; ++i) {
+    EXPECT_TRUE(queue.Add(Method(i)));
+  }
+  // Request methods 3 and 1 again, then method 1 once more. Requesting an enqueued method does
+  // not enqueue it again.
+  EXPECT_FALSE(queue.Add(Method(3)));
+  EXPECT_FALSE(queue.Add(Method(1)));
+  EXPECT_FALSE(queue.Add(Method(1)));
+  EXPECT_FALSE(queue.Add(Method(2)));
+  EXPECT_EQ(4u, queue.size());
+
+  // The hottest method comes first, then the methods with the same number of requests in the
+  // order they reached it, and the entries they left behind in the lower buckets are dropped.
+  ASSERT_EQ(3u, queue.PeekRequests());
+  EXPECT_EQ(Method(1), queue.Fetch());
+  ASSERT_EQ(2u, queue.PeekRequests());
+  EXPECT_EQ(Method(3), queue.Fetch());
+  ASSERT_EQ(2u, queue.PeekRequests());
+  EXPECT_EQ(Method(2), queue.Fetch());
+  ASSERT_EQ(1u, queue.PeekRequests());
+  EXPECT_EQ(Method(0), queue.Fetch());
+  EXPECT_EQ(0u, queue.PeekRequests());
+  EXPECT_TRUE(queue.empty());
+
+  // Requests for methods being compiled do not change their priority.
+  EXPECT_FALSE(queue.Add(Method(1)));
+  EXPECT_EQ(0u, queue.PeekRequests());
+}
+
+TEST_F(JitThreadPoolTest, RequestQueueClear) {
+  RequestQueue queue;
+  for (size_t i = 0; i != 4u; ++i) {
+    EXPECT_TRUE(queue.Add(Method(i)));
+  }
+  EXPECT_EQ(Method(0), queue.Fetch());
+
+  std::set<ArtMethod*> visited;
+  queue.VisitEnqueuedMethods([&](ArtMethod* method) { visited.insert(method); });
+  EXPECT_EQ((std::set<ArtMethod*>{ Method(1), Method(2), Method(3) }), visited);
+
+  queue.Clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.PeekRequests());
+  visited.clear();
+  queue.VisitEnqueuedMethods([&](ArtMethod* method) { visited.insert(method); });
+  EXPECT_TRUE(visited.empty());
+
+  // Dropped methods are not enqueued again until removed, like fetched ones.
+  EXPECT_FALSE(queue.Add(Method(1)));
+  queue.Remove(Method(1));
+  EXPECT_TRUE(queue.Add(Method(1)));
+  EXPECT_EQ(Method(1), queue.Fetch());
+}
+
+// Runs until released, then counts itself.
+class BlockingTask : public Task {
+ public:
+  BlockingTask(std::atomic<bool>* started, std::atomic<bool>* release, std::atomic<int>* count)
+      : started_(started), release_(release), count_(count) {}
+
+  void Run([[maybe_unused]] Thread* self) override {
+    started_->store(true, std::memory_order_release);
+    while (!release_->load(std::memory_order_acquire)) {
+      usleep(1000);
+    }
+    count_->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  std::atomic<bool>* const started_;
+  std::atomic<bool>* const release_;
+  std::atomic<int>* const count_;
+};
+
+TEST_F(JitThreadPoolTest, ShutdownWithBlockedWaiters) {
+  static constexpr size_t kNumThreads = 3;
+  Thread* self = Thread::Current();
+  // The JIT workers have peers, and to create peers, the runtime needs to be started.
+  self->TransitionFromSuspendedToRunnable();
+  ASSERT_TRUE(runtime_->Start());
+
+  ScopedThreadSuspension sts(self, ThreadState::kNative);
+
+  std::unique_ptr<JitThreadPool> thread_pool(JitThreadPool::Create("JitThreadPoolTest pool",
+                                                                   kNumThreads));
+  std::atomic<bool> started(false);
+  std::atomic<bool> release(false);
+  std::atomic<int> count(0);
+  thread_pool->StartWorkers(self);
+  thread_pool->AddTask(self, new BlockingTask(&started, &release, &count));
+  while (!started.load(std::memory_order_acquire)) {
+    usleep(1000);
+  }
+
+  // One worker is busy and the others wait for tasks. Once stopped, the pool drops new tasks
+  // and compilation requests instead of waking up the waiting workers.
+  thread_pool->StopWorkers(self);
+  thread_pool->AddTask(self, new BlockingTask(&started, &release, &count));
+  thread_pool->AddTask(self, Method(0), CompilationKind::kBaseline);
+  thread_pool->AddTask(self, Method(1), CompilationKind::kOptimized);
+  thread_pool->AddTask(self, Method(2), CompilationKind::kOsr);
+  EXPECT_EQ(0u, thread_pool->GetTaskCount(self));
+
+  // Deleting the pool wakes up the waiting workers and waits for the busy one.
+  release.store(true, std::memory_order_release);
+  thread_pool.reset();
+  EXPECT_EQ(1, count.load(std::memory_order_relaxed));
+}
+
+}  // namespace jit
+}  // namespace art
@@ -16,6 +16,8 @@
 
 #include "profiling_info.h"
 
+#include <limits>
+
 #include "art_method-inl.h"
 #include "dex/dex_instruction.h"
 #include "jit/jit.h"
@@ -112,6 +114,14 @@ BranchCache* ProfilingInfo::GetBranchCache(uint32_t dex_pc) {
   return nullptr;
 }
 
+// Counts are only a heuristic for the compiler: like the baseline code and the assembly
+// stubs, we do not bother making the increment atomic.
+static void IncrementInlineCacheCount(uint16_t* count) {
+  if (*count != std::numeric_limits<uint16_t>::max()) {
+    ++*count;
+  }
+}
+
 void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   InlineCache* cache = GetInlineCache(dex_pc);
   if (cache == nullptr) {
@@ -121,7 +131,8 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
     mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
     mirror::Class* marked = ReadBarrier::IsMarked(existing);
     if (marked == cls) {
-      // Receiver type is already in the cache, nothing else to do.
+      // Receiver type is already in the cache, just count the call.
+      IncrementInlineCacheCount(&cache->counts_[i]);
       return;
     } else if (marked == nullptr) {
       // Cache entry is empty, try to put `cls` in it.
@@ -136,13 +147,16 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
         // entry in case the entry contains `cls`.
         --i;
       } else {
-        // We successfully set `cls`, just return.
+        // We successfully set `cls`, count the call and return.
+        IncrementInlineCacheCount(&cache->counts_[i]);
         return;
       }
     }
   }
   // Unsuccessfull - cache is full, making it megamorphic. We do not DCHECK it though,
-  // as the garbage collector might clear the entries concurrently.
+  // as the garbage collector might clear the entries concurrently. Like the assembly
+  // stubs, account the call to the last entry.
+  IncrementInlineCacheCount(&cache->counts_[InlineCache::kIndividualCacheSize - 1]);
 }
 
 ScopedProfilingInfoUse::ScopedProfilingInfoUse(jit::Jit* jit, ArtMethod* method, Thread* self)
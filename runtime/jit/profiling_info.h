@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "base/bit_utils.h"
 #include "base/macros.h"
 #include "base/value_object.h"
 #include "gc_root.h"
@@ -42,15 +43,28 @@ class Class;
 
 // Structure to store the classes seen at runtime for a specific instruction.
 // Once the classes_ array is full, we consider the INVOKE to be megamorphic.
+// Next to each class, we keep a saturating count of the calls that saw it, so that the
+// compiler can still find the dominant receivers of a megamorphic call.
 class InlineCache {
  public:
   // This is hard coded in the assembly stub art_quick_update_inline_cache.
   static constexpr uint8_t kIndividualCacheSize = 5;
 
+  // Baseline code only counts one in this many hits of the first entry, picked from the
+  // low bits of the method's baseline hotness count, to keep monomorphic call sites from
+  // writing to the cache on every call. Each sampled hit adds this value, so the counts
+  // of all entries stay on the same scale.
+  static constexpr uint16_t kCountSamplingRate = 16;
+  static_assert(IsPowerOfTwo(kCountSamplingRate));
+
   static constexpr MemberOffset ClassesOffset() {
     return MemberOffset(OFFSETOF_MEMBER(InlineCache, classes_));
   }
 
+  static constexpr MemberOffset CountsOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(InlineCache, counts_));
+  }
+
   // Encode the list of `dex_pcs` to fit into an uint32_t.
   static uint32_t EncodeDexPc(ArtMethod* method,
                               const std::vector<uint32_t>& dex_pcs,
@@ -66,6 +80,12 @@ class InlineCache {
  private:
   uint32_t dex_pc_;
   GcRoot<mirror::Class> classes_[kIndividualCacheSize];
+  // Number of calls seen for the corresponding entry of `classes_`. Once the cache is
+  // megamorphic, the last count accumulates the calls of all the receivers that did not
+  // get an entry of their own. The first count is sampled, see `kCountSamplingRate`.
+  // Counts stay at zero on targets whose baseline code and `art_quick_update_inline_cache`
+  // do not maintain them.
+  uint16_t counts_[kIndividualCacheSize];
 
   friend class jit::JitCodeCache;
   friend class ProfilingInfo;
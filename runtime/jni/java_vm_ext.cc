@@ -673,8 +673,9 @@ void JavaVMExt::CheckGlobalRefAllocationTracking() {
 }
 
 void JavaVMExt::MaybeTraceGlobals() {
-  if (global_ref_report_counter_++ == kGlobalRefReportInterval) {
-    global_ref_report_counter_ = 1;
+  if (global_ref_report_counter_.fetch_add(1u, std::memory_order_relaxed) ==
+          kGlobalRefReportInterval) {
+    global_ref_report_counter_.store(1u, std::memory_order_relaxed);
     ATraceIntegerValue("JNI Global Refs", globals_.NEntriesForGlobal());
   }
 }
@@ -694,7 +695,9 @@ jobject JavaVMExt::AddGlobalRef(Thread* self, ObjPtr<mirror::Object> obj) {
   IndirectRef ref;
   std::string error_msg;
   {
-    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
+    // Adding and removing global references only needs shared access to the table, so that
+    // threads churning through global references do not serialize on the lock.
+    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
     ref = globals_.Add(obj, &error_msg);
     MaybeTraceGlobals();
   }
@@ -745,7 +748,7 @@ void JavaVMExt::DeleteGlobalRef(Thread* self, jobject obj) {
     return;
   }
   {
-    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
+    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
     if (!globals_.Remove(obj)) {
       LOG(WARNING) << "JNI WARNING: DeleteGlobalRef(" << obj << ") "
                    << "failed to find entry";
@@ -789,12 +792,12 @@ void JavaVMExt::DumpForSigQuit(std::ostream& os) {
   Thread* self = Thread::Current();
   {
     ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-    os << "; globals=" << globals_.Capacity();
+    os << "; globals=" << globals_.NEntriesForGlobal();
   }
   {
     MutexLock mu(self, *Locks::jni_weak_globals_lock_);
-    if (weak_globals_.Capacity() > 0) {
-      os << " (plus " << weak_globals_.Capacity() << " weak)";
+    if (weak_globals_.NEntriesForGlobal() > 0) {
+      os << " (plus " << weak_globals_.NEntriesForGlobal() << " weak)";
     }
   }
   os << '\n';
@@ -903,7 +906,7 @@ void JavaVMExt::UpdateWeakGlobal(Thread* self, IndirectRef ref, ObjPtr<mirror::O
 void JavaVMExt::DumpReferenceTables(std::ostream& os) {
   Thread* self = Thread::Current();
   {
-    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
+    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
     globals_.Dump(os);
   }
   {
@@ -1181,7 +1184,8 @@ void JavaVMExt::TrimGlobals() {
 
 void JavaVMExt::VisitRoots(RootVisitor* visitor) {
   Thread* self = Thread::Current();
-  ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
+  // Exclusive access, as references may be added and removed under the shared lock.
+  WriterMutexLock mu(self, *Locks::jni_globals_lock_);
   globals_.VisitRoots(visitor, RootInfo(kRootJNIGlobal));
   // The weak_globals table is visited by the GC itself (because it mutates the table).
 }
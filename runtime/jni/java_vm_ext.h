@@ -241,7 +241,7 @@ class JavaVMExt : public JavaVM {
 
   void CheckGlobalRefAllocationTracking();
 
-  inline void MaybeTraceGlobals() REQUIRES(Locks::jni_globals_lock_);
+  inline void MaybeTraceGlobals() REQUIRES_SHARED(Locks::jni_globals_lock_);
   inline void MaybeTraceWeakGlobals() REQUIRES(Locks::jni_weak_globals_lock_);
 
   Runtime* const runtime_;
@@ -286,8 +286,8 @@ class JavaVMExt : public JavaVM {
   static constexpr uint32_t kGlobalRefReportInterval = 17;
   uint32_t weak_global_ref_report_counter_ GUARDED_BY(Locks::jni_weak_globals_lock_)
       = kGlobalRefReportInterval;
-  uint32_t global_ref_report_counter_ GUARDED_BY(Locks::jni_globals_lock_)
-      = kGlobalRefReportInterval;
+  // Updated concurrently by threads holding `Locks::jni_globals_lock_` only shared.
+  Atomic<uint32_t> global_ref_report_counter_{kGlobalRefReportInterval};
 
   friend class linker::ImageWriter;  // Uses `globals_` and `weak_globals_` without read barrier.
   friend IndirectReferenceTable* GetIndirectReferenceTable(ScopedObjectAccess& soa,
@@ -192,6 +192,22 @@ constexpr std::optional<int32_t> EncodeDatumId(DatumId datum_id) {
       return std::make_optional(
           statsd::
               ART_DATUM_DELTA_REPORTED__KIND__ART_DATUM_DELTA_GC_FULL_HEAP_COLLECTION_DURATION_MS);
+    // Per-phase GC histograms are not reported to statsd.
+    case DatumId::kYoungGcPauseTime:
+    case DatumId::kFullGcPauseTime:
+    case DatumId::kYoungGcMarkingTime:
+    case DatumId::kFullGcMarkingTime:
+    case DatumId::kYoungGcReferenceProcessingTime:
+    case DatumId::kFullGcReferenceProcessingTime:
+    case DatumId::kYoungGcCompactionTime:
+    case DatumId::kFullGcCompactionTime:
+    case DatumId::kYoungGcSweepingTime:
+    case DatumId::kFullGcSweepingTime:
+      return std::nullopt;
+    // Interpreter cache counters are not reported to statsd.
+    case DatumId::kInterpreterCacheHitCount:
+    case DatumId::kInterpreterCacheMissCount:
+      return std::nullopt;
   }
 }
 
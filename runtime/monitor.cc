@@ -16,6 +16,7 @@
 
 #include "monitor-inl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "android-base/stringprintf.h"
@@ -97,6 +98,7 @@ void Monitor::Init(uint32_t lock_profiling_threshold,
 Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_t hash_code)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_budget_(Mutex::kDefaultMaxTryLockSpins),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -131,6 +133,7 @@ Monitor::Monitor(Thread* self,
                  MonitorId id)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_budget_(Mutex::kDefaultMaxTryLockSpins),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -426,8 +429,8 @@ bool Monitor::TryLock(Thread* self, bool spin) {
     lock_count_++;
     CHECK_NE(lock_count_, 0u);  // Abort on overflow.
   } else {
-    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self)
-        : monitor_lock_.ExclusiveTryLock(self);
+    bool success = monitor_lock_.ExclusiveTryLock(self) ||
+        (spin && TryLockWithAdaptiveSpinning(self));
     if (!success) {
       return false;
     }
@@ -443,6 +446,20 @@ bool Monitor::TryLock(Thread* self, bool spin) {
   return true;
 }
 
+bool Monitor::TryLockWithAdaptiveSpinning(Thread* self) {
+  size_t spin_budget = spin_budget_.load(std::memory_order_relaxed);
+  bool success = monitor_lock_.ExclusiveTryLockWithSpinning(self, spin_budget);
+  // Spinning pays off if the owner releases the lock within a few brief waits. Spin longer next
+  // time if it did, and block sooner if it did not. Concurrent updates may be lost, that's fine.
+  size_t new_spin_budget = success
+      ? std::min(spin_budget * 2u, kMaxSpinBudget)
+      : std::max(spin_budget - 1u, kMinSpinBudget);
+  if (new_spin_budget != spin_budget) {
+    spin_budget_.store(new_spin_budget, std::memory_order_relaxed);
+  }
+  return success;
+}
+
 template <LockReason reason>
 void Monitor::Lock(Thread* self) {
   bool called_monitors_callback = false;
@@ -1088,6 +1105,15 @@ void Monitor::InflateThinLocked(Thread* self, Handle<mirror::Object> obj, LockWo
   }
 }
 
+// Returns whether the thread holding a thin lock is running, and may thus release the lock
+// shortly. Owners that wait, sleep or run native code while holding the lock will not.
+static bool IsThinLockOwnerRunnable(Thread* self, uint32_t owner_thread_id)
+    REQUIRES(!Locks::thread_list_lock_) {
+  MutexLock mu(self, *Locks::thread_list_lock_);
+  Thread* owner = Runtime::Current()->GetThreadList()->FindThreadByThreadId(owner_thread_id);
+  return owner == nullptr || owner->GetState() == ThreadState::kRunnable;
+}
+
 // Fool annotalysis into thinking that the lock on obj is acquired.
 static ObjPtr<mirror::Object> FakeLock(ObjPtr<mirror::Object> obj)
     EXCLUSIVE_LOCK_FUNCTION(obj.Ptr()) NO_THREAD_SAFETY_ANALYSIS {
@@ -1165,7 +1191,13 @@ ObjPtr<mirror::Object> Monitor::MonitorEnter(Thread* self,
           // Contention.
           contention_count++;
           Runtime* runtime = Runtime::Current();
-          if (contention_count
+          if (contention_count == kExtraSpinIters + 1u &&
+              !IsThinLockOwnerRunnable(self, owner_thread_id)) {
+            // Yielding to an owner that is not running is unlikely to let it release the lock.
+            // Inflate right away instead of after the maximum number of yields.
+            contention_count = 0;
+            InflateThinLocked(self, h_obj, lock_word, 0);
+          } else if (contention_count
               <= kExtraSpinIters + runtime->GetMaxSpinsBeforeThinLockInflation()) {
             // TODO: Consider switching the thread state to kWaitingForLockInflation when we are
             // yielding.  Use sched_yield instead of NanoSleep since NanoSleep can wait much longer
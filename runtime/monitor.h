@@ -61,6 +61,11 @@ class Monitor {
   // a lock word. See Runtime::max_spins_before_thin_lock_inflation_.
   constexpr static size_t kDefaultMaxSpinsBeforeThinLockInflation = 50;
 
+  // Bounds of the number of times a thread contending for an inflated monitor waits briefly
+  // for the monitor to be released before blocking. See `spin_budget_`.
+  constexpr static size_t kMinSpinBudget = 1;
+  constexpr static size_t kMaxSpinBudget = 20;
+
   static constexpr int kDefaultMonitorTimeoutMs = 500;
 
   static constexpr int kMonitorTimeoutMinMs = 200;
@@ -231,6 +236,12 @@ class Monitor {
       TRY_ACQUIRE(true, monitor_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Spin on a contended monitor_lock_ for up to `spin_budget_` brief waits, and adapt the
+  // budget to whether that acquired the lock.
+  bool TryLockWithAdaptiveSpinning(Thread* self)
+      TRY_ACQUIRE(true, monitor_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   template<LockReason reason = LockReason::kForLock>
   void Lock(Thread* self)
       ACQUIRE(monitor_lock_)
@@ -324,6 +335,12 @@ class Monitor {
   // monitor acquisition. Prevents deflation.
   std::atomic<size_t> num_waiters_;
 
+  // How many times a contending thread waits briefly for monitor_lock_ to be released before
+  // blocking. Doubled when spinning acquires the lock and decremented when it does not, so that
+  // it follows how long the lock has recently been held: we keep spinning on monitors held for
+  // short periods and stop burning CPU on monitors held across long critical sections.
+  std::atomic<size_t> spin_budget_;
+
   // Which thread currently owns the lock? monitor_lock_ only keeps the tid.
   // Only set while holding monitor_lock_. Non-locking readers only use it to
   // compare to self or for debugging.
@@ -431,6 +448,7 @@ class Monitor {
 
   friend class MonitorInfo;
   friend class MonitorList;
+  friend class MonitorTest;
   friend class MonitorPool;
   friend class mirror::Object;
   DISALLOW_COPY_AND_ASSIGN(Monitor);
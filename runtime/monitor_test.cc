@@ -16,6 +16,7 @@
 
 #include "monitor.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -24,12 +25,14 @@
 #include "base/time_utils.h"
 #include "class_linker-inl.h"
 #include "common_runtime_test.h"
+#include "gc/scoped_gc_critical_section.h"
 #include "handle_scope-inl.h"
 #include "jni/java_vm_ext.h"
 #include "mirror/class-inl.h"
 #include "mirror/string-inl.h"  // Strings are easiest to allocate
 #include "object_lock.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_list.h"
 #include "thread_pool.h"
 
 namespace art {
@@ -48,6 +51,23 @@ class MonitorTest : public CommonRuntimeTest {
   }
 
  public:
+  static size_t GetSpinBudget(Monitor* monitor) {
+    return monitor->spin_budget_.load(std::memory_order_relaxed);
+  }
+
+  static void SetSpinBudget(Monitor* monitor, size_t spin_budget) {
+    monitor->spin_budget_.store(spin_budget, std::memory_order_relaxed);
+  }
+
+  static bool TryLockWithAdaptiveSpinning(Monitor* monitor, Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_) NO_THREAD_SAFETY_ANALYSIS {
+    return monitor->TryLockWithAdaptiveSpinning(self);
+  }
+
+  static void UnlockMonitorLock(Monitor* monitor, Thread* self) NO_THREAD_SAFETY_ANALYSIS {
+    monitor->monitor_lock_.ExclusiveUnlock(self);
+  }
+
   std::unique_ptr<Monitor> monitor_;
   jobject object_;
   jobject watchdog_object_;
@@ -391,5 +411,111 @@ TEST_F(MonitorTest, TestTryLock) {
   thread_pool->StopWorkers(self);
 }
 
+// Inflates the monitor of `obj` by taking its identity hash code while holding the lock.
+static Monitor* InflateWithHashCode(Thread* self, Handle<mirror::Object> obj)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  ObjectLock<mirror::Object> lock(self, obj);
+  obj->IdentityHashCode();
+  LockWord lock_word = obj->GetLockWord(/*as_volatile=*/ true);
+  CHECK_EQ(lock_word.GetState(), LockWord::kFatLocked);
+  return lock_word.FatLockMonitor();
+}
+
+class FailingSpinTask : public Task {
+ public:
+  FailingSpinTask(Monitor* monitor, size_t expected_initial_budget)
+      : monitor_(monitor), expected_initial_budget_(expected_initial_budget) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    // The monitor is held by the main thread, spinning fails and decrements the budget.
+    size_t expected_budget = expected_initial_budget_;
+    for (size_t i = 0; i != Monitor::kMaxSpinBudget + 2u; ++i) {
+      EXPECT_EQ(expected_budget, MonitorTest::GetSpinBudget(monitor_));
+      EXPECT_FALSE(MonitorTest::TryLockWithAdaptiveSpinning(monitor_, self));
+      expected_budget = std::max(expected_budget - 1u, Monitor::kMinSpinBudget);
+    }
+    EXPECT_EQ(Monitor::kMinSpinBudget, MonitorTest::GetSpinBudget(monitor_));
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  Monitor* const monitor_;
+  const size_t expected_initial_budget_;
+};
+
+TEST_F(MonitorTest, AdaptiveSpinBudget) {
+  Thread* const self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool(ThreadPool::Create("the pool", 1));
+  ScopedObjectAccess soa(self);
+  StackHandleScope<1> hs(self);
+  Handle<mirror::Object> obj(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "hello, world!")));
+  ASSERT_TRUE(obj != nullptr);
+  Monitor* monitor = InflateWithHashCode(self, obj);
+  EXPECT_EQ(Mutex::kDefaultMaxTryLockSpins, GetSpinBudget(monitor));
+
+  // Spinning on a free monitor succeeds and doubles the budget up to the maximum.
+  SetSpinBudget(monitor, Monitor::kMinSpinBudget);
+  size_t expected_budget = Monitor::kMinSpinBudget;
+  for (size_t i = 0; i != 8u; ++i) {
+    ASSERT_TRUE(TryLockWithAdaptiveSpinning(monitor, self));
+    UnlockMonitorLock(monitor, self);
+    expected_budget = std::min(expected_budget * 2u, Monitor::kMaxSpinBudget);
+    EXPECT_EQ(expected_budget, GetSpinBudget(monitor));
+  }
+  EXPECT_EQ(Monitor::kMaxSpinBudget, GetSpinBudget(monitor));
+
+  // Spinning on a held monitor fails and decays the budget down to the minimum.
+  {
+    ObjectLock<mirror::Object> lock(self, obj);
+    thread_pool->AddTask(self, new FailingSpinTask(monitor, Monitor::kMaxSpinBudget));
+    thread_pool->StartWorkers(self);
+    ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+    thread_pool->Wait(self, /*do_work=*/false, /*may_hold_locks=*/false);
+  }
+  thread_pool->StopWorkers(self);
+}
+
+TEST_F(MonitorTest, DeflateIdleMonitors) {
+  Thread* const self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  StackHandleScope<2> hs(self);
+  Handle<mirror::Object> idle(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "idle")));
+  Handle<mirror::Object> held(
+      hs.NewHandle<mirror::Object>(mirror::String::AllocFromModifiedUtf8(self, "held")));
+  ASSERT_TRUE(idle != nullptr);
+  ASSERT_TRUE(held != nullptr);
+  InflateWithHashCode(self, idle);
+  int32_t idle_hash_code = idle->IdentityHashCode();
+  Monitor* held_monitor = InflateWithHashCode(self, held);
+  ASSERT_EQ(idle->GetLockWord(/*as_volatile=*/ true).GetState(), LockWord::kFatLocked);
+
+  {
+    ObjectLock<mirror::Object> lock(self, held);
+    size_t count;
+    {
+      ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+      gc::ScopedGCCriticalSection gcs(self, gc::kGcCauseTrim, gc::kCollectorTypeHeapTrim);
+      ScopedSuspendAll ssa(__FUNCTION__);
+      count = Runtime::Current()->GetMonitorList()->DeflateMonitors();
+    }
+    EXPECT_GE(count, 1u);
+    // The idle monitor is deflated and its hash code moves back to the lock word.
+    LockWord idle_lock_word = idle->GetLockWord(/*as_volatile=*/ true);
+    EXPECT_EQ(idle_lock_word.GetState(), LockWord::kHashCode);
+    EXPECT_EQ(idle_lock_word.GetHashCode(), idle_hash_code);
+    EXPECT_EQ(idle->IdentityHashCode(), idle_hash_code);
+    // The held monitor stays inflated.
+    LockWord held_lock_word = held->GetLockWord(/*as_volatile=*/ true);
+    EXPECT_EQ(held_lock_word.GetState(), LockWord::kFatLocked);
+    EXPECT_EQ(held_lock_word.FatLockMonitor(), held_monitor);
+    EXPECT_EQ(held_monitor->GetOwner(), self);
+  }
+}
 
 }  // namespace art
@@ -44,6 +44,7 @@
 #include "signal_set.h"
 #include "thread.h"
 #include "thread_list.h"
+#include "trace.h"
 
 namespace art {
 
@@ -146,6 +147,9 @@ void SignalCatcher::HandleSigUsr1() {
   LOG(INFO) << "SIGUSR1 forcing GC (no HPROF) and profile save";
   Runtime::Current()->GetHeap()->CollectGarbage(/* clear_soft_references= */ false);
   ProfileSaver::ForceProcessProfiles();
+  if (Trace::DumpRingBuffers()) {
+    LOG(INFO) << "SIGUSR1 dumped method trace ring buffers";
+  }
 }
 
 int SignalCatcher::WaitForSignal(Thread* self, SignalSet& signals) {
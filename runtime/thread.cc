@@ -2607,6 +2607,7 @@ void Thread::Destroy(bool should_run_callbacks) {
     ScopedObjectAccess soa(self);
     Runtime::Current()->GetHeap()->RevokeThreadLocalBuffers(this);
   }
+  GetInterpreterCache()->ReportMetrics(this);
   // Mark-stack revocation must be performed at the very end. No
   // checkpoint/flip-function or read-barrier should be called after this.
   if (gUseReadBarrier) {
@@ -4527,6 +4528,9 @@ void Thread::SweepInterpreterCache(IsMarkedVisitor* visitor) {
   for (InterpreterCache::Entry& entry : GetInterpreterCache()->GetArray()) {
     SweepCacheEntry(visitor, reinterpret_cast<const Instruction*>(entry.first), &entry.second);
   }
+  // Every GC sweeps the caches of all threads, so this is also a good time to
+  // publish their hit and miss counts.
+  GetInterpreterCache()->ReportMetrics(this);
 }
 
 // FIXME: clang-r433403 reports the below function exceeds frame size limit.
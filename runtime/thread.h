@@ -1443,8 +1443,12 @@ class Thread {
     return ThreadOffset<pointer_size>(OFFSETOF_MEMBER(Thread, interpreter_cache_));
   }
 
-  static constexpr int InterpreterCacheSizeLog2() {
-    return WhichPowerOf2(InterpreterCache::kSize);
+  static constexpr int InterpreterCacheSetsLog2() {
+    return WhichPowerOf2(InterpreterCache::kSets);
+  }
+
+  static constexpr int InterpreterCacheSetSizeLog2() {
+    return WhichPowerOf2(sizeof(InterpreterCache::Entry) * InterpreterCache::kWays);
   }
 
   static constexpr uint32_t AllThreadFlags() {
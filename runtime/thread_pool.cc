@@ -217,6 +217,10 @@ void AbstractThreadPool::WaitForWorkersToBeCreated() {
   creation_barier_.Increment(Thread::Current(), 0);
 }
 
+bool AbstractThreadPool::AreWorkersCreated() {
+  return creation_barier_.GetCount(Thread::Current()) == 0;
+}
+
 const std::vector<ThreadPoolWorker*>& AbstractThreadPool::GetWorkers() {
   // Wait for all the workers to be created before returning them.
   WaitForWorkersToBeCreated();
@@ -355,4 +359,299 @@ void AbstractThreadPool::CheckPthreadPriority(int priority) {
 #endif
 }
 
+WorkStealingThreadPool::Deque::Deque()
+    : top_(0),
+      bottom_(0),
+      tasks_(new Atomic<Task*>[kCapacity]) {}
+
+bool WorkStealingThreadPool::Deque::Push(Task* task) {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  const int64_t top = top_.load(std::memory_order_acquire);
+  if (static_cast<size_t>(bottom - top) >= kCapacity) {
+    return false;
+  }
+  tasks_[bottom & kMask].store(task, std::memory_order_relaxed);
+  // Publish the task before making it visible to thieves.
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+  return true;
+}
+
+Task* WorkStealingThreadPool::Deque::Pop() {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(bottom, std::memory_order_relaxed);
+  // Order the reservation of `bottom` against the read of `top`, see Steal.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    // The deque was empty.
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  Task* task = tasks_[bottom & kMask].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // Last task in the deque, race against thieves for it.
+    if (!top_.CompareAndSetStrongSequentiallyConsistent(top, top + 1)) {
+      task = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+Task* WorkStealingThreadPool::Deque::Steal() {
+  const int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return nullptr;
+  }
+  Task* task = tasks_[top & kMask].load(std::memory_order_relaxed);
+  if (!top_.CompareAndSetStrongSequentiallyConsistent(top, top + 1)) {
+    // Lost the race against the owner or another thief.
+    return nullptr;
+  }
+  return task;
+}
+
+size_t WorkStealingThreadPool::Deque::Size() const {
+  const int64_t top = top_.load(std::memory_order_seq_cst);
+  const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(const char* name,
+                                               size_t num_threads,
+                                               bool create_peers,
+                                               size_t worker_stack_size)
+    : AbstractThreadPool(name, num_threads, create_peers, worker_stack_size),
+      slots_(new WorkerSlot[num_threads]),
+      num_slots_(num_threads),
+      num_waiting_(0),
+      next_inbox_(0) {
+  CHECK_NE(num_threads, 0u);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  DeleteThreads();
+  RemoveAllTasks(Thread::Current());
+}
+
+size_t WorkStealingThreadPool::FindWorkerSlot(Thread* self) const {
+  for (size_t i = 0; i < num_slots_; ++i) {
+    if (slots_[i].owner.load(std::memory_order_relaxed) == self) {
+      return i;
+    }
+  }
+  return kNoAffinity;
+}
+
+size_t WorkStealingThreadPool::ClaimWorkerSlot(Thread* self) {
+  size_t slot_index = FindWorkerSlot(self);
+  if (slot_index != kNoAffinity) {
+    return slot_index;
+  }
+  // There are as many slots as workers and exiting workers release their slot, so one is free.
+  for (size_t i = 0; i < num_slots_; ++i) {
+    if (slots_[i].owner.CompareAndSetStrongSequentiallyConsistent(nullptr, self)) {
+      return i;
+    }
+  }
+  LOG(FATAL) << "No free worker slot in " << name_;
+  UNREACHABLE();
+}
+
+void WorkStealingThreadPool::AddTask(Thread* self, Task* task, size_t affinity) {
+  const size_t slot_index = FindWorkerSlot(self);
+  if (slot_index != kNoAffinity &&
+      (affinity == kNoAffinity || affinity % num_slots_ == slot_index) &&
+      slots_[slot_index].deque.Push(task)) {
+    SignalWaitingWorker(self);
+    return;
+  }
+  MutexLock mu(self, task_queue_lock_);
+  size_t inbox_index;
+  if (affinity != kNoAffinity) {
+    inbox_index = affinity % num_slots_;
+  } else if (slot_index != kNoAffinity) {
+    // Our own deque is full.
+    inbox_index = slot_index;
+  } else {
+    inbox_index = next_inbox_;
+    next_inbox_ = (next_inbox_ + 1) % num_slots_;
+  }
+  slots_[inbox_index].inbox.push_back(task);
+  // If we have any waiters, signal one. Any worker may pick up the task from another inbox.
+  if (started_ && waiting_count_ != 0) {
+    task_queue_condition_.Signal(self);
+  }
+}
+
+void WorkStealingThreadPool::SignalWaitingWorker(Thread* self) {
+  // Pairs with the fence in GetTask: either the worker going to sleep sees the task we just
+  // pushed, or we see it waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_waiting_.load(std::memory_order_relaxed) != 0) {
+    MutexLock mu(self, task_queue_lock_);
+    if (started_ && waiting_count_ != 0) {
+      task_queue_condition_.Signal(self);
+    }
+  }
+}
+
+Task* WorkStealingThreadPool::TryGetTaskLockFree(size_t slot_index) {
+  Task* task = slots_[slot_index].deque.Pop();
+  if (task != nullptr) {
+    return task;
+  }
+  for (size_t i = 1; i < num_slots_; ++i) {
+    task = slots_[(slot_index + i) % num_slots_].deque.Steal();
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+Task* WorkStealingThreadPool::TryGetTaskFromInboxesLocked(Thread* self, size_t slot_index) {
+  const bool is_worker = slot_index != kNoAffinity;
+  if (is_worker) {
+    WorkerSlot& slot = slots_[slot_index];
+    Task* task = slot.deque.Pop();
+    if (task != nullptr) {
+      return task;
+    }
+    if (!slot.inbox.empty()) {
+      task = slot.inbox.front();
+      slot.inbox.pop_front();
+      // Move the rest of the inbox to our deque so that it can be taken without the lock.
+      bool moved = false;
+      while (!slot.inbox.empty() && slot.deque.Push(slot.inbox.front())) {
+        slot.inbox.pop_front();
+        moved = true;
+      }
+      if (moved && waiting_count_ != 0) {
+        task_queue_condition_.Signal(self);
+      }
+      return task;
+    }
+  }
+  const size_t start = is_worker ? slot_index + 1 : 0u;
+  for (size_t i = 0; i < num_slots_; ++i) {
+    std::deque<Task*>& inbox = slots_[(start + i) % num_slots_].inbox;
+    if (!inbox.empty()) {
+      Task* task = inbox.front();
+      inbox.pop_front();
+      return task;
+    }
+  }
+  for (size_t i = 0; i < num_slots_; ++i) {
+    Task* task = slots_[(start + i) % num_slots_].deque.Steal();
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+Task* WorkStealingThreadPool::TryGetTaskLocked() {
+  if (!started_) {
+    return nullptr;
+  }
+  Thread* self = Thread::Current();
+  return TryGetTaskFromInboxesLocked(self, FindWorkerSlot(self));
+}
+
+bool WorkStealingThreadPool::HasQueuedTasksLocked() const {
+  for (size_t i = 0; i < num_slots_; ++i) {
+    if (!slots_[i].inbox.empty() || slots_[i].deque.Size() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::HasOutstandingTasks() const {
+  return started_ && HasQueuedTasksLocked();
+}
+
+Task* WorkStealingThreadPool::GetTask(Thread* self) {
+  const size_t slot_index = ClaimWorkerSlot(self);
+  while (true) {
+    if (CanRunTasksRacy(slot_index)) {
+      Task* task = TryGetTaskLockFree(slot_index);
+      if (task != nullptr) {
+        return task;
+      }
+    }
+
+    MutexLock mu(self, task_queue_lock_);
+    if (IsShuttingDown()) {
+      break;
+    }
+    // Ensure that we don't use more threads than the maximum active workers.
+    const size_t active_threads = GetThreadCount() - waiting_count_;
+    // <= since self is considered an active worker.
+    const bool may_run_task = active_threads <= max_active_workers_;
+    if (may_run_task) {
+      Task* task = TryGetTaskLocked();
+      if (task != nullptr) {
+        return task;
+      }
+    }
+
+    ++waiting_count_;
+    num_waiting_.fetch_add(1u, std::memory_order_relaxed);
+    // Pairs with the fence in SignalWaitingWorker. A task pushed to a deque before the producer
+    // could see us waiting is found by the check below.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!may_run_task || !HasOutstandingTasks()) {
+      if (waiting_count_ == GetThreadCount() && !HasOutstandingTasks()) {
+        // We may be done, lets broadcast to the completion condition.
+        completion_condition_.Broadcast(self);
+      }
+      task_queue_condition_.Wait(self);
+    }
+    num_waiting_.fetch_sub(1u, std::memory_order_relaxed);
+    --waiting_count_;
+  }
+
+  // We are shutting down, release our slot so that it can be reused if threads get recreated.
+  slots_[slot_index].owner.store(nullptr, std::memory_order_release);
+  return nullptr;
+}
+
+size_t WorkStealingThreadPool::GetTaskCount(Thread* self) {
+  MutexLock mu(self, task_queue_lock_);
+  size_t count = 0;
+  for (size_t i = 0; i < num_slots_; ++i) {
+    count += slots_[i].inbox.size() + slots_[i].deque.Size();
+  }
+  return count;
+}
+
+void WorkStealingThreadPool::RemoveAllTasks(Thread* self) {
+  // As for ThreadPool, we are responsible for calling Finalize on all the tasks.
+  std::vector<Task*> tasks;
+  {
+    MutexLock mu(self, task_queue_lock_);
+    for (size_t i = 0; i < num_slots_; ++i) {
+      std::deque<Task*>& inbox = slots_[i].inbox;
+      tasks.insert(tasks.end(), inbox.begin(), inbox.end());
+      inbox.clear();
+    }
+  }
+  for (size_t i = 0; i < num_slots_; ++i) {
+    while (slots_[i].deque.Size() != 0) {
+      Task* task = slots_[i].deque.Steal();
+      if (task != nullptr) {
+        tasks.push_back(task);
+      }
+    }
+  }
+  for (Task* task : tasks) {
+    task->Finalize();
+  }
+}
+
 }  // namespace art
@@ -19,9 +19,12 @@
 
 #include <deque>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "barrier.h"
+#include "base/atomic.h"
+#include "base/bit_utils.h"
 #include "base/mem_map.h"
 #include "base/mutex.h"
 
@@ -168,11 +171,14 @@ class AbstractThreadPool {
   // Wait for workers to be created.
   void WaitForWorkersToBeCreated();
 
+  // Return whether all the workers have been created, without waiting for them.
+  bool AreWorkersCreated();
+
   virtual ~AbstractThreadPool() {}
 
  protected:
   // get a task to run, blocks if there are no tasks left
-  Task* GetTask(Thread* self) REQUIRES(!task_queue_lock_);
+  virtual Task* GetTask(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Try to get a task, returning null if there is none available.
   Task* TryGetTask(Thread* self) REQUIRES(!task_queue_lock_);
@@ -253,6 +259,118 @@ class ThreadPool : public AbstractThreadPool {
   DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 };
 
+// A thread pool where each worker owns a lock-free Chase-Lev deque. Tasks added by a worker are
+// pushed to its own deque and idle workers steal from the other end of their peers' deques, so
+// recursive and fine-grained work does not serialize on `task_queue_lock_`. Tasks added by
+// threads outside of the pool go to a per-worker inbox, which is still protected by
+// `task_queue_lock_` but is drained by its owner in a single batch.
+class WorkStealingThreadPool : public AbstractThreadPool {
+ public:
+  // Passed as `affinity` when the task may be run by any worker.
+  static constexpr size_t kNoAffinity = static_cast<size_t>(-1);
+
+  static WorkStealingThreadPool* Create(
+      const char* name,
+      size_t num_threads,
+      bool create_peers = false,
+      size_t worker_stack_size = ThreadPoolWorker::kDefaultStackSize) {
+    WorkStealingThreadPool* pool =
+        new WorkStealingThreadPool(name, num_threads, create_peers, worker_stack_size);
+    pool->CreateThreads();
+    return pool;
+  }
+
+  void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_) override {
+    AddTask(self, task, kNoAffinity);
+  }
+
+  // Add a task, preferably to be run by worker `affinity % GetThreadCount()`. This is only a
+  // hint: idle workers may still steal the task. When called from a worker of this pool with
+  // `kNoAffinity`, the task is pushed to the calling worker's own deque without taking any lock.
+  void AddTask(Thread* self, Task* task, size_t affinity) REQUIRES(!task_queue_lock_);
+
+  size_t GetTaskCount(Thread* self) REQUIRES(!task_queue_lock_) override;
+  void RemoveAllTasks(Thread* self) REQUIRES(!task_queue_lock_) override;
+  ~WorkStealingThreadPool() override;
+
+ protected:
+  Task* GetTask(Thread* self) REQUIRES(!task_queue_lock_) override;
+  Task* TryGetTaskLocked() REQUIRES(task_queue_lock_) override;
+  bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) override;
+
+ private:
+  // Fixed-size Chase-Lev work-stealing deque. Only the owning worker may call Push and Pop, any
+  // thread may call Steal. Push fails when the deque is full, in which case the caller falls
+  // back to the owner's inbox.
+  class Deque {
+   public:
+    static constexpr size_t kCapacity = 1024;
+
+    Deque();
+
+    bool Push(Task* task);
+    Task* Pop();
+    Task* Steal();
+
+    // Approximate number of tasks in the deque, exact when there are no concurrent operations.
+    size_t Size() const;
+
+   private:
+    static constexpr size_t kMask = kCapacity - 1;
+    static_assert(IsPowerOfTwo(kCapacity));
+
+    Atomic<int64_t> top_;
+    Atomic<int64_t> bottom_;
+    std::unique_ptr<Atomic<Task*>[]> tasks_;
+
+    DISALLOW_COPY_AND_ASSIGN(Deque);
+  };
+
+  struct WorkerSlot {
+    // Worker thread currently owning `deque`, or null if the slot is free.
+    Atomic<Thread*> owner{nullptr};
+    Deque deque;
+    // Tasks added by threads other than the owner. Guarded by `task_queue_lock_`.
+    std::deque<Task*> inbox;
+  };
+
+  WorkStealingThreadPool(const char* name,
+                         size_t num_threads,
+                         bool create_peers,
+                         size_t worker_stack_size);
+
+  // Returns the index of the slot owned by `self`, or `kNoAffinity` if `self` is not a worker of
+  // this pool.
+  size_t FindWorkerSlot(Thread* self) const;
+  size_t ClaimWorkerSlot(Thread* self);
+
+  // Pop from the slot's own deque, then steal from the other deques. Does not take any lock.
+  Task* TryGetTaskLockFree(size_t slot_index);
+  // Take a task from the inboxes, preferring the one of `slot_index` which is drained into its
+  // deque. Also steals from deques since the caller may not be a worker of this pool.
+  Task* TryGetTaskFromInboxesLocked(Thread* self, size_t slot_index) REQUIRES(task_queue_lock_);
+  bool HasQueuedTasksLocked() const REQUIRES(task_queue_lock_);
+
+  // Wake up a waiting worker after a lock-free push, if there is any.
+  void SignalWaitingWorker(Thread* self) REQUIRES(!task_queue_lock_);
+
+  // Racy reads used to skip the lock on the fast path. The lock-protected slow path in GetTask
+  // re-checks these before a worker goes to sleep.
+  bool CanRunTasksRacy(size_t slot_index) const NO_THREAD_SAFETY_ANALYSIS {
+    return started_ && !shutting_down_ && slot_index < max_active_workers_;
+  }
+
+  std::unique_ptr<WorkerSlot[]> slots_;
+  const size_t num_slots_;
+  // Mirror of `waiting_count_` which can be read without the lock by producers pushing to a
+  // deque. Used together with sequentially consistent fences to avoid lost wake-ups.
+  Atomic<size_t> num_waiting_;
+  // Round-robin index for external tasks without an affinity.
+  size_t next_inbox_ GUARDED_BY(task_queue_lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingThreadPool);
+};
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_THREAD_POOL_H_
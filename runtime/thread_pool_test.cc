@@ -127,7 +127,7 @@ TEST_F(ThreadPoolTest, StopWait) {
 
 class TreeTask : public Task {
  public:
-  TreeTask(ThreadPool* const thread_pool, AtomicInteger* count, int depth)
+  TreeTask(AbstractThreadPool* const thread_pool, AtomicInteger* count, int depth)
       : thread_pool_(thread_pool),
         count_(count),
         depth_(depth) {}
@@ -146,7 +146,7 @@ class TreeTask : public Task {
   }
 
  private:
-  ThreadPool* const thread_pool_;
+  AbstractThreadPool* const thread_pool_;
   AtomicInteger* const count_;
   const int depth_;
 };
@@ -164,6 +164,63 @@ TEST_F(ThreadPoolTest, RecursiveTest) {
   EXPECT_EQ((1 << depth) - 1, count.load(std::memory_order_seq_cst));
 }
 
+// Check that the work-stealing thread pool runs tasks added from outside of the pool, with and
+// without an affinity hint.
+TEST_F(ThreadPoolTest, WorkStealingCheckRun) {
+  Thread* self = Thread::Current();
+  std::unique_ptr<WorkStealingThreadPool> thread_pool(
+      WorkStealingThreadPool::Create("Work-stealing thread pool test thread pool", num_threads));
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    if ((i & 1) == 0) {
+      thread_pool->AddTask(self, new CountTask(&count));
+    } else {
+      thread_pool->AddTask(self, new CountTask(&count), /* affinity= */ i);
+    }
+  }
+  EXPECT_EQ(static_cast<size_t>(num_tasks), thread_pool->GetTaskCount(self));
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, true, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(0u, thread_pool->GetTaskCount(self));
+}
+
+TEST_F(ThreadPoolTest, WorkStealingStopWait) {
+  Thread* self = Thread::Current();
+  std::unique_ptr<WorkStealingThreadPool> thread_pool(
+      WorkStealingThreadPool::Create("Work-stealing thread pool test thread pool", num_threads));
+
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 100;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool->AddTask(self, new CountTask(&count));
+  }
+
+  thread_pool->StartWorkers(self);
+  usleep(200);
+  thread_pool->StopWorkers(self);
+
+  thread_pool->Wait(self, false, false);  // We should not deadlock here.
+
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /* do_work= */ true, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+}
+
+// Test that tasks added by workers to their own deque get run, including by thieves.
+TEST_F(ThreadPoolTest, WorkStealingRecursiveTest) {
+  Thread* self = Thread::Current();
+  std::unique_ptr<WorkStealingThreadPool> thread_pool(
+      WorkStealingThreadPool::Create("Work-stealing thread pool test thread pool", num_threads));
+  AtomicInteger count(0);
+  static const int depth = 12;
+  thread_pool->AddTask(self, new TreeTask(thread_pool.get(), &count, depth));
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, true, false);
+  EXPECT_EQ((1 << depth) - 1, count.load(std::memory_order_seq_cst));
+}
+
 class PeerTask : public Task {
  public:
   PeerTask() {}
@@ -25,6 +25,7 @@
 #include "art_method-inl.h"
 #include "base/casts.h"
 #include "base/enums.h"
+#include "base/leb128.h"
 #include "base/os.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
@@ -60,12 +61,14 @@ static constexpr size_t TraceActionBits = MinimumBitsToStore(
 static constexpr uint8_t kOpNewMethod = 1U;
 static constexpr uint8_t kOpNewThread = 2U;
 static constexpr uint8_t kOpTraceSummary = 3U;
+static constexpr uint8_t kOpThreadEvents = 4U;
 
 static const char     kTraceTokenChar             = '*';
 static const uint16_t kTraceHeaderLength          = 32;
 static const uint32_t kTraceMagicValue            = 0x574f4c53;
 static const uint16_t kTraceVersionSingleClock    = 2;
 static const uint16_t kTraceVersionDualClock      = 3;
+static const uint16_t kTraceVersionRingBufferFlag = 0xE0;
 static const uint16_t kTraceRecordSizeSingleClock = 10;  // using v2
 static const uint16_t kTraceRecordSizeDualClock   = 14;  // using v3 with two timestamps
 
@@ -250,6 +253,19 @@ static uint16_t GetTraceVersion(TraceClockSource clock_source) {
                                                     : kTraceVersionSingleClock;
 }
 
+static const char* GetClockSourceName(TraceClockSource clock_source) {
+  switch (clock_source) {
+    case TraceClockSource::kDual:
+      return "dual";
+    case TraceClockSource::kThreadCpu:
+      return "thread-cpu";
+    case TraceClockSource::kWall:
+      return "wall";
+  }
+  LOG(FATAL) << "Unreachable";
+  UNREACHABLE();
+}
+
 static uint16_t GetRecordSize(TraceClockSource clock_source) {
   return (clock_source == TraceClockSource::kDual) ? kTraceRecordSizeDualClock
                                                     : kTraceRecordSizeSingleClock;
@@ -641,9 +657,15 @@ void Trace::StopTracing(bool finish_tracing, bool flush_file) {
     // make sure that the per-thread buffer is reset before resetting the_trace_.
     {
       MutexLock tl_lock(Thread::Current(), *Locks::thread_list_lock_);
+      const bool ring_buffer = the_trace->trace_output_mode_ == TraceOutputMode::kRingBuffer;
+      if (ring_buffer && finish_tracing) {
+        the_trace->WriteRingBuffers(runtime->GetThreadList()->GetList());
+      }
       for (Thread* thread : Runtime::Current()->GetThreadList()->GetList()) {
         if (thread->GetMethodTraceBuffer() != nullptr) {
-          the_trace_->FlushStreamingBuffer(thread);
+          if (!ring_buffer) {
+            the_trace_->FlushStreamingBuffer(thread);
+          }
           thread->ResetMethodTraceBuffer();
         }
         // Record threads here before resetting the_trace_ to prevent any races between
@@ -687,9 +709,33 @@ void Trace::StopTracing(bool finish_tracing, bool flush_file) {
 
 void Trace::FlushThreadBuffer(Thread* self) {
   MutexLock mu(self, *Locks::trace_lock_);
+  if (the_trace_->trace_output_mode_ == TraceOutputMode::kRingBuffer) {
+    // Ring buffers of exiting threads are dropped, dumps only contain live threads.
+    return;
+  }
   the_trace_->FlushStreamingBuffer(self);
 }
 
+bool Trace::DumpRingBuffers() {
+  Thread* self = Thread::Current();
+  {
+    // Avoid suspending all threads if there is nothing to dump.
+    MutexLock mu(self, *Locks::trace_lock_);
+    if (the_trace_ == nullptr || the_trace_->trace_output_mode_ != TraceOutputMode::kRingBuffer) {
+      return false;
+    }
+  }
+  // The ring buffers are written without synchronization by their owning threads.
+  ScopedSuspendAll ssa(__FUNCTION__);
+  MutexLock mu(self, *Locks::trace_lock_);
+  if (the_trace_ == nullptr || the_trace_->trace_output_mode_ != TraceOutputMode::kRingBuffer) {
+    return false;
+  }
+  MutexLock tl_lock(self, *Locks::thread_list_lock_);
+  the_trace_->WriteRingBuffers(Runtime::Current()->GetThreadList()->GetList());
+  return true;
+}
+
 void Trace::Abort() {
   // Do not write anything anymore.
   StopTracing(false, false);
@@ -752,7 +798,10 @@ Trace::Trace(File* trace_file,
              TraceOutputMode output_mode,
              TraceMode trace_mode)
     : trace_file_(trace_file),
-      buf_(new uint8_t[std::max(kMinBufSize, buffer_size)]()),
+      // In ring buffer mode, the events only go to the per-thread buffers.
+      buf_(output_mode == TraceOutputMode::kRingBuffer
+               ? nullptr
+               : new uint8_t[std::max(kMinBufSize, buffer_size)]()),
       flags_(flags),
       trace_output_mode_(output_mode),
       trace_mode_(trace_mode),
@@ -765,6 +814,11 @@ Trace::Trace(File* trace_file,
       stop_tracing_(false),
       tracing_lock_("tracing lock", LockLevel::kTracingStreamingLock) {
   CHECK_IMPLIES(trace_file == nullptr, output_mode == TraceOutputMode::kDDMS);
+  if (output_mode == TraceOutputMode::kRingBuffer) {
+    // Each dump of the ring buffers writes its own header.
+    cur_offset_.store(0, std::memory_order_relaxed);
+    return;
+  }
 
   uint16_t trace_version = GetTraceVersion(clock_source_);
   if (output_mode == TraceOutputMode::kStreaming) {
@@ -817,6 +871,10 @@ void Trace::DumpBuf(uint8_t* buf, size_t buf_size, TraceClockSource clock_source
 }
 
 void Trace::FinishTracing() {
+  if (trace_output_mode_ == TraceOutputMode::kRingBuffer) {
+    // The final dump is written by StopTracing() while all threads are suspended.
+    return;
+  }
   size_t final_offset = 0;
   if (trace_output_mode_ != TraceOutputMode::kStreaming) {
     final_offset = cur_offset_.load(std::memory_order_relaxed);
@@ -830,15 +888,7 @@ void Trace::FinishTracing() {
   os << StringPrintf("%cversion\n", kTraceTokenChar);
   os << StringPrintf("%d\n", GetTraceVersion(clock_source_));
   os << StringPrintf("data-file-overflow=%s\n", overflow_ ? "true" : "false");
-  if (UseThreadCpuClock()) {
-    if (UseWallClock()) {
-      os << StringPrintf("clock=dual\n");
-    } else {
-      os << StringPrintf("clock=thread-cpu\n");
-    }
-  } else {
-    os << StringPrintf("clock=wall\n");
-  }
+  os << StringPrintf("clock=%s\n", GetClockSourceName(clock_source_));
   os << StringPrintf("elapsed-time-usec=%" PRIu64 "\n", elapsed);
   if (trace_output_mode_ != TraceOutputMode::kStreaming) {
     size_t num_records = (final_offset - kTraceHeaderLength) / GetRecordSize(clock_source_);
@@ -1018,35 +1068,44 @@ void Trace::RecordStreamingMethodEvent(Thread* thread,
     thread->SetMethodTraceBuffer(method_trace_buffer);
     *current_offset = 0;
 
-    // This is the first event from this thread, so first record information about the thread.
-    std::string thread_name;
-    thread->GetThreadName(thread_name);
-    static constexpr size_t kThreadNameHeaderSize = 7;
-    uint8_t header[kThreadNameHeaderSize];
-    Append2LE(header, 0);
-    header[2] = kOpNewThread;
-    // We use only 16 bits to encode thread id. On Android, we don't expect to use more than
-    // 16-bits for a Tid. For 32-bit platforms it is always ensured we use less than 16 bits.
-    // See  __check_max_thread_id in bionic for more details. Even on 64-bit the max threads
-    // is currently less than 65536.
-    // TODO(mythria): On host, we know thread ids can be greater than 16 bits. Consider adding
-    // a map similar to method ids.
-    DCHECK(!kIsTargetBuild || thread->GetTid() < (1 << 16));
-    Append2LE(header + 3, static_cast<uint16_t>(thread->GetTid()));
-    Append2LE(header + 5, static_cast<uint16_t>(thread_name.length()));
-
-    {
-      MutexLock mu(Thread::Current(), tracing_lock_);
-      if (!trace_file_->WriteFully(header, kThreadNameHeaderSize) ||
-          !trace_file_->WriteFully(reinterpret_cast<const uint8_t*>(thread_name.c_str()),
-                                   thread_name.length())) {
-        PLOG(WARNING) << "Failed streaming a tracing event.";
+    if (trace_output_mode_ == TraceOutputMode::kStreaming) {
+      // This is the first event from this thread, so first record information about the thread.
+      std::string thread_name;
+      thread->GetThreadName(thread_name);
+      static constexpr size_t kThreadNameHeaderSize = 7;
+      uint8_t header[kThreadNameHeaderSize];
+      Append2LE(header, 0);
+      header[2] = kOpNewThread;
+      // We use only 16 bits to encode thread id. On Android, we don't expect to use more than
+      // 16-bits for a Tid. For 32-bit platforms it is always ensured we use less than 16 bits.
+      // See  __check_max_thread_id in bionic for more details. Even on 64-bit the max threads
+      // is currently less than 65536.
+      // TODO(mythria): On host, we know thread ids can be greater than 16 bits. Consider adding
+      // a map similar to method ids.
+      DCHECK(!kIsTargetBuild || thread->GetTid() < (1 << 16));
+      Append2LE(header + 3, static_cast<uint16_t>(thread->GetTid()));
+      Append2LE(header + 5, static_cast<uint16_t>(thread_name.length()));
+
+      {
+        MutexLock mu(Thread::Current(), tracing_lock_);
+        if (!trace_file_->WriteFully(header, kThreadNameHeaderSize) ||
+            !trace_file_->WriteFully(reinterpret_cast<const uint8_t*>(thread_name.c_str()),
+                                     thread_name.length())) {
+          PLOG(WARNING) << "Failed streaming a tracing event.";
+        }
       }
     }
   }
 
+  if (trace_output_mode_ == TraceOutputMode::kRingBuffer &&
+      *current_offset + GetNumEntriesPerEvent() > kPerThreadBufSize) {
+    // Wrap around and overwrite the oldest events. The ring buffer is never flushed.
+    *current_offset = 0;
+  }
+
   size_t required_entries = (clock_source_ == TraceClockSource::kDual) ? 4 : 3;
-  if (*current_offset + required_entries >= kPerThreadBufSize) {
+  if (trace_output_mode_ == TraceOutputMode::kStreaming &&
+      *current_offset + required_entries >= kPerThreadBufSize) {
     // We don't have space for further entries. Flush the contents of the buffer and reuse the
     // buffer to store contents. Reset the index to the start of the buffer.
     FlushStreamingBuffer(thread);
@@ -1166,6 +1225,110 @@ void Trace::FlushStreamingBuffer(Thread* thread) {
   }
 }
 
+size_t Trace::GetNumEntriesPerEvent() {
+  size_t num_entries = 2u;  // Method and action.
+  if (UseThreadCpuClock()) {
+    num_entries += 1u;
+  }
+  if (UseWallClock()) {
+    // On 32-bit architectures the timestamp counter is stored as two 32-bit values.
+    num_entries += (art::kRuntimePointerSize == PointerSize::k32) ? 2u : 1u;
+  }
+  return num_entries;
+}
+
+void Trace::WriteRingBuffers(const std::list<Thread*>& threads) {
+  std::vector<uint8_t> data(kTraceHeaderLength, 0u);
+  Append4LE(data.data(), kTraceMagicValue);
+  Append2LE(data.data() + 4, GetTraceVersion(clock_source_) | kTraceVersionRingBufferFlag);
+  Append2LE(data.data() + 6, kTraceHeaderLength);
+  Append8LE(data.data() + 8, start_time_);
+
+  // Method IDs are assigned per dump, so that each dump can be decoded on its own.
+  std::unordered_map<ArtMethod*, uint32_t> method_ids;
+  std::vector<uint8_t> events;
+  const size_t entries_per_event = GetNumEntriesPerEvent();
+  // The writer wraps around when the next event does not fit.
+  const size_t capacity = (kPerThreadBufSize / entries_per_event) * entries_per_event;
+  for (Thread* thread : threads) {
+    const uintptr_t* buffer = thread->GetMethodTraceBuffer();
+    if (buffer == nullptr) {
+      continue;
+    }
+    // The buffer is zero-initialized, so a recorded method at the write position means that the
+    // ring has wrapped around and that the oldest event starts there.
+    const size_t write_index = *thread->GetMethodTraceIndexPtr();
+    const bool wrapped = write_index < capacity && buffer[write_index] != 0u;
+    const size_t start_index = wrapped ? write_index : 0u;
+    const size_t num_events = (wrapped ? capacity : write_index) / entries_per_event;
+
+    std::string thread_name;
+    thread->GetThreadName(thread_name);
+    data.push_back(kOpNewThread);
+    EncodeUnsignedLeb128(&data, static_cast<uint32_t>(thread->GetTid()));
+    EncodeUnsignedLeb128(&data, thread_name.length());
+    data.insert(data.end(), thread_name.begin(), thread_name.end());
+
+    events.clear();
+    uint32_t last_thread_time = 0u;
+    uint32_t last_wall_time = 0u;
+    for (size_t i = 0; i != num_events; ++i) {
+      size_t entry_index = (start_index + i * entries_per_event) % capacity;
+      ArtMethod* method = reinterpret_cast<ArtMethod*>(buffer[entry_index++]);
+      TraceAction action = DecodeTraceAction(buffer[entry_index++]);
+      auto [it, inserted] = method_ids.emplace(method, method_ids.size());
+      if (inserted) {
+        std::string method_line;
+        {
+          MutexLock mu(Thread::Current(), tracing_lock_);
+          method_line = GetMethodLine(method, it->second);
+        }
+        data.push_back(kOpNewMethod);
+        EncodeUnsignedLeb128(&data, it->second);
+        EncodeUnsignedLeb128(&data, method_line.length());
+        data.insert(data.end(), method_line.begin(), method_line.end());
+      }
+      EncodeUnsignedLeb128(&events, (it->second << TraceActionBits) | action);
+      if (UseThreadCpuClock()) {
+        uint32_t thread_time = buffer[entry_index++];
+        EncodeSignedLeb128(&events, static_cast<int32_t>(thread_time - last_thread_time));
+        last_thread_time = thread_time;
+      }
+      if (UseWallClock()) {
+        uint64_t timestamp = buffer[entry_index++];
+        if (art::kRuntimePointerSize == PointerSize::k32) {
+          timestamp = (timestamp << 32 | buffer[entry_index++]);
+        }
+        uint32_t wall_time = GetMicroTime(timestamp) - start_time_;
+        EncodeSignedLeb128(&events, static_cast<int32_t>(wall_time - last_wall_time));
+        last_wall_time = wall_time;
+      }
+    }
+    data.push_back(kOpThreadEvents);
+    EncodeUnsignedLeb128(&data, num_events);
+    data.insert(data.end(), events.begin(), events.end());
+  }
+
+  std::ostringstream os;
+  os << StringPrintf("%cversion\n", kTraceTokenChar);
+  os << StringPrintf("%d\n", GetTraceVersion(clock_source_));
+  os << StringPrintf("clock=%s\n", GetClockSourceName(clock_source_));
+  uint64_t elapsed = GetMicroTime(GetTimestamp()) - start_time_;
+  os << StringPrintf("elapsed-time-usec=%" PRIu64 "\n", elapsed);
+  os << StringPrintf("clock-call-overhead-nsec=%d\n", clock_overhead_ns_);
+  os << StringPrintf("vm=art\n");
+  os << StringPrintf("pid=%d\n", getpid());
+  os << StringPrintf("%cend\n", kTraceTokenChar);
+  std::string summary(os.str());
+  data.push_back(kOpTraceSummary);
+  EncodeUnsignedLeb128(&data, summary.length());
+  data.insert(data.end(), summary.begin(), summary.end());
+
+  if (!trace_file_->WriteFully(data.data(), data.size())) {
+    PLOG(WARNING) << "Failed writing method trace ring buffers.";
+  }
+}
+
 void Trace::RecordMethodEvent(Thread* thread,
                               ArtMethod* method,
                               TraceAction action,
@@ -1220,7 +1383,8 @@ void Trace::LogMethodTraceEvent(Thread* thread,
   // same pointer value.
   method = method->GetNonObsoleteMethod();
 
-  if (trace_output_mode_ == TraceOutputMode::kStreaming) {
+  if (trace_output_mode_ == TraceOutputMode::kStreaming ||
+      trace_output_mode_ == TraceOutputMode::kRingBuffer) {
     RecordStreamingMethodEvent(thread, method, action, thread_clock_diff, timestamp_counter);
   } else {
     RecordMethodEvent(thread, method, action, thread_clock_diff, timestamp_counter);
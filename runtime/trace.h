@@ -18,6 +18,7 @@
 #define ART_RUNTIME_TRACE_H_
 
 #include <bitset>
+#include <list>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -89,6 +90,22 @@ std::ostream& operator<<(std::ostream& os, TracingMode rhs);
 // 32 bits of microseconds is 70 minutes.
 //
 // All values are stored in little-endian order.
+//
+// Ring buffer dump format (TraceOutputMode::kRingBuffer):
+//     header, as above with the version or'ed with 0xE0 and no record size
+//     blocks, each starting with a u1 opcode:
+//       kOpNewMethod:    uleb128 method ID, uleb128 length, method line
+//       kOpNewThread:    uleb128 thread ID, uleb128 length, thread name
+//       kOpThreadEvents: uleb128 number of events followed by the events of the
+//                        preceding thread, oldest first
+//       kOpTraceSummary: uleb128 length, trace summary; ends the dump
+//
+// Ring buffer event format:
+//     uleb128  method ID | method action
+//     sleb128  thread cpu time delta from the previous event, in usec (thread-cpu clock only)
+//     sleb128  wall time delta from the previous event, in usec (wall clock only)
+//
+// The first event of a thread is relative to 0. Method IDs are only valid within one dump.
 
 enum TraceAction {
     kTraceMethodEnter = 0x00,       // method entry
@@ -112,7 +129,10 @@ class Trace final : public instrumentation::InstrumentationListener {
   enum class TraceOutputMode {
     kFile,
     kDDMS,
-    kStreaming
+    kStreaming,
+    // Keep the latest events in per-thread ring buffers and only write them out on request
+    // with DumpRingBuffers() or when tracing stops.
+    kRingBuffer
   };
 
   enum class TraceMode {
@@ -163,6 +183,11 @@ class Trace final : public instrumentation::InstrumentationListener {
       REQUIRES(!Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::trace_lock_);
   static TracingMode GetMethodTracingMode() REQUIRES(!Locks::trace_lock_);
 
+  // Write the per-thread ring buffers to the trace file if tracing with
+  // TraceOutputMode::kRingBuffer. Returns false if no such trace is running.
+  static bool DumpRingBuffers()
+      REQUIRES(!Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::trace_lock_);
+
   // Flush the per-thread buffer. This is called when the thread is about to detach.
   static void FlushThreadBuffer(Thread* thread) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::trace_lock_) NO_THREAD_SAFETY_ANALYSIS;
@@ -303,6 +328,12 @@ class Trace final : public instrumentation::InstrumentationListener {
   // flushes across threads.
   void FlushStreamingBuffer(Thread* thread) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!tracing_lock_);
+  // Encodes the events in the per-thread ring buffers of all threads and writes them to the
+  // trace file. All threads must be suspended.
+  void WriteRingBuffers(const std::list<Thread*>& threads)
+      REQUIRES(Locks::mutator_lock_, Locks::thread_list_lock_);
+  // Number of per-thread buffer entries used by one event.
+  size_t GetNumEntriesPerEvent();
   // Ensures there is sufficient space in the buffer to record the requested_size. If there is not
   // enough sufficient space the current contents of the buffer are written to the file and
   // current_index is reset to 0. This doesn't check if buffer_size is big enough to hold the
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+    public static void main(String[] args) {
+        // Compressed strings are searched 16 chars at a time, uncompressed ones 8 chars at a
+        // time. The haystacks below are shorter than one block, or end with a partial block.
+        testEncoding('a', 'b', 'x');
+        testEncoding('\u0100', '\u0101', '\u0178');
+
+        // Matches of the first char with the wrong last char, in the tail.
+        assertEquals(-1, $noinline$indexOf("abc", "ax"));
+        assertEquals(-1, $noinline$indexOf("abc", "abx"));
+        assertEquals(-1, $noinline$indexOf("abcd", "abcx"));
+        assertEquals(-1, $noinline$indexOf("\u0100bc", "\u0100x"));
+        assertEquals(-1, $noinline$indexOf("\u0100bc\u0100d", "\u0100bx"));
+        assertEquals(-1, $noinline$indexOf("0123456789abcdefgh", "gx"));
+        assertEquals(-1, $noinline$indexOf("0123456\u0100ab", "ax"));
+        assertEquals(-1, $noinline$indexOfAfter("abcabd", "abx", 1));
+
+        // Matches in the tail.
+        assertEquals(1, $noinline$indexOf("abc", "bc"));
+        assertEquals(2, $noinline$indexOf("abc", "c"));
+        assertEquals(0, $noinline$indexOf("abc", "abc"));
+        assertEquals(17, $noinline$indexOf("0123456789abcdefgh", "h"));
+        assertEquals(16, $noinline$indexOf("0123456789abcdefgh", "gh"));
+        assertEquals(9, $noinline$indexOf("0123456\u0100abc", "bc"));
+        assertEquals(3, $noinline$indexOfAfter("abcabd", "abd", 1));
+        assertEquals(3, $noinline$indexOfAfter("abcabc", "abc", 1));
+
+        // Targets longer than the string, and strings with different encodings.
+        assertEquals(-1, $noinline$indexOf("ab", "abc"));
+        assertEquals(-1, $noinline$indexOf("abc", "\u0100"));
+        assertEquals(-1, $noinline$indexOf("\u0100", "a"));
+        assertEquals(1, $noinline$indexOf("a\u0100b", "\u0100b"));
+
+        // Empty targets and start indexes outside the string.
+        assertEquals(0, $noinline$indexOf("abc", ""));
+        assertEquals(0, $noinline$indexOf("", ""));
+        assertEquals(-1, $noinline$indexOf("", "a"));
+        assertEquals(0, $noinline$indexOfAfter("abc", "a", -5));
+        assertEquals(-1, $noinline$indexOfAfter("abc", "a", 3));
+        assertEquals(-1, $noinline$indexOfAfter("abc", "a", 100));
+        assertEquals(3, $noinline$indexOfAfter("abc", "", 100));
+
+        try {
+            $noinline$indexOf("abc", null);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+    }
+
+    /// CHECK-START: int Main.$noinline$indexOf(java.lang.String, java.lang.String) builder (after)
+    /// CHECK:          InvokeVirtual intrinsic:StringStringIndexOf
+
+    /// CHECK-START-X86_64: int Main.$noinline$indexOf(java.lang.String, java.lang.String) disassembly (after)
+    /// CHECK:          InvokeVirtual intrinsic:StringStringIndexOf
+    /// CHECK:          pmovmskb
+
+    /// CHECK-START-ARM64: int Main.$noinline$indexOf(java.lang.String, java.lang.String) disassembly (after)
+    /// CHECK:          InvokeVirtual intrinsic:StringStringIndexOf
+    /// CHECK:          shrn
+    private static int $noinline$indexOf(String string, String target) {
+        return string.indexOf(target);
+    }
+
+    /// CHECK-START: int Main.$noinline$indexOfAfter(java.lang.String, java.lang.String, int) builder (after)
+    /// CHECK:          InvokeVirtual intrinsic:StringStringIndexOfAfter
+
+    /// CHECK-START-X86_64: int Main.$noinline$indexOfAfter(java.lang.String, java.lang.String, int) disassembly (after)
+    /// CHECK:          InvokeVirtual intrinsic:StringStringIndexOfAfter
+    /// CHECK:          pmovmskb
+
+    /// CHECK-START-ARM64: int Main.$noinline$indexOfAfter(java.lang.String, java.lang.String, int) disassembly (after)
+    /// CHECK:          InvokeVirtual intrinsic:StringStringIndexOfAfter
+    /// CHECK:          shrn
+    private static int $noinline$indexOfAfter(String string, String target, int fromIndex) {
+        return string.indexOf(target, fromIndex);
+    }
+
+    // Compares the intrinsics with a naive search from every start index, for strings of `a`
+    // and `b` up to a length of 20 and targets up to a length of 4. The `other` char never
+    // matches.
+    private static void testEncoding(char a, char b, char other) {
+        String[] strings = buildStrings(a, b, 20);
+        String[] targets = buildStrings(a, b, 4);
+        for (String string : strings) {
+            for (String target : targets) {
+                check(string, target);
+                check(string, target + other);
+                check(string, other + target);
+                if (target.length() >= 2) {
+                    // Only the middle char differs.
+                    char[] chars = target.toCharArray();
+                    chars[1] = other;
+                    check(string, new String(chars));
+                }
+            }
+        }
+    }
+
+    // Returns the strings of `a` and `b` up to the given length. Long strings are only
+    // built from a few patterns to keep the test short.
+    private static String[] buildStrings(char a, char b, int maxLength) {
+        java.util.ArrayList<String> result = new java.util.ArrayList<>();
+        for (int length = 0; length <= maxLength; ++length) {
+            int count = (length <= 4) ? (1 << length) : 8;
+            for (int i = 0; i != count; ++i) {
+                StringBuilder sb = new StringBuilder();
+                for (int j = 0; j != length; ++j) {
+                    int bit = (length <= 4) ? ((i >> j) & 1) : (((j * (i + 1)) >> 1) & 1);
+                    sb.append(bit == 0 ? a : b);
+                }
+                result.add(sb.toString());
+            }
+        }
+        return result.toArray(new String[0]);
+    }
+
+    private static void check(String string, String target) {
+        for (int start = 0; start <= string.length(); ++start) {
+            int expected = naiveIndexOf(string, target, start);
+            if (start == 0) {
+                assertEquals(expected, $noinline$indexOf(string, target), string, target, start);
+            }
+            assertEquals(expected, $noinline$indexOfAfter(string, target, start),
+                         string, target, start);
+        }
+    }
+
+    private static int naiveIndexOf(String string, String target, int start) {
+        for (int i = start; i <= string.length() - target.length(); ++i) {
+            if (string.regionMatches(i, target, 0, target.length())) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    private static void assertEquals(int expected, int actual, String string, String target,
+                                     int start) {
+        if (expected != actual) {
+            throw new Error("\"" + string + "\".indexOf(\"" + target + "\", " + start + "): " +
+                            "expected " + expected + ", found " + actual);
+        }
+    }
+
+    public static void assertEquals(int expected, int actual) {
+        if (expected != actual) {
+            throw new Error("Expected: " + expected + ", found: " + actual);
+        }
+    }
+}
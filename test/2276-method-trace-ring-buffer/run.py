@@ -0,0 +1,25 @@
+#!/bin/bash
+#
+# Copyright (C) 2024 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+def run(ctx, args):
+  # Trace to the ring buffers with a single clock, so that events have a fixed size.
+  ctx.default_run(
+      args,
+      runtime_option=[
+          "-Xmethod-trace", "-Xmethod-trace-file:${DEX_LOCATION}/trace.bin",
+          "-Xmethod-trace-ring-buffer", "-Xmethod-trace-clock:wallclock"
+      ])
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.io.DataInputStream;
+import java.io.EOFException;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.lang.reflect.Method;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.HashMap;
+
+public class Main {
+    private static final int MAGIC_NUMBER = 0x574f4c53;
+    private static final int HEADER_LENGTH = 32;
+    private static final int RING_BUFFER_VERSION_FLAG = 0xE0;
+    private static final int OP_NEW_METHOD = 1;
+    private static final int OP_NEW_THREAD = 2;
+    private static final int OP_TRACE_SUMMARY = 3;
+    private static final int OP_THREAD_EVENTS = 4;
+    private static final int TRACE_ACTION_BITS = 2;
+    private static final int ACTION_ENTER = 0;
+    private static final int ACTION_EXIT = 1;
+
+    // Enough calls to fill the ring buffer of the main thread more than once.
+    private static final int WARMUP_CALLS = 100000;
+    private static final int LAST_CALLS = 10;
+
+    public static void main(String[] args) throws Exception {
+        String name = System.getProperty("java.vm.name");
+        if (!"Dalvik".equals(name)) {
+            System.out.println("This test is not supported on " + name);
+            return;
+        }
+
+        for (int i = 0; i < WARMUP_CALLS; ++i) {
+            $noinline$warmup();
+        }
+        for (int i = 0; i < LAST_CALLS; ++i) {
+            $noinline$last();
+        }
+        // Stopping the trace dumps the ring buffers.
+        Class<?> vmDebug = Class.forName("dalvik.system.VMDebug");
+        vmDebug.getDeclaredMethod("stopMethodTracing").invoke(null);
+
+        File file = new File(System.getenv("DEX_LOCATION"), "trace.bin");
+        checkDump(parseDump(file).get("main"));
+    }
+
+    public static void $noinline$warmup() {}
+
+    public static void $noinline$last() {}
+
+    static class Event {
+        Event(String method, int action, long wallTime) {
+            this.method = method;
+            this.action = action;
+            this.wallTime = wallTime;
+        }
+
+        final String method;
+        final int action;
+        final long wallTime;
+    }
+
+    // Checks the events of the main thread. The ring buffer only keeps the latest events, so
+    // the dump starts within the warmup calls and not with the entry of `main()`.
+    private static void checkDump(ArrayList<Event> events) {
+        ArrayList<Event> calls = new ArrayList<>();
+        long lastWallTime = 0;
+        boolean ordered = true;
+        boolean hasMainEntry = false;
+        for (Event event : events) {
+            if (event.wallTime < lastWallTime) {
+                ordered = false;
+            }
+            lastWallTime = event.wallTime;
+            if (event.method.equals("Main.main")) {
+                hasMainEntry = true;
+            } else if (event.method.startsWith("Main.$noinline$")) {
+                calls.add(event);
+            }
+        }
+        System.out.println("main thread wrapped: " + !hasMainEntry);
+        System.out.println("oldest main event: " + calls.get(0).method);
+
+        // The warmup calls come first and are all complete, apart from the oldest one which may
+        // only have its exit. Then come the last calls.
+        int index = (calls.get(0).action == ACTION_EXIT) ? 1 : 0;
+        int warmupCalls = 0;
+        while (index < calls.size() && calls.get(index).method.equals("Main.$noinline$warmup")) {
+            ordered &= checkCall(calls, index, "Main.$noinline$warmup");
+            index += 2;
+            ++warmupCalls;
+        }
+        int lastCalls = 0;
+        while (index < calls.size()) {
+            ordered &= checkCall(calls, index, "Main.$noinline$last");
+            index += 2;
+            ++lastCalls;
+        }
+        if (warmupCalls == 0 || warmupCalls >= WARMUP_CALLS) {
+            System.out.println("Unexpected number of warmup calls: " + warmupCalls);
+        }
+        System.out.println("calls to $noinline$last: " + lastCalls);
+        System.out.println("events in order: " + ordered);
+    }
+
+    private static boolean checkCall(ArrayList<Event> calls, int index, String method) {
+        return index + 1 < calls.size() &&
+               calls.get(index).method.equals(method) &&
+               calls.get(index).action == ACTION_ENTER &&
+               calls.get(index + 1).method.equals(method) &&
+               calls.get(index + 1).action == ACTION_EXIT;
+    }
+
+    // Parses a ring buffer dump with a single clock and returns the events of each thread.
+    private static HashMap<String, ArrayList<Event>> parseDump(File file) throws IOException {
+        HashMap<String, ArrayList<Event>> threadEvents = new HashMap<>();
+        HashMap<Integer, String> methods = new HashMap<>();
+        try (DataInputStream in = new DataInputStream(new FileInputStream(file))) {
+            if (Integer.reverseBytes(in.readInt()) != MAGIC_NUMBER) {
+                throw new Error("Bad magic number");
+            }
+            int version = Short.reverseBytes(in.readShort()) & 0xFFFF;
+            if ((version & 0xF0) != RING_BUFFER_VERSION_FLAG) {
+                throw new Error("Not a ring buffer dump: version " + version);
+            }
+            in.skipBytes(HEADER_LENGTH - 6);
+
+            String thread = null;
+            while (true) {
+                int op = in.readUnsignedByte();
+                if (op == OP_NEW_METHOD) {
+                    int id = readUleb128(in);
+                    // The method line is: id, class, name, signature and source file.
+                    String[] line = readString(in, readUleb128(in)).split("\t");
+                    methods.put(id, line[1] + "." + line[2]);
+                } else if (op == OP_NEW_THREAD) {
+                    readUleb128(in);  // Thread id.
+                    thread = readString(in, readUleb128(in));
+                } else if (op == OP_THREAD_EVENTS) {
+                    ArrayList<Event> events = new ArrayList<>();
+                    long wallTime = 0;
+                    for (int count = readUleb128(in); count != 0; --count) {
+                        int methodAndAction = readUleb128(in);
+                        wallTime += readSleb128(in);
+                        String method = methods.get(methodAndAction >>> TRACE_ACTION_BITS);
+                        int action = methodAndAction & ((1 << TRACE_ACTION_BITS) - 1);
+                        events.add(new Event(method, action, wallTime));
+                    }
+                    threadEvents.put(thread, events);
+                } else if (op == OP_TRACE_SUMMARY) {
+                    readString(in, readUleb128(in));
+                    break;
+                } else {
+                    throw new Error("Unexpected op " + op);
+                }
+            }
+            // A single dump is expected, written when tracing stopped.
+            try {
+                in.readUnsignedByte();
+                throw new Error("Unexpected data after the dump");
+            } catch (EOFException expected) {
+            }
+        }
+        return threadEvents;
+    }
+
+    private static String readString(DataInputStream in, int length) throws IOException {
+        byte[] bytes = new byte[length];
+        in.readFully(bytes);
+        return new String(bytes, StandardCharsets.UTF_8);
+    }
+
+    private static int readUleb128(DataInputStream in) throws IOException {
+        int result = 0;
+        int shift = 0;
+        int b;
+        do {
+            b = in.readUnsignedByte();
+            result |= (b & 0x7f) << shift;
+            shift += 7;
+        } while ((b & 0x80) != 0);
+        return result;
+    }
+
+    private static int readSleb128(DataInputStream in) throws IOException {
+        int result = 0;
+        int shift = 0;
+        int b;
+        do {
+            b = in.readUnsignedByte();
+            result |= (b & 0x7f) << shift;
+            shift += 7;
+        } while ((b & 0x80) != 0);
+        if (shift < 32 && (b & 0x40) != 0) {
+            result |= -1 << shift;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.invoke.WrongMethodTypeException;
+
+public class Main {
+    // The first call with a MethodHandle may go to the runtime to make the resolved call site
+    // type the MethodHandle type. The next calls then take the direct call from JIT code.
+    private static final int ITERATIONS = 3;
+
+    private static final String[] CALL_SITES = {
+        "$noinline$invokeExactStatic",
+        "$noinline$invokeExactVirtual",
+        "$noinline$invokeExactPrivate",
+        "$noinline$invokeExactInterface",
+        "$noinline$invokeExactDefault",
+        "$noinline$invokeStatic",
+        "$noinline$invokeAsLong",
+        "$noinline$invokeBoxed",
+        "$noinline$invokeAsString",
+        "$noinline$invokeExactAsLong",
+        "$noinline$invokeExactMaxArgs",
+        "$noinline$invokeExactVirtualMaxArgs",
+        "$noinline$invokeExactTooManyCoreArgs",
+        "$noinline$invokeExactTooManyFpArgs",
+    };
+
+    public static void main(String[] args) throws Throwable {
+        System.loadLibrary(args[0]);
+
+        // Compile the call sites before their first call, so that all calls below are made
+        // from JIT code. Without a JIT, this tests the interpreter.
+        for (String callSite : CALL_SITES) {
+            ensureJitCompiled(Main.class, callSite);
+        }
+
+        testInvokeStatic();
+        testInvokeDirect();
+        testInvokeVirtual();
+        testInterfaceTargets();
+        testNullReceiver();
+        testInvokeWithAsType();
+        testRegisterLimit();
+        testWrongMethodType();
+    }
+
+    private static void testInvokeStatic() throws Throwable {
+        MethodHandle mh = MethodHandles.lookup().findStatic(
+                Main.class, "subtract", MethodType.methodType(int.class, int.class, int.class));
+        for (int i = 0; i < ITERATIONS; ++i) {
+            assertEquals(i - 7, $noinline$invokeExactStatic(mh, i, 7));
+        }
+    }
+
+    private static void testInvokeDirect() throws Throwable {
+        MethodType type = MethodType.methodType(int.class, int.class);
+        Main receiver = new Main(40);
+        MethodHandle[] handles = {
+            MethodHandles.lookup().findVirtual(Main.class, "privateMethod", type),
+            MethodHandles.lookup().findSpecial(Main.class, "privateMethod", type, Main.class),
+        };
+        for (MethodHandle mh : handles) {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                assertEquals(40 * 3 + i, $noinline$invokeExactPrivate(mh, receiver, i));
+            }
+        }
+    }
+
+    private static void testInvokeVirtual() throws Throwable {
+        MethodHandle mh = MethodHandles.lookup().findVirtual(
+                Base.class, "virtualMethod", MethodType.methodType(int.class, int.class));
+        Base base = new Base(10);
+        Base derived = new Derived(20);
+        Base inheriting = new Inheriting(30);
+        for (int i = 0; i < ITERATIONS; ++i) {
+            // The receiver class is the declaring class.
+            assertEquals(10 + i, $noinline$invokeExactVirtual(mh, base, i));
+            // The target is loaded from the vtable of the receiver class.
+            assertEquals(20 * 2 + i, $noinline$invokeExactVirtual(mh, derived, i));
+            assertEquals(30 + i, $noinline$invokeExactVirtual(mh, inheriting, i));
+        }
+
+        // The same call site with a MethodHandle to the overriding method.
+        MethodHandle derivedMh = MethodHandles.lookup().findVirtual(
+                Derived.class, "virtualMethod", MethodType.methodType(int.class, int.class))
+                .asType(MethodType.methodType(int.class, Base.class, int.class));
+        for (int i = 0; i < ITERATIONS; ++i) {
+            assertEquals(20 * 2 + i, $noinline$invokeExactVirtual(derivedMh, derived, i));
+        }
+    }
+
+    // Interface methods and methods declared in interfaces are left to the runtime.
+    private static void testInterfaceTargets() throws Throwable {
+        MethodType type = MethodType.methodType(int.class, int.class);
+        MethodHandles.Lookup lookup = MethodHandles.lookup();
+        MethodHandle interfaceMh = lookup.findVirtual(Itf.class, "itfMethod", type);
+        MethodHandle defaultMh = lookup.findVirtual(Impl.class, "defaultMethod", type);
+        Impl impl = new Impl(5);
+        Impl overriding = new OverridingImpl(6);
+        for (int i = 0; i < ITERATIONS; ++i) {
+            assertEquals(5 + i, $noinline$invokeExactInterface(interfaceMh, impl, i));
+            assertEquals(6 * 2 + i, $noinline$invokeExactInterface(interfaceMh, overriding, i));
+            assertEquals(-i, $noinline$invokeExactDefault(defaultMh, impl, i));
+            assertEquals(6 * 4 + i, $noinline$invokeExactDefault(defaultMh, overriding, i));
+        }
+    }
+
+    private static void testNullReceiver() throws Throwable {
+        MethodType type = MethodType.methodType(int.class, int.class);
+        MethodHandles.Lookup lookup = MethodHandles.lookup();
+        MethodHandle virtualMh = lookup.findVirtual(Base.class, "virtualMethod", type);
+        MethodHandle privateMh = lookup.findSpecial(Main.class, "privateMethod", type, Main.class);
+        MethodHandle interfaceMh = lookup.findVirtual(Itf.class, "itfMethod", type);
+        for (int i = 0; i < ITERATIONS; ++i) {
+            // Make sure that the call site type is the MethodHandle type before the null call.
+            assertEquals(10 + i, $noinline$invokeExactVirtual(virtualMh, new Base(10), i));
+            try {
+                $noinline$invokeExactVirtual(virtualMh, null, i);
+                throw new Error("Expected NullPointerException");
+            } catch (NullPointerException expected) {
+            }
+            try {
+                $noinline$invokeExactPrivate(privateMh, null, i);
+                throw new Error("Expected NullPointerException");
+            } catch (NullPointerException expected) {
+            }
+            try {
+                $noinline$invokeExactInterface(interfaceMh, null, i);
+                throw new Error("Expected NullPointerException");
+            } catch (NullPointerException expected) {
+            }
+        }
+    }
+
+    private static void testInvokeWithAsType() throws Throwable {
+        MethodHandle mh = MethodHandles.lookup().findStatic(
+                Main.class, "subtract", MethodType.methodType(int.class, int.class, int.class));
+        for (int i = 0; i < ITERATIONS; ++i) {
+            // The call site type is the MethodHandle type.
+            assertEquals(i - 3, $noinline$invokeStatic(mh, i, 3));
+            // The call site types need asType() conversions.
+            assertEquals((long) (i - 3), $noinline$invokeAsLong(mh, i, 3));
+            assertEquals(Integer.valueOf(i - 3), $noinline$invokeBoxed(mh, Integer.valueOf(i), 3));
+        }
+    }
+
+    // Core arguments, including the MethodHandle, and floating-point arguments up to the
+    // number of argument registers are passed to the target directly.
+    private static void testRegisterLimit() throws Throwable {
+        MethodHandle staticMh = MethodHandles.lookup().findStatic(
+                Main.class,
+                "maxArgs",
+                MethodType.methodType(String.class,
+                                      long.class, float.class, double.class, int.class,
+                                      long.class, float.class, double.class, String.class,
+                                      double.class, float.class, double.class, float.class));
+        MethodHandle virtualMh = MethodHandles.lookup().findVirtual(
+                Base.class,
+                "virtualMaxArgs",
+                MethodType.methodType(String.class,
+                                      long.class, double.class, int.class, float.class,
+                                      long.class));
+        MethodHandle tooManyCoreMh = MethodHandles.lookup().findStatic(
+                Main.class,
+                "tooManyCoreArgs",
+                MethodType.methodType(long.class,
+                                      long.class, int.class, long.class, int.class, int.class));
+        MethodHandle tooManyFpMh = MethodHandles.lookup().findStatic(
+                Main.class,
+                "tooManyFpArgs",
+                MethodType.methodType(double.class,
+                                      double.class, float.class, double.class, float.class,
+                                      double.class, float.class, double.class, float.class,
+                                      double.class));
+        Base base = new Base(1);
+        Base derived = new Derived(2);
+        for (int i = 0; i < ITERATIONS; ++i) {
+            long l = 0x1234567890L + i;
+            assertEquals(
+                    maxArgs(l, 1.5f, 2.25, i, -l, 3.5f, 4.75, "s" + i, 5.125, 6.5f, 7.0625, 8.5f),
+                    $noinline$invokeExactMaxArgs(
+                            staticMh,
+                            l, 1.5f, 2.25, i, -l, 3.5f, 4.75, "s" + i, 5.125, 6.5f, 7.0625, 8.5f));
+            assertEquals(base.virtualMaxArgs(l, 1.5, i, 2.5f, -l),
+                         $noinline$invokeExactVirtualMaxArgs(virtualMh, base, l, 1.5, i, 2.5f, -l));
+            assertEquals(derived.virtualMaxArgs(l, 1.5, i, 2.5f, -l),
+                         $noinline$invokeExactVirtualMaxArgs(
+                                 virtualMh, derived, l, 1.5, i, 2.5f, -l));
+            assertEquals(tooManyCoreArgs(l, 1, -l, 2, i),
+                         $noinline$invokeExactTooManyCoreArgs(tooManyCoreMh, l, 1, -l, 2, i));
+            assertEquals(tooManyFpArgs(0.5, 1.5f, 2.5, 3.5f, 4.5, 5.5f, 6.5, 7.5f, i),
+                         $noinline$invokeExactTooManyFpArgs(
+                                 tooManyFpMh, 0.5, 1.5f, 2.5, 3.5f, 4.5, 5.5f, 6.5, 7.5f, i));
+        }
+    }
+
+    private static void testWrongMethodType() throws Throwable {
+        MethodHandle mh = MethodHandles.lookup().findStatic(
+                Main.class, "subtract", MethodType.methodType(int.class, int.class, int.class));
+        for (int i = 0; i < ITERATIONS; ++i) {
+            // Make sure that the int call site type is the MethodHandle type.
+            assertEquals(i - 1, $noinline$invokeExactStatic(mh, i, 1));
+            try {
+                $noinline$invokeExactAsLong(mh, i, 1);
+                throw new Error("Expected WrongMethodTypeException");
+            } catch (WrongMethodTypeException expected) {
+            }
+            try {
+                $noinline$invokeAsString(mh, i, 1);
+                throw new Error("Expected WrongMethodTypeException");
+            } catch (WrongMethodTypeException expected) {
+            }
+        }
+    }
+
+    private static int $noinline$invokeExactStatic(MethodHandle mh, int a, int b)
+            throws Throwable {
+        return (int) mh.invokeExact(a, b);
+    }
+
+    private static int $noinline$invokeExactVirtual(MethodHandle mh, Base receiver, int a)
+            throws Throwable {
+        return (int) mh.invokeExact(receiver, a);
+    }
+
+    private static int $noinline$invokeExactPrivate(MethodHandle mh, Main receiver, int a)
+            throws Throwable {
+        return (int) mh.invokeExact(receiver, a);
+    }
+
+    private static int $noinline$invokeExactInterface(MethodHandle mh, Itf receiver, int a)
+            throws Throwable {
+        return (int) mh.invokeExact(receiver, a);
+    }
+
+    private static int $noinline$invokeExactDefault(MethodHandle mh, Impl receiver, int a)
+            throws Throwable {
+        return (int) mh.invokeExact(receiver, a);
+    }
+
+    private static int $noinline$invokeStatic(MethodHandle mh, int a, int b) throws Throwable {
+        return (int) mh.invoke(a, b);
+    }
+
+    private static long $noinline$invokeAsLong(MethodHandle mh, int a, int b) throws Throwable {
+        return (long) mh.invoke(a, b);
+    }
+
+    private static Object $noinline$invokeBoxed(MethodHandle mh, Integer a, int b)
+            throws Throwable {
+        return (Object) mh.invoke(a, b);
+    }
+
+    private static String $noinline$invokeAsString(MethodHandle mh, int a, int b)
+            throws Throwable {
+        return (String) mh.invoke(a, b);
+    }
+
+    private static long $noinline$invokeExactAsLong(MethodHandle mh, int a, int b)
+            throws Throwable {
+        return (long) mh.invokeExact(a, b);
+    }
+
+    private static String $noinline$invokeExactMaxArgs(MethodHandle mh,
+                                                       long a, float b, double c, int d,
+                                                       long e, float f, double g, String h,
+                                                       double i, float j, double k, float l)
+            throws Throwable {
+        return (String) mh.invokeExact(a, b, c, d, e, f, g, h, i, j, k, l);
+    }
+
+    private static String $noinline$invokeExactVirtualMaxArgs(MethodHandle mh,
+                                                              Base receiver,
+                                                              long a, double b, int c, float d,
+                                                              long e)
+            throws Throwable {
+        return (String) mh.invokeExact(receiver, a, b, c, d, e);
+    }
+
+    private static long $noinline$invokeExactTooManyCoreArgs(MethodHandle mh,
+                                                             long a, int b, long c, int d, int e)
+            throws Throwable {
+        return (long) mh.invokeExact(a, b, c, d, e);
+    }
+
+    private static double $noinline$invokeExactTooManyFpArgs(MethodHandle mh,
+                                                             double a, float b, double c,
+                                                             float d, double e, float f,
+                                                             double g, float h, double i)
+            throws Throwable {
+        return (double) mh.invokeExact(a, b, c, d, e, f, g, h, i);
+    }
+
+    public static int subtract(int a, int b) {
+        return a - b;
+    }
+
+    public static String maxArgs(long a, float b, double c, int d, long e, float f, double g,
+                                 String h, double i, float j, double k, float l) {
+        return a + "," + b + "," + c + "," + d + "," + e + "," + f + "," + g + "," + h + "," +
+               i + "," + j + "," + k + "," + l;
+    }
+
+    public static long tooManyCoreArgs(long a, int b, long c, int d, int e) {
+        return a * 1000 + b * 100 + c * 10 + d + (long) e * 7;
+    }
+
+    public static double tooManyFpArgs(double a, float b, double c, float d, double e, float f,
+                                       double g, float h, double i) {
+        return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f + 7 * g + 8 * h + 9 * i;
+    }
+
+    Main(int value) {
+        this.value = value;
+    }
+
+    private int privateMethod(int a) {
+        return value * 3 + a;
+    }
+
+    private final int value;
+
+    static class Base {
+        Base(int value) {
+            this.value = value;
+        }
+
+        public int virtualMethod(int a) {
+            return value + a;
+        }
+
+        public String virtualMaxArgs(long a, double b, int c, float d, long e) {
+            return "Base " + value + "," + a + "," + b + "," + c + "," + d + "," + e;
+        }
+
+        final int value;
+    }
+
+    static class Derived extends Base {
+        Derived(int value) {
+            super(value);
+        }
+
+        @Override
+        public int virtualMethod(int a) {
+            return value * 2 + a;
+        }
+
+        @Override
+        public String virtualMaxArgs(long a, double b, int c, float d, long e) {
+            return "Derived " + value + "," + a + "," + b + "," + c + "," + d + "," + e;
+        }
+    }
+
+    static class Inheriting extends Base {
+        Inheriting(int value) {
+            super(value);
+        }
+    }
+
+    interface Itf {
+        int itfMethod(int a);
+
+        default int defaultMethod(int a) {
+            return -a;
+        }
+    }
+
+    static class Impl implements Itf {
+        Impl(int value) {
+            this.value = value;
+        }
+
+        public int itfMethod(int a) {
+            return value + a;
+        }
+
+        final int value;
+    }
+
+    static class OverridingImpl extends Impl {
+        OverridingImpl(int value) {
+            super(value);
+        }
+
+        @Override
+        public int itfMethod(int a) {
+            return value * 2 + a;
+        }
+
+        @Override
+        public int defaultMethod(int a) {
+            return value * 4 + a;
+        }
+    }
+
+    private static void assertEquals(int expected, int actual) {
+        if (expected != actual) {
+            throw new Error("Expected: " + expected + ", found: " + actual);
+        }
+    }
+
+    private static void assertEquals(long expected, long actual) {
+        if (expected != actual) {
+            throw new Error("Expected: " + expected + ", found: " + actual);
+        }
+    }
+
+    private static void assertEquals(double expected, double actual) {
+        if (expected != actual) {
+            throw new Error("Expected: " + expected + ", found: " + actual);
+        }
+    }
+
+    private static void assertEquals(Object expected, Object actual) {
+        if (!expected.equals(actual)) {
+            throw new Error("Expected: " + expected + ", found: " + actual);
+        }
+    }
+
+    private static native void ensureJitCompiled(Class<?> klass, String methodName);
+}
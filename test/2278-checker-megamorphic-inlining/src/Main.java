@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START-{ARM64,X86_64}: int Main.$noinline$megamorphicCall(Base) inliner (before)
+  /// CHECK:       InvokeVirtual method_name:Base.getValue
+
+  // Receiver counts are only maintained by the x86-64 and arm64 baseline code. The first
+  // entry of the inline cache is `SubA`, which the loop below calls most often, then `SubB`.
+
+  /// CHECK-START-{ARM64,X86_64}: int Main.$noinline$megamorphicCall(Base) inliner (after)
+  /// CHECK-DAG:  <<SubARet:i\d+>>          IntConstant 42
+  /// CHECK-DAG:  <<SubBRet:i\d+>>          IntConstant 38
+  /// CHECK-DAG:  <<Obj:l\d+>>              NullCheck
+  /// CHECK-DAG:  <<ObjClassSubA:l\d+>>     InstanceFieldGet [<<Obj>>] field_name:java.lang.Object.shadow$_klass_
+  /// CHECK-DAG:  <<InlineClassSubA:l\d+>>  LoadClass class_name:SubA
+  /// CHECK-DAG:  <<TestSubA:z\d+>>         NotEqual [<<InlineClassSubA>>,<<ObjClassSubA>>]
+  /// CHECK-DAG:                            If [<<TestSubA>>]
+
+  /// CHECK-DAG:  <<ObjClassSubB:l\d+>>     InstanceFieldGet field_name:java.lang.Object.shadow$_klass_
+  /// CHECK-DAG:  <<InlineClassSubB:l\d+>>  LoadClass class_name:SubB
+  /// CHECK-DAG:  <<TestSubB:z\d+>>         NotEqual [<<InlineClassSubB>>,<<ObjClassSubB>>]
+  /// CHECK-DAG:                            If [<<TestSubB>>]
+  /// CHECK-DAG:  <<DefaultRet:i\d+>>       InvokeVirtual [<<Obj>>] method_name:Base.getValue
+
+  /// CHECK-DAG:  <<FirstMerge:i\d+>>       Phi [<<SubBRet>>,<<DefaultRet>>]
+  /// CHECK-DAG:  <<Ret:i\d+>>              Phi [<<SubARet>>,<<FirstMerge>>]
+  /// CHECK-DAG:                            Return [<<Ret>>]
+
+  /// CHECK-NOT:                            Deoptimize
+
+  /// CHECK-START-{ARM64,X86_64}: int Main.$noinline$megamorphicCall(Base) inliner (after)
+  /// CHECK-NOT:                            LoadClass class_name:SubC
+  /// CHECK-NOT:                            LoadClass class_name:SubD
+  /// CHECK-NOT:                            LoadClass class_name:SubE
+  /// CHECK-NOT:                            LoadClass class_name:SubF
+  public static int $noinline$megamorphicCall(Base obj) {
+    return obj.getValue();
+  }
+
+  public static void test() {
+    ensureJitBaselineCompiled(Main.class, "$noinline$megamorphicCall");
+    // Warm up the inline cache with 12 calls on `SubA`, 9 on `SubB` and one on each of the
+    // other classes out of every 25. The odd period keeps the sampled counts of the first
+    // entry from aliasing with the pattern. `SubA` and `SubB` take the first two entries,
+    // and `SubE` and `SubF` share the last one.
+    Base[] pattern = new Base[25];
+    for (int i = 0; i < 12; ++i) {
+      pattern[i] = subA;
+    }
+    for (int i = 12; i < 21; ++i) {
+      pattern[i] = subB;
+    }
+    pattern[21] = subC;
+    pattern[22] = subD;
+    pattern[23] = subE;
+    pattern[24] = subF;
+    int sum = 0;
+    for (int i = 0; i < 4000; ++i) {
+      for (Base obj : pattern) {
+        sum += $noinline$megamorphicCall(obj);
+      }
+    }
+    assertEquals(4000 * (12 * 42 + 9 * 38 + 1 + 2 + 3 + 4), sum);
+
+    ensureJitCompiled(Main.class, "$noinline$megamorphicCall");
+    assertEquals(42, $noinline$megamorphicCall(subA));
+    assertEquals(38, $noinline$megamorphicCall(subB));
+    assertEquals(1, $noinline$megamorphicCall(subC));
+    assertEquals(2, $noinline$megamorphicCall(subD));
+    assertEquals(3, $noinline$megamorphicCall(subE));
+    assertEquals(4, $noinline$megamorphicCall(subF));
+    assertEquals(5, $noinline$megamorphicCall(new SubG()));
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    test();
+  }
+
+  public static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+
+  static Base subA = new SubA();
+  static Base subB = new SubB();
+  static Base subC = new SubC();
+  static Base subD = new SubD();
+  static Base subE = new SubE();
+  static Base subF = new SubF();
+
+  private static native void ensureJitBaselineCompiled(Class<?> cls, String methodName);
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+}
+
+abstract class Base {
+  public abstract int getValue();
+}
+
+class SubA extends Base {
+  public int getValue() {
+    return 42;
+  }
+}
+
+class SubB extends Base {
+  public int getValue() {
+    return 38;
+  }
+}
+
+class SubC extends Base {
+  public int getValue() {
+    return 1;
+  }
+}
+
+class SubD extends Base {
+  public int getValue() {
+    return 2;
+  }
+}
+
+class SubE extends Base {
+  public int getValue() {
+    return 3;
+  }
+}
+
+class SubF extends Base {
+  public int getValue() {
+    return 4;
+  }
+}
+
+class SubG extends Base {
+  public int getValue() {
+    return 5;
+  }
+}
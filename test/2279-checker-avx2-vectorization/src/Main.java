@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for the 256-bit (YMM) lowering of vectorized loops on AVX2-enabled x86-64. The vector
+ * length, and so the induction step, doubles compared to the 128-bit SSE lowering.
+ */
+public class Main {
+
+  /// CHECK-START-X86_64: void Main.addInt(int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 8                              loop:none
+  ///     CHECK-DAG: <<Ld1:d\d+>>    VecLoad [{{l\d+}},<<I:i\d+>>]              loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>    VecLoad [{{l\d+}},<<I>>]                   loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Add:d\d+>>    VecAdd [<<Ld1>>,<<Ld2>>] packed_type:Int32 loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecStore [{{l\d+}},<<I>>,<<Add>>]          loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                       loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 4                              loop:none
+  ///     CHECK-DAG: <<Ld1:d\d+>>    VecLoad [{{l\d+}},<<I:i\d+>>]              loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>    VecLoad [{{l\d+}},<<I>>]                   loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Add:d\d+>>    VecAdd [<<Ld1>>,<<Ld2>>] packed_type:Int32 loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecStore [{{l\d+}},<<I>>,<<Add>>]          loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                       loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void addInt(int[] a, int[] b) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] += b[i];
+    }
+  }
+
+  /// CHECK-START-X86_64: void Main.scaleFloat(float[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 8                                  loop:none
+  ///     CHECK-DAG: <<Ld:d\d+>>     VecLoad [{{l\d+}},<<I:i\d+>>]                  loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Mul:d\d+>>    VecMul [<<Ld>>,{{d\d+}}] packed_type:Float32   loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecStore [{{l\d+}},<<I>>,<<Mul>>]              loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                           loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 4                                  loop:none
+  ///     CHECK-DAG: <<Ld:d\d+>>     VecLoad [{{l\d+}},<<I:i\d+>>]                  loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Mul:d\d+>>    VecMul [<<Ld>>,{{d\d+}}] packed_type:Float32   loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecStore [{{l\d+}},<<I>>,<<Mul>>]              loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                           loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void scaleFloat(float[] a) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] *= 2.5f;
+    }
+  }
+
+  /// CHECK-START-X86_64: int Main.sumInt(int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 8                              loop:none
+  ///     CHECK-DAG: <<Set:d\d+>>    VecSetScalars [{{i\d+}}]                   loop:none
+  ///     CHECK-DAG: <<Phi:d\d+>>    Phi [<<Set>>,{{d\d+}}]                     loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld:d\d+>>     VecLoad [{{l\d+}},<<I:i\d+>>]              loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecAdd [<<Phi>>,<<Ld>>]                    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                       loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Red:d\d+>>    VecReduce [<<Phi>>]                        loop:none
+  ///     CHECK-DAG:                 VecExtractScalar [<<Red>>]                 loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 4                              loop:none
+  ///     CHECK-DAG: <<Set:d\d+>>    VecSetScalars [{{i\d+}}]                   loop:none
+  ///     CHECK-DAG: <<Phi:d\d+>>    Phi [<<Set>>,{{d\d+}}]                     loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld:d\d+>>     VecLoad [{{l\d+}},<<I:i\d+>>]              loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecAdd [<<Phi>>,<<Ld>>]                    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                       loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Red:d\d+>>    VecReduce [<<Phi>>]                        loop:none
+  ///     CHECK-DAG:                 VecExtractScalar [<<Red>>]                 loop:none
+  //
+  /// CHECK-FI:
+  private static int sumInt(int[] a) {
+    int sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      sum += a[i];
+    }
+    return sum;
+  }
+
+  /// CHECK-START-X86_64: int Main.sadInt(int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 8                              loop:none
+  ///     CHECK-DAG: <<Set:d\d+>>    VecSetScalars [{{i\d+}}]                   loop:none
+  ///     CHECK-DAG: <<Phi:d\d+>>    Phi [<<Set>>,{{d\d+}}]                     loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld1:d\d+>>    VecLoad [{{l\d+}},<<I:i\d+>>]              loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>    VecLoad [{{l\d+}},<<I>>]                   loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecSADAccumulate [<<Phi>>,<<Ld1>>,<<Ld2>>] loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                       loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  //      The SSE lowering has no SAD idiom.
+  ///     CHECK-NOT: VecSADAccumulate
+  //
+  /// CHECK-FI:
+  private static int sadInt(int[] x, int[] y) {
+    int sad = 0;
+    for (int i = 0; i < x.length; i++) {
+      sad += Math.abs(x[i] - y[i]);
+    }
+    return sad;
+  }
+
+  /// CHECK-START-X86_64: int Main.dotProdShort(short[], short[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 16                                         loop:none
+  ///     CHECK-DAG: <<Set:d\d+>>    VecSetScalars [{{i\d+}}]                               loop:none
+  ///     CHECK-DAG: <<Phi:d\d+>>    Phi [<<Set>>,{{d\d+}}]                                 loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld1:d\d+>>    VecLoad [{{l\d+}},<<I:i\d+>>]                          loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>    VecLoad [{{l\d+}},<<I>>]                               loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecDotProd [<<Phi>>,<<Ld1>>,<<Ld2>>] type:Int16        loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                                   loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-DAG: <<Cons:i\d+>>   IntConstant 8                                          loop:none
+  ///     CHECK-DAG: <<Set:d\d+>>    VecSetScalars [{{i\d+}}]                               loop:none
+  ///     CHECK-DAG: <<Phi:d\d+>>    Phi [<<Set>>,{{d\d+}}]                                 loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld1:d\d+>>    VecLoad [{{l\d+}},<<I:i\d+>>]                          loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>    VecLoad [{{l\d+}},<<I>>]                               loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 VecDotProd [<<Phi>>,<<Ld1>>,<<Ld2>>] type:Int16        loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                 Add [<<I>>,<<Cons>>]                                   loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static int dotProdShort(short[] a, short[] b) {
+    int s = 0;
+    for (int i = 0; i < a.length; i++) {
+      s += a[i] * b[i];
+    }
+    return s;
+  }
+
+  public static void main(String[] args) {
+    // Not a multiple of any vector length, so that the scalar cleanup loop runs too.
+    final int n = 1027;
+    int[] a = new int[n];
+    int[] b = new int[n];
+    float[] f = new float[n];
+    short[] s1 = new short[n];
+    short[] s2 = new short[n];
+    int expectedSum = 0;
+    int expectedSad = 0;
+    int expectedDot = 0;
+    for (int i = 0; i < n; i++) {
+      a[i] = i * 7 - 3000;
+      b[i] = 1500 - i * 3;
+      f[i] = i;
+      s1[i] = (short) (i * 37 - 16000);
+      s2[i] = (short) (200 - i);
+      expectedSad += Math.abs(a[i] - b[i]);
+      expectedDot += s1[i] * s2[i];
+    }
+
+    expectEquals(expectedSad, sadInt(a, b));
+    expectEquals(expectedDot, dotProdShort(s1, s2));
+
+    addInt(a, b);
+    for (int i = 0; i < n; i++) {
+      expectEquals(i * 4 - 1500, a[i]);
+      expectedSum += a[i];
+    }
+    expectEquals(expectedSum, sumInt(a));
+
+    scaleFloat(f);
+    for (int i = 0; i < n; i++) {
+      expectEquals(i * 2.5f, f[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(float expected, float result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
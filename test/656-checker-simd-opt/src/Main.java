@@ -203,6 +203,18 @@ public class Main {
     }
   }
 
+  // Both a[i] vs. b[i - 1] and a[i] vs. c[i + 1] need an a != b disambiguation test.
+  //
+  /// CHECK-START-ARM64: void Main.stencilTwoSources(int[], int[], int[], int) loop_optimization (after)
+  /// CHECK-DAG:                NotEqual [{{l\d+}},{{l\d+}}] loop:none
+  /// CHECK-DAG:                NotEqual [{{l\d+}},{{l\d+}}] loop:none
+  /// CHECK-DAG:                VecStore                    loop:<<Loop:B\d+>> outer_loop:none
+  private static void stencilTwoSources(int[] a, int[] b, int[] c, int n) {
+    for (int i = 1; i < n - 1; i++) {
+      a[i] = b[i - 1] + c[i + 1];
+    }
+  }
+
   private static int $inline$constPlus1() {
     return 1;
   }
@@ -390,6 +402,29 @@ public class Main {
     }
   }
 
+  static void testStencilTwoSources() {
+    int[] a = new int[100];
+    int[] b = new int[100];
+    int[] c = new int[100];
+    for (int i = 0; i < 100; i++) {
+      b[i] = i;
+      c[i] = 2 * i;
+    }
+    stencilTwoSources(a, b, c, 100);
+    for (int i = 1; i < 99; i++) {
+      expectEquals((i - 1) + 2 * (i + 1), a[i]);
+    }
+    // Aliased arrays take the sequential loop, which sees its own stores.
+    for (int i = 0; i < 100; i++) {
+      a[i] = i;
+      c[i] = 0;
+    }
+    stencilTwoSources(a, a, c, 100);
+    for (int i = 1; i < 99; i++) {
+      expectEquals(0, a[i]);
+    }
+  }
+
   static void testTypes() {
     int[] a = new int[100];
     int[] b = new int[100];
@@ -410,6 +445,7 @@ public class Main {
     testStencil1();
     testStencil2();
     testStencil3();
+    testStencilTwoSources();
     testTypes();
     System.out.println("passed");
   }
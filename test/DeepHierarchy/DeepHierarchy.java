@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Each level adds four reference fields. From Level8 on, the classes have more reference fields
+// than fit in the reference offsets bitmap, so the GC walks their super classes to visit them.
+
+class Level0 {
+  Object f0, f1, f2, f3;
+}
+
+class Level1 extends Level0 {
+  Object f4, f5, f6, f7;
+}
+
+class Level2 extends Level1 {
+  Object f8, f9, f10, f11;
+}
+
+class Level3 extends Level2 {
+  Object f12, f13, f14, f15;
+}
+
+class Level4 extends Level3 {
+  Object f16, f17, f18, f19;
+}
+
+class Level5 extends Level4 {
+  Object f20, f21, f22, f23;
+}
+
+class Level6 extends Level5 {
+  Object f24, f25, f26, f27;
+}
+
+class Level7 extends Level6 {
+  Object f28, f29, f30, f31;
+}
+
+class Level8 extends Level7 {
+  Object f32, f33, f34, f35;
+}
+
+class Level9 extends Level8 {
+  Object f36, f37, f38, f39;
+}
+
+class Level10 extends Level9 {
+  Object f40, f41, f42, f43;
+}
+
+class Level11 extends Level10 {
+  Object f44, f45, f46, f47;
+}
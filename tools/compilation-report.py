@@ -0,0 +1,105 @@
+#!/usr/bin/python3
+#
+# Copyright (C) 2023 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Summarizes the report written by dex2oat --dump-compilation-report=<file>.
+
+Prints the methods that took the most time or arena memory to compile, with the
+passes that dominate each of them, and the total time spent in each pass.
+
+eg:
+
+% dex2oat ... --dump-compilation-report=/tmp/report.csv
+% compilation-report.py /tmp/report.csv --top 10 --sort-by memory
+"""
+
+import argparse
+import collections
+import csv
+import sys
+
+Method = collections.namedtuple(
+    'Method', ['name', 'time_ns', 'arena_bytes', 'arena_stack_peak_bytes', 'passes'])
+
+
+def ReadReport(report_file):
+  """Returns the list of methods in the report, in the order they were written."""
+  methods = []
+  passes = []
+  for row in csv.DictReader(report_file):
+    if row['pass'] != 'total':
+      passes.append((row['pass'], int(row['time_ns'])))
+      continue
+    # The total row is the last row of a method. Rows of different methods are
+    # never interleaved.
+    methods.append(Method(row['method'],
+                          int(row['time_ns']),
+                          int(row['arena_bytes']),
+                          int(row['arena_stack_peak_bytes']),
+                          passes))
+    passes = []
+  return methods
+
+
+def MemoryOf(method):
+  return method.arena_bytes + method.arena_stack_peak_bytes
+
+
+def PrintTopMethods(methods, top, sort_by, passes_per_method):
+  key = (lambda m: m.time_ns) if sort_by == 'time' else MemoryOf
+  print('Top %d methods by compile %s:' % (top, sort_by))
+  for method in sorted(methods, key=key, reverse=True)[:top]:
+    print('  %10.3f ms %10d KiB  %s' %
+          (method.time_ns / 1e6, MemoryOf(method) // 1024, method.name))
+    slowest_passes = sorted(method.passes, key=lambda p: p[1], reverse=True)
+    for pass_name, time_ns in slowest_passes[:passes_per_method]:
+      share = 100.0 * time_ns / method.time_ns if method.time_ns else 0.0
+      print('      %10.3f ms %5.1f%%  %s' % (time_ns / 1e6, share, pass_name))
+
+
+def PrintPassTotals(methods):
+  totals = collections.Counter()
+  for method in methods:
+    for pass_name, time_ns in method.passes:
+      totals[pass_name] += time_ns
+  total_time_ns = sum(m.time_ns for m in methods)
+  print('Time per pass over %d methods:' % len(methods))
+  for pass_name, time_ns in totals.most_common():
+    share = 100.0 * time_ns / total_time_ns if total_time_ns else 0.0
+    print('  %12.3f ms %5.1f%%  %s' % (time_ns / 1e6, share, pass_name))
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__,
+                                   formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('report', type=argparse.FileType('r'),
+                      help='report written by --dump-compilation-report')
+  parser.add_argument('--top', type=int, default=20,
+                      help='number of methods to print (default: %(default)s)')
+  parser.add_argument('--sort-by', choices=['time', 'memory'], default='time',
+                      help='order of the methods (default: %(default)s)')
+  parser.add_argument('--passes-per-method', type=int, default=3,
+                      help='number of passes to print for each method (default: %(default)s)')
+  args = parser.parse_args()
+
+  methods = ReadReport(args.report)
+  if not methods:
+    sys.exit('No method in %s' % args.report.name)
+  PrintTopMethods(methods, args.top, args.sort_by, args.passes_per_method)
+  print()
+  PrintPassTotals(methods)
+
+
+if __name__ == '__main__':
+  main()